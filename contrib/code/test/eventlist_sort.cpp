@@ -0,0 +1,184 @@
+
+/*
+ *  A micro-benchmark of eventlist::sort(), which re-establishes the order of
+ *  an event list after small edits (see the banner of eventlist::sort()).
+ *  Each edit pattern is timed with the adaptive sort and with the full
+ *  std::sort() and relink() that eventlist::sort() used to do, on lists of
+ *  10k, 50k, and 200k events.  The times are the best of several runs.
+ *
+ *  It is built by "make check" in libseq66/src, and is run by hand:
+ *
+ *      $ make -C libseq66/src check
+ *      $ libseq66/src/eventlist_sort
+ */
+
+#include <algorithm>                    /* std::sort(), std::swap()         */
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdio>                       /* std::printf()                    */
+#include <functional>                   /* std::function<>                  */
+#include <random>                       /* std::mt19937                     */
+
+#include "midi/eventlist.hpp"           /* seq66::eventlist, seq66::event   */
+
+using clocktype = std::chrono::steady_clock;
+
+/**
+ *  The number of runs of each case.  The best time is shown.
+ */
+
+static const int s_runs = 5;
+
+/**
+ *  Makes a sorted list of Note On/Off pairs and controller events, spaced
+ *  12 pulses apart.
+ */
+
+static void
+make_sorted (seq66::eventlist & el, int count)
+{
+    el.clear();
+    el.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        seq66::midipulse ts = seq66::midipulse(i) * 12;
+        seq66::midibyte note = seq66::midibyte(36 + i % 48);
+        if (i % 4 == 3)
+            (void) el.append(seq66::event(ts, 0xB0, 7, seq66::midibyte(i % 128)));
+        else if (i % 2 == 0)
+            (void) el.append(seq66::event(ts, 0x90, note, 100));
+        else
+            (void) el.append(seq66::event(ts, 0x80, note, 0));
+    }
+}
+
+/**
+ *  The edit patterns.  Each one modifies a sorted list.
+ */
+
+static void
+edit_none (seq66::eventlist &, std::mt19937 &)
+{
+    // the list stays sorted, as after most edits that do not move events
+}
+
+static void
+edit_append (seq66::eventlist & el, std::mt19937 & rng)
+{
+    seq66::midipulse maxts = el.get_max_timestamp();
+    std::uniform_int_distribution<seq66::midipulse> pick(0, maxts);
+    for (int i = 0; i < 64; ++i)                    /* recording, paste     */
+        (void) el.append(seq66::event(pick(rng), 0xB0, 1, 64));
+}
+
+static void
+edit_nudge (seq66::eventlist & el, std::mt19937 & rng)
+{
+    std::uniform_int_distribution<int> pick(0, el.count() - 1);
+    for (int i = 0; i < 16; ++i)                    /* nudge a few events   */
+    {
+        seq66::event & e = seq66::eventlist::dref(el.begin() + pick(rng));
+        e.set_timestamp(e.timestamp() + 100);
+    }
+}
+
+static void
+edit_scramble (seq66::eventlist & el, std::mt19937 & rng)
+{
+    std::shuffle(el.begin(), el.end(), rng);        /* the worst case       */
+}
+
+/**
+ *  Times one edit pattern.  The edit is not timed, only the sort.
+ *
+ * \param adaptive
+ *      If true, use eventlist::sort().  Otherwise sort the events with
+ *      std::sort() and relink them, as eventlist::sort() used to do.  The
+ *      relink() is private, so it is done by calling eventlist::sort() on
+ *      the sorted list, which adds only one pass.
+ *
+ * \return
+ *      Returns the best time in milliseconds.
+ */
+
+static double
+time_case
+(
+    int count,
+    const std::function<void (seq66::eventlist &, std::mt19937 &)> & edit,
+    bool adaptive
+)
+{
+    double best = 0.0;
+    std::mt19937 rng(count);
+    for (int run = 0; run < s_runs; ++run)
+    {
+        seq66::eventlist el;
+        make_sorted(el, count);
+        edit(el, rng);
+
+        clocktype::time_point start = clocktype::now();
+        if (adaptive)
+        {
+            el.sort();
+        }
+        else
+        {
+            std::sort(el.begin(), el.end());
+            el.sort();                              /* one pass, relink()   */
+        }
+
+        double ms = std::chrono::duration<double, std::milli>
+        (
+            clocktype::now() - start
+        ).count();
+        if (run == 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+int
+main (int /* argc */, char * /* argv */ [])
+{
+    struct testcase
+    {
+        const char * name;
+        std::function<void (seq66::eventlist &, std::mt19937 &)> edit;
+    };
+    static const testcase s_cases[] =
+    {
+        { "already sorted",     edit_none       },
+        { "64 appended",        edit_append     },
+        { "16 nudged",          edit_nudge      },
+        { "scrambled",          edit_scramble   },
+    };
+    static const int s_counts[] = { 10000, 50000, 200000 };
+
+    std::printf
+    (
+        "%-16s %8s %14s %14s %8s\n",
+        "Edit", "Events", "full sort ms", "adaptive ms", "Speedup"
+    );
+    for (const auto & tc : s_cases)
+    {
+        for (int count : s_counts)
+        {
+            double full = time_case(count, tc.edit, false);
+            double adaptive = time_case(count, tc.edit, true);
+            std::printf
+            (
+                "%-16s %8d %14.3f %14.3f %7.1fx\n",
+                tc.name, count, full, adaptive,
+                adaptive > 0.0 ? full / adaptive : 0.0
+            );
+        }
+    }
+    return 0;
+}
+
+/*
+ * eventlist_sort.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2023-12-10
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This collection of variables describes the options of the application,
@@ -42,6 +42,7 @@
 #include "ctrl/keycontainer.hpp"        /* seq66::keycontainer class        */
 #include "ctrl/midicontrolin.hpp"       /* seq66::midicontrolin class       */
 #include "ctrl/midicontrolout.hpp"      /* seq66::midicontrolout class      */
+#include "midi/portshaper.hpp"          /* seq66::bandwidthlist class       */
 #include "play/clockslist.hpp"          /* list of seq66::e_clock settings  */
 #include "play/inputslist.hpp"          /* list of boolean input settings   */
 #include "play/metro.hpp"               /* seq66::metrosettings class       */
@@ -219,6 +220,13 @@ private:
 
     inputslist m_inputs;
 
+    /**
+     *  The bandwidth settings of the slow output busses, from the
+     *  [midi-bandwidth] section.  Usually empty.
+     */
+
+    bandwidthlist m_bandwidths;
+
     /**
      *  Settings for the metronome.
      */
@@ -298,6 +306,13 @@ private:
     bool m_show_midi;               /**< Show MIDI events to console.       */
     bool m_priority;                /**< Run at high priority (Linux only). */
     int m_thread_priority;          /**< The desired priority (Linux only). */
+    int m_play_workers;             /**< Pattern-evaluation threads, or 0.  */
+    int m_portmidi_latency;         /**< PortMidi output latency (ms), or 0.*/
+    int m_render_ahead;             /**< Render-ahead period (ms), or 0.    */
+    std::string m_status_shm;       /**< Shared-memory status name, or "".  */
+    bool m_song_snapshot;           /**< Use binary snapshots of songs.     */
+    bool m_background_save;         /**< Write the MIDI file on a thread.   */
+    int m_autosave_interval;        /**< Autosave period (seconds), or 0.   */
     bool m_pass_sysex;              /**< Pass SysEx to outputs, not ready.  */
     bool m_with_jack_transport;     /**< Enable synchrony with JACK.        */
     bool m_with_jack_master;        /**< Serve as a JACK transport Master.  */
@@ -649,6 +664,16 @@ public:
         return m_inputs;
     }
 
+    const bandwidthlist & bandwidths () const
+    {
+        return m_bandwidths;
+    }
+
+    bandwidthlist & bandwidths ()
+    {
+        return m_bandwidths;
+    }
+
     metrosettings & metro_settings ()
     {
         return m_metro_settings;
@@ -833,6 +858,41 @@ public:
         return m_thread_priority;
     }
 
+    int play_workers () const
+    {
+        return m_play_workers;
+    }
+
+    int portmidi_latency () const
+    {
+        return m_portmidi_latency;
+    }
+
+    int render_ahead () const
+    {
+        return m_render_ahead;
+    }
+
+    const std::string & status_shm () const
+    {
+        return m_status_shm;
+    }
+
+    bool song_snapshot () const
+    {
+        return m_song_snapshot;
+    }
+
+    bool background_save () const
+    {
+        return m_background_save;
+    }
+
+    int autosave_interval () const
+    {
+        return m_autosave_interval;
+    }
+
     bool pass_sysex () const
     {
         return m_pass_sysex;
@@ -1432,6 +1492,42 @@ public:
         m_thread_priority = p;
     }
 
+    void play_workers (int w)
+    {
+        if (w >= 0)
+            m_play_workers = w;
+    }
+
+    void portmidi_latency (int ms)
+    {
+        if (ms >= 0)
+            m_portmidi_latency = ms;
+    }
+
+    void render_ahead (int ms)
+    {
+        if (ms >= 0)
+            m_render_ahead = ms;
+    }
+
+    void status_shm (const std::string & name);
+
+    void song_snapshot (bool flag)
+    {
+        m_song_snapshot = flag;
+    }
+
+    void background_save (bool flag)
+    {
+        m_background_save = flag;
+    }
+
+    void autosave_interval (int seconds)
+    {
+        if (seconds >= 0)
+            m_autosave_interval = seconds;
+    }
+
     void pass_sysex (bool flag)
     {
         m_pass_sysex = flag;
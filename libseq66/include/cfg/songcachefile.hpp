@@ -0,0 +1,96 @@
+#if ! defined SEQ66_SONGCACHEFILE_HPP
+#define SEQ66_SONGCACHEFILE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songcachefile.hpp
+ *
+ *  This module declares the class for the playlist's song-summary cache.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  The cache sits next to the playlist file, with the same base name and
+ *  the extension ".songcache".  It is written by the application and is
+ *  not meant to be edited.
+ */
+
+#include "cfg/configfile.hpp"           /* seq66::configfile class          */
+#include "midi/songinfo.hpp"            /* seq66::songinfo_map              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Provides a file for reading and writing the summaries made by
+ *  playlist::verify().
+ */
+
+class songcachefile final : public configfile
+{
+
+private:
+
+    /**
+     *  The summaries to be filled or written.
+     */
+
+    songinfo_map & m_song_cache;
+
+public:
+
+    songcachefile
+    (
+        const std::string & filename,
+        songinfo_map & cache,
+        rcsettings & rcs
+    );
+
+    songcachefile () = delete;
+    songcachefile (const songcachefile &) = delete;
+    songcachefile & operator = (const songcachefile &) = delete;
+    virtual ~songcachefile () = default;
+
+    virtual bool parse () override;
+    virtual bool write () override;
+
+private:
+
+    bool scan_song_line (std::string & filepath, songinfo & si);
+
+};          // class songcachefile
+
+}           // namespace seq66
+
+#endif      // SEQ66_SONGCACHEFILE_HPP
+
+/*
+ * songcachefile.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2024-02-22
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module defines the following categories of "global" variables that
@@ -707,9 +707,9 @@ private:
     int m_gmute_tracks;                 /* not included in .usr file    */
 
     /**
-     *  The maximum number of patterns supported is given by the number of
-     *  patterns supported in the panel (32) times the maximum number of
-     *  sets (32), or 1024 patterns.
+     *  The maximum number of patterns supported.  It used to be the number
+     *  of patterns supported in the panel (32) times the maximum number of
+     *  sets (32), or 1024 patterns; it is now seq::maximum(), 31744.
      */
 
     int m_max_sequence;
@@ -808,6 +808,14 @@ private:
 
     std::string m_user_option_logfile;
 
+    /**
+     *  If greater than 0, set by "-o memory=count", seq66cli shows the memory
+     *  used by this many of the largest patterns after loading the song and
+     *  before exiting.  Not saved.
+     */
+
+    int m_user_option_memory_report;
+
     /**
      *  The full path to PDF and browser executables, in case the system
      *  defaults are not present or are not suitable.
@@ -868,6 +876,14 @@ private:
 
     bool m_resume_note_ons;
 
+    /**
+     *  Indicates to also chase (resend) the latest controller, program,
+     *  pressure, and pitch-bend values when notes are resumed or when
+     *  playback is repositioned.
+     */
+
+    bool m_resume_controls;
+
     /**
      *  The size of the fingerprint to use.  The default size is 32, but can
      *  be made larger, at the expense of slowing down drawing slightly.
@@ -981,6 +997,16 @@ private:
 
     bool m_new_pattern_wraparound;
 
+    /**
+     *  The default reduction of recorded controller data for new patterns:
+     *  "none", "delta", or "curve", the value threshold or tolerance, and
+     *  the pulse limit.  See the ccreducer module.
+     */
+
+    std::string m_new_pattern_reduction;
+    int m_new_pattern_reduction_value;
+    int m_new_pattern_reduction_pulses;
+
     /**
      *  Normal (none = no alteration), tighten, quantize, or note-map (jitter
      *  and random are not supported during recording at this time).
@@ -1371,8 +1397,9 @@ public:
     /**
      * \setter m_seqedit_bgsequence
      *
-     *      Note that seq::legal() allows the seq::limit() (0x800 = 2048)
-     *      value, to turn off the use of a global background sequence.
+     *      Note that seq::legal() allows the seq::limit() (0x8000 = 32768)
+     *      value, to turn off the use of a global background sequence.  In
+     *      a MIDI file this value is saved as seq::file_none().
      */
 
     void seqedit_bgsequence (int seqnum)
@@ -1621,6 +1648,11 @@ public:
         return m_user_option_logfile;
     }
 
+    int option_memory_report () const
+    {
+        return m_user_option_memory_report;
+    }
+
     const std::string & user_pdf_viewer () const
     {
         return m_user_pdf_viewer;
@@ -1670,6 +1702,11 @@ public:
         return m_resume_note_ons;
     }
 
+    bool resume_controls () const
+    {
+        return m_resume_controls;
+    }
+
     int fingerprint_size () const
     {
         return m_fingerprint_size;
@@ -1821,6 +1858,21 @@ public:
         return m_new_pattern_wraparound;
     }
 
+    const std::string & new_pattern_reduction () const
+    {
+        return m_new_pattern_reduction;
+    }
+
+    int new_pattern_reduction_value () const
+    {
+        return m_new_pattern_reduction_value;
+    }
+
+    int new_pattern_reduction_pulses () const
+    {
+        return m_new_pattern_reduction_pulses;
+    }
+
     std::string new_pattern_record_string () const;
 
     /*
@@ -1994,6 +2046,11 @@ public:         // used in main application module and the usrfile class
     void option_use_logfile (bool flag);
     void option_logfile (const std::string & file);
 
+    void option_memory_report (int count)
+    {
+        m_user_option_memory_report = count;
+    }
+
     /*
      *  Since these a paths to executable, probably good to provide a full
      *  path, for now we will not enforce that.
@@ -2036,6 +2093,11 @@ public:         // used in main application module and the usrfile class
         m_resume_note_ons = f;
     }
 
+    void resume_controls (bool f)
+    {
+        m_resume_controls = f;
+    }
+
     void session_manager (const std::string & sm);
 
     bool fingerprint_size (int sz);
@@ -2117,6 +2179,20 @@ public:         // used in main application module and the usrfile class
         m_new_pattern_wraparound = flag;
     }
 
+    void new_pattern_reduction (const std::string & method);
+
+    void new_pattern_reduction_value (int v)
+    {
+        if (v >= 0 && v <= c_midibyte_data_max)
+            m_new_pattern_reduction_value = v;
+    }
+
+    void new_pattern_reduction_pulses (int p)
+    {
+        if (p >= 0)
+            m_new_pattern_reduction_pulses = p;
+    }
+
     void grid_mode (gridmode mode)
     {
         m_grid_mode = mode;
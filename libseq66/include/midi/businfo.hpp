@@ -195,6 +195,11 @@ private:
         bus()->stop();
     }
 
+    void flush ()
+    {
+        bus()->flush();
+    }
+
     void continue_from (midipulse tick)
     {
         bus()->continue_from(tick);
@@ -283,6 +288,20 @@ public:
             bi.stop();
     }
 
+    /**
+     *  Flushes all of the busses.  Needed only by APIs that queue output in
+     *  each buss (e.g. the batched PortMidi mode).
+     */
+
+    void flush ()
+    {
+        for (auto & bi : m_container)       /* vector of businfo copies     */
+        {
+            if (bi.active())
+                bi.flush();
+        }
+    }
+
     /**
      *  Continues from the given tick for all of the busses; used for output
      *  busses only.
@@ -326,6 +345,7 @@ public:
     }
 
     void play (bussbyte bus, const event * e24, midibyte channel);
+    void play_direct (bussbyte bus, const event * e24, midibyte channel);
     void sysex (bussbyte bus, const event * ev);
     bool set_clock (bussbyte bus, e_clock clocktype);
 
@@ -0,0 +1,214 @@
+#if ! defined SEQ66_CCREDUCER_HPP
+#define SEQ66_CCREDUCER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          ccreducer.hpp
+ *
+ *  This module declares a filter that thins out recorded controller data.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  A few minutes of expressive playing sends tens of thousands of Control
+ *  Change, Pitch Bend, and Aftertouch messages.  Recorded verbatim, they
+ *  bloat the pattern, its undo copies, the playback scan, and the MIDI
+ *  file.  Most of them can be dropped without any audible difference.
+ *
+ *  Each pattern has a ccreducer, which sequence::stream_event() applies to
+ *  the continuous events it records.  Each channel/controller (or Pitch
+ *  Bend, Channel Pressure, or Aftertouch note) is a separate stream.  The
+ *  last event kept in a stream is its "anchor", and the events received
+ *  since then are held until it is known whether they are needed:
+ *
+ *      -   delta:  An event is kept if its value differs from the anchor by
+ *          at least "value", and if it is at least "pulses" after the
+ *          anchor.  Otherwise it is held, replacing the previous held event.
+ *      -   curve:  The held events are kept only while a straight line from
+ *          the anchor to the newest event passes within "value" of each of
+ *          them.  When one falls outside, the event before the newest
+ *          becomes the new anchor.  This is the incremental ("opening
+ *          window") form of Ramer-Douglas-Peucker simplification.  "pulses",
+ *          if not 0, is the longest distance between kept events.
+ *
+ *  In both modes, a held event is written when the controller then stays
+ *  still for a while (a sixteenth note, or "pulses" if longer), when the
+ *  pattern loops back, and when recording stops, so the final position of
+ *  each gesture is never lost.  Values are in 7-bit units; they are scaled
+ *  by 128 for Pitch Bend.
+ *
+ *  The "switch" controllers (Bank Select, the pedals, Data Entry and the
+ *  (N)RPN selectors, and the Channel Mode messages) are never reduced.
+ */
+
+#include <string>                       /* std::string                      */
+#include <unordered_map>                /* std::unordered_map<>             */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Reduces recorded controller data, per pattern.
+ */
+
+class ccreducer
+{
+
+public:
+
+    /**
+     *  The reduction method.  The values are stored in the MIDI file.
+     */
+
+    enum class method
+    {
+        none,                       /**< Record everything (the default).   */
+        delta,                      /**< Value and time thresholds.         */
+        curve,                      /**< Curve simplification.              */
+        max                         /**< Illegal value, a size value.       */
+    };
+
+private:
+
+    /**
+     *  The events held in a stream, and its anchor.  The last event in
+     *  "held" is the one that will be written if the stream stops.
+     */
+
+    class stream
+    {
+    public:
+
+        bool anchored = false;
+        midipulse anchor_tick = 0;
+        int anchor_value = 0;
+        std::vector<event> held;
+    };
+
+    /**
+     *  The longest curve window, to bound the work per event.
+     */
+
+    static const int c_window_max = 64;
+
+    method m_method;
+    int m_value;
+    midipulse m_pulses;
+
+    /**
+     *  How long a held event waits for the next event of its stream before
+     *  it is written.
+     */
+
+    midipulse m_gap;
+
+    /**
+     *  The streams, keyed by channel and controller.
+     */
+
+    std::unordered_map<int, stream> m_streams;
+
+    /**
+     *  The events to record, returned by process() and flush().  Reused.
+     */
+
+    std::vector<event> m_output;
+
+    /**
+     *  Counts for showing the savings.
+     */
+
+    long m_received;
+    long m_kept;
+
+public:
+
+    ccreducer ();
+
+    void configure (method m, int value, midipulse pulses, int ppqn);
+    const std::vector<event> & process (const event & ev);
+    const std::vector<event> & flush ();
+    void reset ();
+
+    static bool reducible (const event & ev);
+    static std::string method_name (method m);
+    static method method_from_name (const std::string & name);
+
+    bool active () const
+    {
+        return m_method != method::none;
+    }
+
+    method get_method () const
+    {
+        return m_method;
+    }
+
+    int value () const
+    {
+        return m_value;
+    }
+
+    midipulse pulses () const
+    {
+        return m_pulses;
+    }
+
+    long received () const
+    {
+        return m_received;
+    }
+
+    long kept () const
+    {
+        return m_kept;
+    }
+
+private:
+
+    static int stream_key (const event & ev);
+    static int event_value (const event & ev);
+    int threshold (const event & ev) const;
+    void keep (stream & s, const event & ev);
+    void release_held (stream & s);
+    bool fits_line (const stream & s, const event & last) const;
+
+};          // class ccreducer
+
+}           // namespace seq66
+
+#endif      // SEQ66_CCREDUCER_HPP
+
+/*
+ * ccreducer.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
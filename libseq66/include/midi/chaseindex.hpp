@@ -0,0 +1,213 @@
+#if ! defined SEQ66_CHASEINDEX_HPP
+#define SEQ66_CHASEINDEX_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          chaseindex.hpp
+ *
+ *  This module declares a class for quickly finding the MIDI state of a
+ *  pattern at an arbitrary position.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  When playback is repositioned (a seek, a JACK relocation, or a loop back
+ *  to the L marker), the notes that should be sounding, and the most recent
+ *  controller, program-change, channel-pressure, and pitch-bend values, need
+ *  to be sent again.  Formerly sequence::resume_note_ons() scanned every
+ *  event of the pattern, and controller state was not chased at all.
+ *
+ *  The chaseindex is built (lazily) from the sorted and linked event list
+ *  of a sequence. It holds:
+ *
+ *      -   A vector of note intervals, sorted by Note On time, plus a
+ *          checkpoint every c_chase_stride notes listing the notes still
+ *          sounding at that point.
+ *      -   A vector of "state" events (CC, program, pressure, pitch-bend),
+ *          sorted by time, plus a checkpoint every c_chase_stride events
+ *          holding the latest value of each state key.
+ *
+ *  A lookup does a binary search for the checkpoint, then replays at most
+ *  c_chase_stride items, so the cost is O(log n + state size).
+ */
+
+#include <map>                          /* std::map for the state keys      */
+
+#include "midi/event.hpp"               /* seq66::event, event::buffer      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds the note intervals and controller snapshots of a single pattern.
+ *  The sequence owns one of these and rebuilds it when the events change.
+ */
+
+class chaseindex
+{
+
+private:
+
+    /**
+     *  A sounding note. The Note On event is copied, so that the index does
+     *  not depend on the iterators of the event list.
+     */
+
+    class interval
+    {
+    public:
+
+        midipulse on;
+        midipulse off;
+        event note_on;
+
+        bool sounding (midipulse t) const
+        {
+            return on < t && (off > t || on > off);     /* see banner notes */
+        }
+    };
+
+    /**
+     *  A state key combines the status (with channel) and, for a controller,
+     *  the controller number.  The value is the index of the latest event
+     *  in m_states.
+     */
+
+    using statemap = std::map<int, std::size_t>;
+
+    /**
+     *  The note intervals, in Note On order.
+     */
+
+    std::vector<interval> m_notes;
+
+    /**
+     *  Checkpoint k holds the indices of the notes before note k * stride
+     *  that are still sounding at the Note On of note k * stride - 1.
+     */
+
+    std::vector<std::vector<std::size_t>> m_note_checkpoints;
+
+    /**
+     *  The CC, program change, channel pressure, and pitch-bend events, in
+     *  time order.
+     */
+
+    event::buffer m_states;
+
+    /**
+     *  Checkpoint k holds the latest state events before state k * stride.
+     */
+
+    std::vector<statemap> m_state_checkpoints;
+
+    /**
+     *  The state at the end of the pattern, used when the pattern has
+     *  looped at least once, so that it "wraps around".
+     */
+
+    statemap m_final_state;
+
+    /**
+     *  The length of the pattern when the index was built.
+     */
+
+    midipulse m_length;
+
+    /**
+     *  Indicates that the index matches the events of the pattern. Cleared
+     *  by the sequence whenever it is modified.
+     */
+
+    bool m_valid;
+
+public:
+
+    chaseindex ();
+    chaseindex (const chaseindex &) = default;
+    chaseindex & operator = (const chaseindex &) = default;
+    ~chaseindex () = default;
+
+    void build (const event::buffer & evlist, midipulse len);
+    void clear ();
+    int chase_notes (midipulse tick, event::buffer & out) const;
+    int chase_states (midipulse tick, event::buffer & out) const;
+
+    void invalidate ()
+    {
+        m_valid = false;
+    }
+
+    bool valid () const
+    {
+        return m_valid;
+    }
+
+    midipulse length () const
+    {
+        return m_length;
+    }
+
+    bool empty () const
+    {
+        return m_notes.empty() && m_states.empty();
+    }
+
+    static bool is_state_event (const event & e)
+    {
+        return e.is_controller() || e.is_program_change() ||
+            e.is_pitchbend() || is_pressure(e);
+    }
+
+private:
+
+    static bool is_pressure (const event & e)
+    {
+        return event::mask_status(e.get_status()) == EVENT_CHANNEL_PRESSURE;
+    }
+
+    static int state_key (const event & e)
+    {
+        int result = int(e.get_status()) << 8;
+        if (e.is_controller())
+            result |= int(e.d0());
+
+        return result;
+    }
+
+};          // class chaseindex
+
+}           // namespace seq66
+
+#endif      // SEQ66_CHASEINDEX_HPP
+
+/*
+ * chaseindex.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-12-12
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module also declares/defines the various constants, status-byte
@@ -53,6 +53,7 @@
 #include <vector>                       /* SYSEX data stored in vector      */
 
 #include "midi/midibytes.hpp"           /* seq66::midibyte alias, etc.      */
+#include "midi/sharedbytes.hpp"         /* seq66::sharedbytes SysEx/Meta    */
 
 #define SEQ66_STAZED_SELECT_EVENT_HANDLE    /* EXPERIMENTAL */
 
@@ -275,6 +276,7 @@ class event
 
     friend class eventlist;
     friend class sequence;
+    friend class songsnapshot;
 
 public:
 
@@ -389,9 +391,12 @@ private:
      *  for Meta events.  Compare is_sysex() to is_meta() and is_ex_data()
      *  [which tests for both]. In addition, detect and handle the other
      *  Meta message that hold variable amounts of bytes.
+     *
+     *  The bytes are shared, copy-on-write, between copies of the event,
+     *  and, once share_sysex() is called, between identical payloads.
      */
 
-    sysex m_sysex;
+    sharedbytes m_sysex;
 
     /**
      *  This event is used to link NoteOns and NoteOffs together.  The NoteOn
@@ -412,6 +417,22 @@ private:
 
     bool m_has_link;
 
+    /**
+     *  A stable identifier of this event within its eventlist, assigned by
+     *  eventlist::relink().  Zero means not yet assigned.  Unlike m_linked,
+     *  it survives the sorting, copying, and reallocation of the container.
+     */
+
+    int m_id;
+
+    /**
+     *  The m_id of the linked event, or 0.  The eventlist uses it to restore
+     *  m_linked after the container is sorted or copied, without searching
+     *  for the Note Off again.
+     */
+
+    int m_link_id;
+
     /**
      *  Answers the question "is this event selected in editing."
      */
@@ -452,6 +473,8 @@ public:
     );
     event (const event & rhs);
     event & operator = (const event & rhs);
+    event (event &&) = default;                 /* cheap moves for sorting  */
+    event & operator = (event &&) = default;
     virtual ~event ();
 
     /*
@@ -1067,14 +1090,20 @@ public:
         m_sysex.clear();
     }
 
+    /**
+     *  Provides writable access to the SysEx/Meta data.  If the data is
+     *  shared with other events, this event gets its own copy first.  Use
+     *  the const overload when just reading the data.
+     */
+
     sysex & get_sysex ()
     {
-        return m_sysex;
+        return m_sysex.edit();
     }
 
     const sysex & get_sysex () const
     {
-        return m_sysex;
+        return m_sysex.bytes();
     }
 
     midibyte get_sysex (size_t i) const
@@ -1087,6 +1116,22 @@ public:
         return int(m_sysex.size());
     }
 
+    /**
+     *  Replaces the SysEx/Meta data with an identical copy already in use
+     *  elsewhere, if there is one.  Called for complete payloads, such as
+     *  those read from a file.
+     */
+
+    void share_sysex ()
+    {
+        m_sysex.share();
+    }
+
+    std::size_t sysex_memory () const
+    {
+        return m_sysex.memory();
+    }
+
     /**
      *  Determines if this event is a note-on event and is not already linked.
      */
@@ -1119,7 +1164,8 @@ public:
     }
 
     /**
-     *  Sets m_has_link and sets m_link to the provided event pointer.
+     *  Sets m_has_link and sets m_link to the provided event pointer, and
+     *  remembers the ID of that event for eventlist::relink().
      *
      * \param ev
      *      Provides a pointer to the event value to set.  Since we're using
@@ -1131,6 +1177,7 @@ public:
     {
         m_linked = ev;
         m_has_link = true;
+        m_link_id = ev->m_id;
     }
 
     iterator link () const
@@ -1156,6 +1203,7 @@ public:
     void unlink ()
     {
         m_has_link = false;
+        m_link_id = 0;
     }
 
     void paint ()
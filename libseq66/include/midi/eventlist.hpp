@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2023-10-06
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module extracts the event-list functionality from the sequencer
@@ -84,6 +84,7 @@ class eventlist
     friend class editable_events;       /* access to verify_and_link()      */
     friend class midifile;              /* access to print()                */
     friend class sequence;              /* any_selected_notes()             */
+    friend class songsnapshot;          /* access to assign_linked()        */
 
 public:
 
@@ -214,6 +215,21 @@ private:
 
     bool m_link_wraparound;
 
+    /**
+     *  The next event::m_id to give to an event added since the last call
+     *  to relink(), which renumbers the events from 1.
+     */
+
+    int m_next_id;
+
+    /**
+     *  Scratch space for relink(), kept to avoid allocating on each sort.
+     *  Not copied.
+     */
+
+    std::vector<int> m_id_positions;
+    std::vector<int> m_partners;
+
 public:
 
     eventlist ();
@@ -267,6 +283,17 @@ public:
     bool add (const event & e);
     bool append (const event & e);
 
+    /**
+     *  Sizes the container for a known number of appends, as when splitting
+     *  an SMF 0 track.
+     */
+
+    void reserve (int count)
+    {
+        if (count > 0)
+            m_events.reserve(std::size_t(count));
+    }
+
     bool empty () const
     {
         return m_events.empty();
@@ -329,6 +356,9 @@ public:
     }
 
     void clear ();
+    bool compact (bool force = false);
+    std::size_t memory_events () const;
+    std::size_t memory_sysex () const;
     void sort ();
     bool merge (const eventlist & el, bool presort = true);
 
@@ -374,6 +404,8 @@ private:                                /* functions for friend sequence    */
      */
 
     void link_new (bool wrap = false);
+    void relink ();
+    void assign_linked (event::buffer & evlist, const std::vector<int> & links);
     void clear_links ();
     int note_count () const;
     bool first_notes (midipulse & ts, int & n, midipulse snap = 0) const;
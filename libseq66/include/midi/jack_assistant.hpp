@@ -28,13 +28,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-23
- * \updates       2022-09-26
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This class contains a number of functions that used to reside in the
  *  still-large performer module.
  */
 
+#include <atomic>                       /* std::atomic<> for the mailbox    */
+
 #include "cfg/rcsettings.hpp"           /* seq66::enum class timebase       */
 #include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
 
@@ -342,6 +344,31 @@ private:
 
     midibpm m_beats_per_minute;
 
+    /**
+     *  The transport mailbox.  jack_transport_callback() runs in the JACK
+     *  process thread, which must never block, so it only stores the latest
+     *  transport news here.  The performer takes the news on its own
+     *  threads, at the start of an output cycle or an input poll, by calling
+     *  apply_transport().  Each slot holds only the latest value; older ones
+     *  are simply overwritten.
+     *
+     *      -   m_mail_bpm.  A new tempo from the JACK master, or 0.0.
+     *      -   m_mail_tick.  A new transport position, or c_null_midipulse.
+     *      -   m_mail_start.  The transport started rolling while the
+     *          performer was stopped.
+     */
+
+    std::atomic<midibpm> m_mail_bpm;
+    std::atomic<midipulse> m_mail_tick;
+    std::atomic<bool> m_mail_start;
+
+    /**
+     *  The last tempo seen by jack_transport_callback(), so that only
+     *  changes are mailed.  Used only in the JACK process thread.
+     */
+
+    midibpm m_transport_bpm;
+
 public:
 
     jack_assistant
@@ -467,6 +494,7 @@ public:
     void stop (bool rewind = false);
     void position (bool state, midipulse tick = 0);
     bool output (jack_scratchpad & pad);
+    bool apply_transport ();
 
     /**
      * \setter m_ppqn
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2023-12-03
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The mastermidibase module is the base-class version of the mastermidibus
@@ -36,10 +36,12 @@
  *  PortMidi.
  */
 
+#include <memory>                       /* std::unique_ptr<>                */
 #include <vector>                       /* for channel-filtered recording   */
 
 #include "midi/businfo.hpp"             /* seq66::businfo & busarray        */
 #include "midi/midibase.hpp"            /* seq66::midibase::io & recmutex   */
+#include "midi/portshaper.hpp"          /* seq66::portshaper, bandwidthlist */
 #include "play/clockslist.hpp"          /* list of seq66::e_clock settings  */
 #include "play/inputslist.hpp"          /* list of boolean input settings   */
 
@@ -51,6 +53,7 @@ namespace seq66
 {
     class event;
     class midibus;
+    class renderahead;
     class sequence;
 
 /**
@@ -170,6 +173,22 @@ protected:
 
     sequence * m_seq;
 
+    /**
+     *  The optional render-ahead output queue.  Created only if the 'rc'
+     *  option "render-ahead" is greater than 0.  See renderahead.hpp.
+     */
+
+    std::unique_ptr<renderahead> m_render_ahead;
+
+    /**
+     *  The bandwidth shapers of the output busses listed in the 'rc' file's
+     *  [midi-bandwidth] section, indexed by buss number.  Null for the other
+     *  busses, which send events as soon as they are played.  See
+     *  portshaper.hpp.
+     */
+
+    std::vector<std::unique_ptr<portshaper>> m_shapers;
+
     /**
      *  The locking mutex.  This object is passed to an automutex object that
      *  lends exception-safety to the mutex locking.
@@ -268,6 +287,7 @@ public:
     void port_exit (int client, int port);
     void play (bussbyte bus, event * e24, midibyte channel);
     void play_and_flush (bussbyte bus, event * e24, midibyte channel);
+    void play_direct (bussbyte bus, event * e24, midibyte channel);
     void sysex (bussbyte bus, const event * event);
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
@@ -275,7 +295,27 @@ public:
     void print () const;
     void flush ();
     void panic (int displaybuss = c_bussbyte_max);          /* kepler34 func  */
+    bool start_render_ahead (int lookahead_ms);
+    void stop_render_ahead ();
+    bool render_ahead () const;
+    int render_ahead_ms () const;
+    void schedule
+    (
+        bussbyte bus, const event & ev, midibyte channel, long delay_us
+    );
+    int invalidate_ahead ();
+    void release_ahead ();
+    void set_bandwidths (const bandwidthlist & bwl);
+    void drain_bandwidth ();
+    std::string bandwidth_report ();
+
+    bool bandwidth_shaping () const
+    {
+        return ! m_shapers.empty();
+    }
+
     bool dump_midi_input (event in);                        /* seq32 function */
+    std::vector<sequence *> input_sequences ();
     std::string get_midi_bus_name (bussbyte bus, midibase::io iotype) const;
 
     void set_midi_alias
@@ -345,6 +385,9 @@ protected:
     void get_port_statuses (clockslist & outs, inputslist & ins);
     void get_out_port_statuses (clockslist & outs);
     void get_in_port_statuses (inputslist & ins);
+    portshaper * shaper (bussbyte bus);
+    bool drain_shapers ();
+    void release_shapers ();
 
     e_clock clock (bussbyte bus)
     {
@@ -442,6 +485,16 @@ protected:
     virtual bool api_get_midi_event (event * inev) = 0;
     virtual int api_poll_for_midi ();
 
+    /**
+     *  Returns the number of input events already read ahead by the API,
+     *  which is_more_input() can report without locking or polling.
+     */
+
+    virtual int api_input_pending ()
+    {
+        return 0;
+    }
+
 /*
  *  So far, there is no need for these API-specific functions.
  *
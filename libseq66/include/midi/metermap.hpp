@@ -0,0 +1,152 @@
+#if ! defined SEQ66_METERMAP_HPP
+#define SEQ66_METERMAP_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          metermap.hpp
+ *
+ *  This module declares a class for converting between pulses and
+ *  bar:beat:tick when the time signature changes.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  A metermap holds the time signatures of a pattern or of the whole song,
+ *  sorted by starting pulse, each with the number of the bar in which it
+ *  starts.  The bar numbers are accumulated once, when the map is built.
+ *  After that, converting a pulse to B:B:T, or B:B:T to a pulse, is a
+ *  binary search plus a little arithmetic, instead of a scan of all the
+ *  time signatures for every grid line drawn.
+ *
+ *  A time signature that does not start on a bar line of the previous one
+ *  starts a new (short) bar of its own.
+ *
+ *  Bars and beats are numbered from 1, as in the rest of Seq66.  Internally,
+ *  bar indices start at 0.
+ */
+
+#include <string>                       /* std::string for to_string()      */
+#include <vector>                       /* std::vector for the meters       */
+
+#include "midi/midibytes.hpp"           /* seq66::midi_measures, midipulse  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds a sorted list of time signatures and their starting bars.
+ */
+
+class metermap
+{
+
+public:
+
+    /**
+     *  One time signature.  The pulse sizes are precalculated.
+     */
+
+    class meter
+    {
+    public:
+
+        midipulse start;            /**< The pulse where the meter starts.  */
+        int bar;                    /**< The 0-based bar at the start.      */
+        int beats_per_bar;          /**< The numerator.                     */
+        int beat_width;             /**< The denominator.                   */
+        midipulse beat_ticks;       /**< The pulses in one beat.            */
+        midipulse bar_ticks;        /**< The pulses in one bar.             */
+    };
+
+    using meters = std::vector<meter>;
+
+private:
+
+    /**
+     *  The time signatures, sorted by start.  There is always one starting
+     *  at pulse 0.
+     */
+
+    meters m_meters;
+
+    /**
+     *  The PPQN used to size the beats.
+     */
+
+    int m_ppqn;
+
+public:
+
+    metermap ();
+    metermap (int ppqn, int beats, int width);
+
+    void reset (int ppqn, int beats, int width);
+    bool add (midipulse tick, int beats, int width);
+
+    int count () const
+    {
+        return int(m_meters.size());
+    }
+
+    int ppqn () const
+    {
+        return m_ppqn;
+    }
+
+    const meters & items () const
+    {
+        return m_meters;
+    }
+
+    const meter & at (midipulse p) const;
+    midi_measures to_measures (midipulse p) const;
+    midipulse to_pulses (const midi_measures & mm) const;
+    std::string to_string (midipulse p) const;
+    int bar_number (midipulse p) const;
+    midipulse bar_start (int barnumber) const;
+    midipulse beat_start (midipulse p) const;
+    midipulse next_beat (midipulse p) const;
+    midipulse snap (midipulse p, midipulse snaplength) const;
+
+private:
+
+    static meter make_meter (int ppqn, midipulse tick, int beats, int width);
+    meters::const_iterator find_tick (midipulse p) const;
+    void recount_bars ();
+
+};          // class metermap
+
+}           // namespace seq66
+
+#endif      // SEQ66_METERMAP_HPP
+
+/*
+ * metermap.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
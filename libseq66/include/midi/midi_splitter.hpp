@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-24
- * \updates       2021-06-10
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Seq66 can also split an SMF 0 file into multiple tracks, effectively
@@ -71,6 +71,14 @@ private:
 
     bool m_smf0_channels[16];
 
+    /**
+     *  Provides support for SMF 0, holds the number of channel events found
+     *  for each channel, so that each split-out sequence can be sized before
+     *  the events are distributed.
+     */
+
+    int m_smf0_event_counts[16];
+
     /**
      *  Provides support for SMF 0, points to the initial SMF 0 sequence, from
      *  which the single-channel sequences will be created.
@@ -109,7 +117,7 @@ public:
 
 private:
 
-    bool split_channel
+    void setup_channel
     (
         const performer & p,
         const sequence & main_seq,
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-10
- * \updates       2023-09-17
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This class is meant to hold the bytes that represent MIDI events and other
@@ -85,7 +85,7 @@ const midilong c_tempo_track    = 0x2424001A; /**< Alt tempo track number.  */
 const midilong c_seq_color      = 0x2424001B; /**< Feature from Kepler34.   */
 const midilong c_seq_edit_mode  = 0x2424001C; /**< Unused, Kepler34.        */
 const midilong c_seq_loopcount  = 0x2424001D; /**< N-play loop, 0=infinite. */
-const midilong c_reserved_3     = 0x2424001E; /**< Reserved for expansion.  */
+const midilong c_seq_reduction  = 0x2424001E; /**< Recorded CC reduction.   */
 const midilong c_reserved_4     = 0x2424001F; /**< Reserved for expansion.  */
 const midilong c_trig_transpose = 0x24240020; /**< Triggers with transpose. */
 
@@ -126,7 +126,17 @@ public:
         // empty body
     }
 
-    void fill (int tracknumber, const performer & p, bool doseqspec = true);
+    void fill (int tracknumber, bool doseqspec = true);
+
+    /**
+     *  The performer is not used; see the other overload, which a background
+     *  save calls without one.
+     */
+
+    void fill (int tracknumber, const performer & /*p*/, bool doseqspec = true)
+    {
+        fill(tracknumber, doseqspec);
+    }
 
     /**
      *  Returns the size of the container, in midibytes.  Must be overridden
@@ -505,6 +505,7 @@ public:
     }
 
     void play (const event * e24, midibyte channel);
+    void play_direct (const event * e24, midibyte channel);
     void sysex (const event * e24);
     void flush ();
     void start ();
@@ -633,6 +634,18 @@ public:
 
     virtual void api_play (const event * e24, midibyte channel) = 0;
 
+    /**
+     *  Sends one event now, without leaving it in an output buffer that
+     *  another buss shares.  By default the event is played and this buss
+     *  is flushed.  See play_direct().
+     */
+
+    virtual void api_play_direct (const event * e24, midibyte channel)
+    {
+        api_play(e24, channel);
+        api_flush();
+    }
+
     /**
      *  Handles implementation details for SysEx messages.
      *
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-05-20
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The Seq24 MIDI file is a standard, Format 1 MIDI file, with some extra
@@ -43,13 +43,14 @@
  *  converting it to SMF 1.
  */
 
+#include <memory>
 #include <string>
-#include <list>
 #include <vector>
 
 #include "cfg/rcsettings.hpp"           /* enum class rsaction              */
 #include "midi/midibytes.hpp"           /* midishort, midibyte, etc.        */
 #include "midi/midi_splitter.hpp"       /* seq66::midi_splitter             */
+#include "midi/songsnapshot.hpp"        /* seq66::snapshot_song             */
 #include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
 
 /*
@@ -62,6 +63,7 @@ namespace seq66
     class midi_splitter;
     class midi_vector;
     class performer;
+    class sequence;
 
 /**
  *  This class handles the parsing and writing of MIDI files.  In addition to
@@ -169,14 +171,13 @@ private:
     std::vector<midibyte> m_data;
 
     /**
-     *  Provides a list of characters.  The class pushes each MIDI byte into
-     *  this list using the write_byte() function.  Also note that the write()
-     *  function calls sequence::fill_list() to fill a temporary
-     *  std::list<char> (!) buffer, then writes that data <i> backwards </i> to
-     *  this member.  This member is an output buffer.
+     *  Provides the output buffer.  The class pushes each MIDI byte into
+     *  this vector using the write_byte() function.  Once the whole song is
+     *  encoded, encode() hands the bytes over to the caller without copying
+     *  them.
      */
 
-    std::list<midibyte> m_char_list;
+    midibytes m_char_list;
 
     /**
      *  Indicates to store the new key, scale, and background
@@ -216,6 +217,25 @@ private:
 
     midi_splitter m_smf0_splitter;
 
+    /**
+     *  Holds the PPQN settings and the song-level values found while parsing
+     *  an SMF 1 file, for saving or restoring a songsnapshot.
+     */
+
+    snapshot_song m_song_values;
+
+    /**
+     *  The song as taken by snapshot(), for encode_snapshot() to encode,
+     *  perhaps in another thread: detached copies of the active patterns,
+     *  the SMF format, and the SeqSpec track, which is small and is encoded
+     *  at once.
+     */
+
+    std::vector<std::shared_ptr<sequence>> m_saved_tracks;
+    int m_saved_format;
+    bool m_saved_doseqspec;
+    midibytes m_saved_seqspec;
+
 public:
 
     midifile
@@ -235,6 +255,20 @@ public:
     virtual bool write (performer & p, bool doseqspec = true);
 
     bool write_song (performer & p);
+    bool encode
+    (
+        performer & p,
+        midibytes & data,
+        bool doseqspec = true
+    );
+    bool snapshot (performer & p, bool doseqspec = true);
+    bool encode_snapshot (midibytes & data);
+    static bool write_file_data
+    (
+        const std::string & filename,
+        const midibytes & data,
+        std::string & errmsg
+    );
 
     const std::string & error_message () const
     {
@@ -338,6 +372,10 @@ protected:
     bool grab_input_stream (const std::string & tag);
     bool parse_smf_0 (performer & p, int screenset);
     bool parse_smf_1 (performer & p, int screenset, bool is_smf0 = false);
+    void setup_ppqn (performer & p, midishort fileppqn);
+    bool snapshot_allowed (int screenset, bool importing) const;
+    bool load_snapshot (performer & p);
+    void save_snapshot (performer & p);
 
     midilong parse_seqspec_header (int file_size);
     bool parse_seqspec_track (performer & p, int file_size);
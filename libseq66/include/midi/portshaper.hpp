@@ -0,0 +1,305 @@
+#if ! defined SEQ66_PORTSHAPER_HPP
+#define SEQ66_PORTSHAPER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          portshaper.hpp
+ *
+ *  This module declares the bandwidth model used to shape the output of
+ *  slow (DIN or serial) MIDI ports.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  A hardware DIN port runs at 31250 baud, which is 3125 bytes per second,
+ *  or about 1000 three-byte messages per second.  Seq66 normally sends the
+ *  events as fast as the patterns produce them, so a chord on the downbeat
+ *  can end up behind a burst of controller automation, and be smeared by
+ *  several milliseconds in the port's driver.
+ *
+ *  For each output buss listed in the 'rc' file's [midi-bandwidth] section,
+ *  the master buss keeps a portshaper.  It models the port's wire as a
+ *  "byte budget" refilled at the configured rate, with a few milliseconds of
+ *  burst allowed.  While there is budget left, events go straight out.
+ *  Otherwise they wait in one of two queues, drained at each flush of the
+ *  master buss and at each pass of the performer's output loop, whether or
+ *  not there is anything else to play:
+ *
+ *      -   Urgent:  Notes, Program Changes, SysEx, and the "switch"
+ *          controllers (Bank Select, Sustain and the other pedals, and the
+ *          Channel Mode messages), which must keep their order relative to
+ *          the notes.  This queue is always drained first.
+ *      -   Continuous:  The other controllers, Pitch Bend, and Aftertouch.
+ *
+ *  When playback stops, at panic, and when a port goes away, the queues are
+ *  sent out at once, whatever the budget, so that no Note Off is left
+ *  waiting.
+ *
+ *  If "thin" is set, a continuous event that arrives while an older value
+ *  for the same channel and controller is still queued replaces that value
+ *  in the queue.  Otherwise, one that repeats the last value sent is
+ *  dropped.  Only the latest value of a moving controller matters.
+ *
+ *  If "running-status" is set, the byte budget counts a message that
+ *  repeats the previous status byte as having no status byte, as the
+ *  serial drivers do.  The ALSA and JACK APIs take whole messages, so this
+ *  only affects the model, not the bytes sent by Seq66.
+ *
+ *  The shaper counts the bytes sent and saved, the events delayed and
+ *  thinned, and the largest backlog and delay, for the report shown by
+ *  seq66cli at exit.  A port that had to delay events is saturated.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <deque>                        /* std::deque<>                     */
+#include <map>                          /* std::map<>                       */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class busarray;
+
+/**
+ *  Holds the [midi-bandwidth] settings read from the 'rc' file, one per
+ *  output buss.
+ */
+
+class bandwidthlist
+{
+
+public:
+
+    /**
+     *  The bandwidth settings for one output buss.
+     */
+
+    class setting
+    {
+    public:
+
+        int bytes_per_second;       /**< The wire rate, 3125 for DIN MIDI.  */
+        bool thin;                  /**< Drop superseded controller values. */
+        bool running_status;        /**< Count running-status savings.      */
+    };
+
+private:
+
+    /**
+     *  The settings, keyed by output buss number.
+     */
+
+    std::map<bussbyte, setting> m_settings;
+
+public:
+
+    bandwidthlist ();
+
+    void clear ()
+    {
+        m_settings.clear();
+    }
+
+    bool empty () const
+    {
+        return m_settings.empty();
+    }
+
+    int count () const
+    {
+        return int(m_settings.size());
+    }
+
+    const std::map<bussbyte, setting> & settings () const
+    {
+        return m_settings;
+    }
+
+    bool add (bussbyte bus, const setting & s);
+    bool add_list_line (const std::string & line);
+    std::string io_list_lines () const;
+
+};          // class bandwidthlist
+
+/**
+ *  The bandwidth model and priority queues for one output buss.
+ */
+
+class portshaper
+{
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+     *  The number of thinning keys per channel:  128 controllers, Pitch
+     *  Bend, Channel Pressure, and 128 Aftertouch notes.
+     */
+
+    static const int c_key_count = 128 + 2 + 128;
+
+    /**
+     *  The key of a queued SysEx message, which has no thinning key.
+     */
+
+    static const int c_sysex_key = -2;
+
+    /**
+     *  An event waiting for budget.
+     */
+
+    class item
+    {
+    public:
+
+        clock::time_point queued;
+        midibyte channel;
+        int key;
+        int size;
+        event ev;
+    };
+
+    /**
+     *  The configuration of this port.
+     */
+
+    bandwidthlist::setting m_setting;
+
+    /**
+     *  The byte budget.  Can go below 0 by the size of the last message
+     *  sent, so that a message is never split.
+     */
+
+    double m_credit;
+
+    /**
+     *  The largest budget allowed to build up while the port is idle.
+     */
+
+    double m_burst;
+
+    /**
+     *  The time of the last refill of the budget, and of the creation of
+     *  the shaper, for the load calculation.
+     */
+
+    clock::time_point m_last_refill;
+    clock::time_point m_start;
+
+    /**
+     *  The last status byte sent, for running status.  0 if none.
+     */
+
+    midibyte m_running_status;
+
+    /**
+     *  The queues, in order of arrival.
+     */
+
+    std::deque<item> m_urgent;
+    std::deque<item> m_continuous;
+
+    /**
+     *  The last value sent for each channel and thinning key, or -1.
+     */
+
+    std::vector<short> m_last_values;
+
+    /**
+     *  Statistics for the saturation report.
+     */
+
+    unsigned long m_messages;       /**< Messages (and SysEx) sent.         */
+    unsigned long m_bytes;          /**< Bytes sent, per the model.         */
+    unsigned long m_saved_bytes;    /**< Status bytes saved by running st.  */
+    unsigned long m_delayed;        /**< Events that had to be queued.      */
+    unsigned long m_thinned;        /**< Continuous events dropped.         */
+    int m_backlog;                  /**< Bytes waiting in the queues.       */
+    int m_peak_backlog;             /**< The largest backlog seen.          */
+    long m_max_delay_us;            /**< The longest wait in a queue.       */
+
+public:
+
+    portshaper (const bandwidthlist::setting & s);
+
+    void play
+    (
+        busarray & outs, bussbyte bus, const event & ev, midibyte channel
+    );
+    void drain (busarray & outs, bussbyte bus);
+    void release (busarray & outs, bussbyte bus);
+    void sysex (busarray & outs, bussbyte bus, const event & ev);
+    void clear ();
+    std::string report (bussbyte bus) const;
+
+    bool saturated () const
+    {
+        return m_delayed > 0;
+    }
+
+    bool pending () const
+    {
+        return ! m_urgent.empty() || ! m_continuous.empty();
+    }
+
+private:
+
+    void refill ();
+    int message_size (const event & ev, midibyte channel) const;
+    void send
+    (
+        busarray & outs, bussbyte bus,
+        const event & ev, midibyte channel, int key
+    );
+    void send_queued
+    (
+        busarray & outs, bussbyte bus, std::deque<item> & q, bool all = false
+    );
+    void enqueue
+    (
+        std::deque<item> & q, const event & ev,
+        midibyte channel, int key, int size
+    );
+    static int thin_key (const event & ev);
+    static int thin_value (const event & ev);
+
+};          // class portshaper
+
+}           // namespace seq66
+
+#endif      // SEQ66_PORTSHAPER_HPP
+
+/*
+ * portshaper.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,203 @@
+#if ! defined SEQ66_RENDERAHEAD_HPP
+#define SEQ66_RENDERAHEAD_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          renderahead.hpp
+ *
+ *  This module declares a time-ordered output queue with its own dispatch
+ *  thread, used by the master buss to send events rendered ahead of time.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Normally the performer's output thread plays the patterns "just in time",
+ *  so the timing of the output can be no better than the wake-up precision
+ *  of that thread.  When the 'rc' option "render-ahead" is greater than 0,
+ *  the performer instead renders the next "render-ahead" milliseconds of
+ *  events and schedules each one here, with the delay calculated from its
+ *  pulse.  The dispatch thread sleeps until each event is due and sends it
+ *  through the normal busses, so this works with every MIDI API.
+ *
+ *  When the user changes something that affects the output (a mute, a
+ *  queue, an edit, a tempo change, or a reposition), the performer calls
+ *  invalidate().  All queued events are dropped, except Note Offs, which
+ *  are kept so that no note is left hanging; the patterns are then
+ *  re-rendered from the current pulse in the next output cycle.  So a
+ *  change is heard within one output cycle, not one look-ahead period.
+ *  A re-rendered Note Off replaces the kept Note Off for the same buss,
+ *  channel, and note, so it is not sent twice.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <condition_variable>           /* std::condition_variable          */
+#include <deque>                        /* std::deque<>                     */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class mastermidibase;
+
+/**
+ *  The render-ahead queue and its dispatch thread.
+ */
+
+class renderahead
+{
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+     *  A scheduled event.  The serial number keeps events with the same
+     *  due time in the order in which they were scheduled.  The kept flag
+     *  marks a Note Off that survived invalidate().
+     */
+
+    class item
+    {
+    public:
+
+        clock::time_point when;
+        unsigned long serial;
+        bussbyte bus;
+        midibyte channel;
+        bool kept;
+        event ev;
+
+        bool operator < (const item & rhs) const
+        {
+            return when != rhs.when ? when < rhs.when : serial < rhs.serial ;
+        }
+    };
+
+    /**
+     *  The master buss through which the events are sent.
+     */
+
+    mastermidibase & m_master;
+
+    /**
+     *  The dispatch thread.
+     */
+
+    std::thread m_thread;
+
+    /**
+     *  Protects the queue and the exit flag.
+     */
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    /**
+     *  The scheduled events, in order of due time.
+     */
+
+    std::deque<item> m_queue;
+
+    /**
+     *  The events taken from the queue in one dispatch, reused.
+     */
+
+    std::vector<item> m_due;
+
+    /**
+     *  Incremented for each scheduled event.
+     */
+
+    unsigned long m_serial;
+
+    /**
+     *  The number of Note Offs in the queue that were kept by invalidate().
+     *  While it is 0, schedule() does not look for them.
+     */
+
+    int m_kept_offs;
+
+    /**
+     *  The look-ahead period in milliseconds.
+     */
+
+    int m_lookahead_ms;
+
+    /**
+     *  Raised to make the dispatch thread exit.
+     */
+
+    bool m_exit;
+
+public:
+
+    renderahead (mastermidibase & mmb);
+    renderahead (const renderahead &) = delete;
+    renderahead & operator = (const renderahead &) = delete;
+    ~renderahead ();
+
+    bool start (int lookahead_ms);
+    void stop ();
+    void schedule
+    (
+        bussbyte bus, const event & ev, midibyte channel, long delay_us
+    );
+    int invalidate ();
+    void release ();
+
+    bool active () const
+    {
+        return m_thread.joinable();
+    }
+
+    int lookahead_ms () const
+    {
+        return m_lookahead_ms;
+    }
+
+private:
+
+    void dispatch_func ();
+    void drop_kept_off (const item & i);
+    void send (std::vector<item> & items);
+
+};          // class renderahead
+
+}           // namespace seq66
+
+#endif      // SEQ66_RENDERAHEAD_HPP
+
+/*
+ * renderahead.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,140 @@
+#if ! defined SEQ66_SHAREDBYTES_HPP
+#define SEQ66_SHAREDBYTES_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sharedbytes.hpp
+ *
+ *  This module declares a copy-on-write holder for SysEx and Meta payloads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Each event used to own its own vector of SysEx or Meta bytes, so that a
+ *  device-initialization dump repeated in every pattern, or the same text
+ *  event in every track, was stored many times, and every copy of an event
+ *  (undo, clipboard, pattern copies, playback) copied the bytes again.
+ *
+ *  A sharedbytes object holds a reference-counted pointer to the bytes.
+ *  Copying it only copies the pointer.  Modifying it, via edit(), first
+ *  makes a private copy if the bytes are shared.
+ *
+ *  When a payload is complete (e.g. after reading it from a MIDI file),
+ *  share() looks it up in a process-wide store of payloads, keyed by a hash
+ *  of the bytes, and replaces it with the stored copy if one matches.  The
+ *  store holds only weak pointers, so a payload is freed when the last
+ *  event using it goes away.  The store is protected by a mutex; it is used
+ *  when loading and editing, never in the output thread.
+ */
+
+#include <memory>                       /* std::shared_ptr<>                */
+
+#include "midi/midibytes.hpp"           /* seq66::midibytes vector          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Holds SysEx or Meta data that can be shared between events.
+ */
+
+class sharedbytes
+{
+
+private:
+
+    using pointer = std::shared_ptr<midibytes>;
+
+    /**
+     *  The bytes.  Null if there are none, so that the many events without
+     *  a payload do not allocate anything.
+     */
+
+    pointer m_bytes;
+
+    /**
+     *  Indicates that m_bytes came from (or was added to) the store.  Such
+     *  bytes are never modified in place, even if this object is the only
+     *  user, because the store would then hold the wrong key.
+     */
+
+    bool m_shared;
+
+public:
+
+    sharedbytes ();
+    sharedbytes (const sharedbytes &) = default;
+    sharedbytes & operator = (const sharedbytes &) = default;
+    sharedbytes (sharedbytes &&) = default;
+    sharedbytes & operator = (sharedbytes &&) = default;
+    ~sharedbytes () = default;
+
+    const midibytes & bytes () const;
+    midibytes & edit ();
+    void share ();
+    std::size_t memory () const;
+
+    void clear ()
+    {
+        m_bytes.reset();
+        m_shared = false;
+    }
+
+    bool empty () const
+    {
+        return ! m_bytes || m_bytes->empty();
+    }
+
+    std::size_t size () const
+    {
+        return m_bytes ? m_bytes->size() : 0 ;
+    }
+
+    midibyte operator [] (std::size_t i) const
+    {
+        return (*m_bytes)[i];
+    }
+
+    bool shared () const
+    {
+        return m_shared;
+    }
+
+    static std::size_t store_count ();
+
+};          // class sharedbytes
+
+}           // namespace seq66
+
+#endif      // SEQ66_SHAREDBYTES_HPP
+
+/*
+ * sharedbytes.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,215 @@
+#if ! defined SEQ66_SONGINFO_HPP
+#define SEQ66_SONGINFO_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songinfo.hpp
+ *
+ *  This module declares a class that summarizes a MIDI file without loading
+ *  it into the performer.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  The deep verification of a playlist used to load every song into the
+ *  performer, one after the other.  That is slow, and it replaces whatever
+ *  the performer held.  The songinfo class instead reads the file into a
+ *  private buffer and walks the SMF chunks and events, recording only what
+ *  the playlist needs to know: the format, the number of tracks, the PPQN,
+ *  the length in pulses, the initial tempo, the file size, time, and hash,
+ *  and any error.  It touches nothing else, so many songs can be scanned
+ *  at the same time.  Cakewalk WRK files are parsed by wrkfile::scan(),
+ *  which builds each track detached from any performer.
+ */
+
+#include <ctime>                        /* std::time_t                      */
+#include <map>                          /* std::map<>                       */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  A summary of one song file.
+ */
+
+class songinfo
+{
+    friend class songcachefile;
+    friend class wrkfile;
+
+public:
+
+    /**
+     *  The 64-bit FNV-1a hash of the file's bytes.
+     */
+
+    using hash_t = unsigned long long;
+
+private:
+
+    /**
+     *  The size of the file when scanned.
+     */
+
+    size_t m_file_size;
+
+    /**
+     *  The modification time of the file when scanned.
+     */
+
+    std::time_t m_mod_time;
+
+    /**
+     *  The hash of the file contents.
+     */
+
+    hash_t m_hash;
+
+    /**
+     *  The SMF format (0 or 1), or -1 for a Cakewalk WRK file.
+     */
+
+    int m_format;
+
+    /**
+     *  The number of MTrk chunks (or WRK tracks) found.
+     */
+
+    int m_track_count;
+
+    /**
+     *  The PPQN from the header, or 0 for SMPTE timing.
+     */
+
+    int m_ppqn;
+
+    /**
+     *  The length of the longest track, in pulses.
+     */
+
+    midipulse m_length;
+
+    /**
+     *  The first Set Tempo found, or 0 if none.
+     */
+
+    double m_bpm;
+
+    /**
+     *  Empty if the file scanned without error.
+     */
+
+    std::string m_error;
+
+public:
+
+    songinfo ();
+
+    bool scan (const std::string & filepath);
+    bool current (const std::string & filepath) const;
+    std::string summary () const;
+
+    static hash_t hash_data (const std::vector<midibyte> & data);
+
+    bool valid () const
+    {
+        return m_error.empty();
+    }
+
+    const std::string & error () const
+    {
+        return m_error;
+    }
+
+    size_t file_size () const
+    {
+        return m_file_size;
+    }
+
+    std::time_t mod_time () const
+    {
+        return m_mod_time;
+    }
+
+    hash_t hash () const
+    {
+        return m_hash;
+    }
+
+    int format () const
+    {
+        return m_format;
+    }
+
+    int track_count () const
+    {
+        return m_track_count;
+    }
+
+    int ppqn () const
+    {
+        return m_ppqn;
+    }
+
+    midipulse length () const
+    {
+        return m_length;
+    }
+
+    double bpm () const
+    {
+        return m_bpm;
+    }
+
+private:
+
+    bool scan_smf (const std::vector<midibyte> & data);
+    bool scan_track (const midibyte * p, const midibyte * end);
+    bool set_error (const std::string & msg);
+
+};          // class songinfo
+
+/**
+ *  Song summaries keyed by the full path to the song file.
+ */
+
+using songinfo_map = std::map<std::string, songinfo>;
+
+}           // namespace seq66
+
+#endif      // SEQ66_SONGINFO_HPP
+
+/*
+ * songinfo.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
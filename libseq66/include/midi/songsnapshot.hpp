@@ -0,0 +1,165 @@
+#if ! defined SEQ66_SONGSNAPSHOT_HPP
+#define SEQ66_SONGSNAPSHOT_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songsnapshot.hpp
+ *
+ *  This module declares a binary snapshot of the patterns of a MIDI file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Loading a large song means decoding every track, then sorting and
+ *  linking the events of every pattern.  When the 'rc' option
+ *  "song-snapshot" is on, midifile::parse() saves the loaded patterns in a
+ *  snapshot file next to the MIDI file (same base name, extension ".snap"):
+ *  the events already sorted, with each Note On/Off link stored as an index,
+ *  the triggers, and the pattern and song settings that the tracks set.
+ *
+ *  The next time that file is loaded, the snapshot is memory-mapped and the
+ *  patterns are rebuilt from it directly.  The SeqSpec track (mute-groups,
+ *  set notes, etc.) is still parsed from the MIDI file, which is small and
+ *  cheap.  The snapshot header holds the size and hash of the MIDI file and
+ *  the PPQN settings in force, so a changed file or a different PPQN simply
+ *  causes a normal parse and a new snapshot.
+ *
+ *  The snapshot is a cache, in native byte order, and is not meant to be
+ *  shared between machines.  Only unmodified SMF 1 files are snapshotted.
+ */
+
+#include <cstdint>                      /* std::int32_t, etc.               */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte, midipulse       */
+#include "midi/songinfo.hpp"            /* seq66::songinfo::hash_t          */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+class sequence;
+
+/**
+ *  Song-level values that the tracks of the MIDI file set, plus the PPQN
+ *  settings that the snapshot depends on.
+ */
+
+struct snapshot_song
+{
+    int ppqn;                   /**< The PPQN the midifile was created with.  */
+    int default_ppqn;           /**< The usr() default PPQN.                  */
+    int use_file_ppqn;          /**< 1 if the file PPQN is used.              */
+    int effective_ppqn;         /**< The PPQN of the patterns, not stored.    */
+    long us_per_quarter_note;   /**< From the first tempo of track 0.         */
+    double bpm;                 /**< The first tempo, or 0 if none.           */
+    size_t seqspec_offset;      /**< Offset of the SeqSpec track.             */
+    std::string song_info;      /**< The first text event of the first track. */
+};
+
+/**
+ *  Reads and writes the snapshot of one MIDI file.
+ */
+
+class songsnapshot
+{
+
+private:
+
+    /**
+     *  The full path to the snapshot file.
+     */
+
+    std::string m_name;
+
+    /**
+     *  The mapped (or, on Windows, read) snapshot file, and its size.
+     */
+
+    const midibyte * m_data;
+    size_t m_size;
+
+    /**
+     *  The read position in m_data.
+     */
+
+    size_t m_pos;
+
+    /**
+     *  Holds the file data on platforms without mmap().
+     */
+
+    std::vector<midibyte> m_buffer;
+
+public:
+
+    songsnapshot (const std::string & midifilename);
+    songsnapshot (const songsnapshot &) = delete;
+    songsnapshot & operator = (const songsnapshot &) = delete;
+    ~songsnapshot ();
+
+    static std::string snapshot_name (const std::string & midifilename);
+
+    bool write
+    (
+        performer & p,
+        const std::vector<midibyte> & mididata,
+        const snapshot_song & song
+    );
+    bool load
+    (
+        performer & p,
+        const std::vector<midibyte> & mididata,
+        snapshot_song & song
+    );
+
+    const std::string & name () const
+    {
+        return m_name;
+    }
+
+private:
+
+    bool map_file ();
+    void unmap_file ();
+    const midibyte * take (size_t bytes);
+    const midibyte * take (std::int64_t count, size_t size);
+    bool read_sequence (performer & p, int ppqn);
+
+};          // class songsnapshot
+
+}           // namespace seq66
+
+#endif      // SEQ66_SONGSNAPSHOT_HPP
+
+/*
+ * songsnapshot.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
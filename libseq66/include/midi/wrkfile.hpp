@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-04
- * \updates       2022-05-14
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the WRK format, see, for example:
@@ -47,6 +47,7 @@ namespace seq66
 {
     class performer;
     class sequence;
+    class songinfo;
 
 /**
  * Cakewalk WRK file format (input only)
@@ -129,6 +130,13 @@ private:
 
     performer * m_performer;
 
+    /**
+     *  Set only by scan(), which parses the file without a performer.  The
+     *  tracks are then counted and measured here, and deleted.
+     */
+
+    songinfo * m_song_info;
+
     /** Holds the screen-set number in force for reading this WRK file.  While
      * it is normally 0, it can be non-zero for WRK-file import.
      */
@@ -201,6 +209,7 @@ public:
     (
         performer & p, int screenset = 0, bool importing = false
     ) override;
+    bool scan (songinfo & si);
     double get_real_time (midipulse ticks) const;
 
 private:
@@ -226,6 +235,7 @@ private:
     (
         performer & p, sequence & seq, int seqnum, int screenset
     ) override;
+    sequence * next_sequence ();
     void next_track
     (
         int trackno,
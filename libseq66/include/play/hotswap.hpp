@@ -0,0 +1,204 @@
+#if ! defined SEQ66_HOTSWAP_HPP
+#define SEQ66_HOTSWAP_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          hotswap.hpp
+ *
+ *  This module declares a staging area for replacing patterns, control maps,
+ *  note maps, and mute-groups while playing.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Loading a 'ctrl', 'mutes', or 'drums' file, or importing patterns,
+ *  used to change the structures that the output and input threads are
+ *  reading.  Now, while playing, the new objects are built completely by
+ *  the thread that loads them (normally the user-interface thread), and
+ *  are only "staged" here.  Then:
+ *
+ *      -   Imported patterns are installed in the set-mapper at once by
+ *          the loading thread, as when not playing, so the user interface
+ *          sees them at once.  But they are added to a copy of the
+ *          play-set, the "ready" play-set, instead of the live one.
+ *      -   The output thread, at the next bar boundary, swaps the ready
+ *          play-set with the live one, and swaps in the staged note-mapper.
+ *          These are pointer swaps; nothing is built, freed, or notified on
+ *          the output thread.  Then it marks the controls as due.
+ *      -   The input thread, the only reader of the MIDI control map, then
+ *          swaps in the staged MIDI controls, and publishes the staged key
+ *          controls and mute-groups with an atomic shared-pointer exchange,
+ *          since the user interface reads those.
+ *
+ *  When not playing, the input thread publishes everything at once.  The
+ *  realtime threads never wait on the staging lock; if it is busy, they
+ *  try again on the next cycle.
+ *
+ *  The objects replaced (the old play-set, note-mapper, key controls, and
+ *  mute-groups) are "retired" here rather than freed, so that a reader that
+ *  got a reference just before the swap can finish with it.  They are
+ *  freed by the loading thread at the next staging.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <functional>                   /* std::function<>                  */
+#include <memory>                       /* std::shared_ptr<>, unique_ptr<>  */
+#include <mutex>                        /* std::mutex                       */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse                 */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class keycontainer;
+class midicontrolin;
+class mutegroups;
+class notemapper;
+class playset;
+
+/**
+ *  Holds the objects waiting to be published to the realtime threads.
+ */
+
+class hotswap
+{
+
+public:
+
+    /**
+     *  A change made to the ready play-set by the loading thread.
+     */
+
+    using editor = std::function<bool (playset &)>;
+
+private:
+
+    /**
+     *  Protects the staged objects.  The realtime threads only try-lock it.
+     */
+
+    std::mutex m_mutex;
+
+    /**
+     *  Indicates that something is staged, so that the realtime threads can
+     *  check cheaply.
+     */
+
+    std::atomic<bool> m_pending;
+
+    /**
+     *  Set by the output thread once the bar boundary is reached, so that
+     *  the input thread can swap in the controls.
+     */
+
+    std::atomic<bool> m_controls_due;
+
+    /**
+     *  The bar number seen on the last check, or -1 if not yet checked
+     *  since the last staging.
+     */
+
+    std::atomic<long> m_last_bar;
+
+    /**
+     *  The staged objects.  Null pointers mean that nothing of that kind is
+     *  staged.
+     */
+
+    std::unique_ptr<playset> m_play_set;
+    std::shared_ptr<notemapper> m_note_mapper;
+    std::unique_ptr<midicontrolin> m_midi_control_in;
+    std::shared_ptr<keycontainer> m_key_controls;
+    std::shared_ptr<mutegroups> m_mutes;
+
+    /**
+     *  The objects replaced at the last publication, freed at the next
+     *  staging.
+     */
+
+    std::unique_ptr<playset> m_old_play_set;
+    std::shared_ptr<notemapper> m_old_note_mapper;
+    std::shared_ptr<keycontainer> m_old_key_controls;
+    std::shared_ptr<mutegroups> m_old_mutes;
+
+public:
+
+    hotswap ();
+    hotswap (const hotswap &) = delete;
+    hotswap & operator = (const hotswap &) = delete;
+    ~hotswap ();
+
+    bool stage_play_set (const playset & live, const editor & edit);
+    bool edit_play_set (const editor & edit);
+    void drop_play_set ();
+    void stage_note_mapper (std::shared_ptr<notemapper> nm);
+    void stage_controls (const midicontrolin & mci, const keycontainer & kc);
+    void stage_mutes (const mutegroups & mg);
+    void clear ();
+
+    bool bar_crossed (midipulse tick, midipulse barlength);
+    bool publish_patterns
+    (
+        playset & live,
+        std::shared_ptr<notemapper> & livenm,
+        bool & nmchanged
+    );
+    bool publish_controls
+    (
+        midicontrolin & livemci,
+        std::shared_ptr<keycontainer> & livekc,
+        std::shared_ptr<mutegroups> & livemg,
+        bool & mgchanged
+    );
+
+    bool pending () const
+    {
+        return m_pending;
+    }
+
+    bool controls_due () const
+    {
+        return m_controls_due;
+    }
+
+private:
+
+    void release_old ();
+    void update_pending (bool restage = false);
+
+};          // class hotswap
+
+}           // namespace seq66
+
+#endif      // SEQ66_HOTSWAP_HPP
+
+/*
+ * hotswap.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-12
- * \updates       2024-04-30
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The main player!  Coordinates sets, patterns, mutes, playlists, you name
@@ -45,6 +45,8 @@
  */
 
 #include <memory>                       /* std::shared_ptr<>, unique_ptr<>  */
+#include <mutex>                        /* std::recursive_mutex             */
+#include <set>                          /* std::set<>, batch, box select    */
 #include <vector>                       /* std::vector<>                    */
 #include <thread>                       /* std::thread                      */
 
@@ -52,16 +54,16 @@
 #include "ctrl/opcontainer.hpp"         /* class seq66::opcontainer         */
 #include "midi/jack_assistant.hpp"      /* optional seq66::jack_assistant   */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus ALSA/JACK   */
+#include "play/hotswap.hpp"             /* seq66::hotswap staging area      */
 #include "play/metro.hpp"               /* seq66::metro metronome pattern   */
 #include "play/playlist.hpp"            /* seq66::playlist                  */
+#include "play/recordroutes.hpp"        /* seq66::recordroutes targets      */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 #include "play/setmapper.hpp"           /* seq66::seqmanager and seqstatus  */
+#include "play/sharedstatus.hpp"        /* seq66::sharedstatus surface      */
+#include "play/thruroutes.hpp"          /* seq66::thruroutes MIDI Thru      */
 #include "util/condition.hpp"           /* seq66::condition/synchronizer    */
 
-#if defined USE_SONG_BOX_SELECT
-#include <set>                          /* std::set, arbitary selection     */
-#endif
-
 /*
  *  Do not document a namespace; it breaks Doxygen.
  */
@@ -78,6 +80,13 @@ namespace seq66
 const int c_transpose_down_limit = c_notes_count / 2;
 const int c_transpose_up_limit = -c_transpose_down_limit;
 
+/**
+ *  The minimum number of patterns in the play-set for the playpool to be
+ *  used.  With fewer patterns, the hand-off costs more than it saves.
+ */
+
+const int c_play_pool_minimum = 32;
+
 /*
  * Forward references.
  */
@@ -190,6 +199,44 @@ public:
 
     };
 
+    /**
+     *  A nested class to group many arm, queue, and mute changes into one
+     *  transaction.  While a batch is open, the output thread does not play
+     *  the patterns, so it sees either none or all of the changes, and the
+     *  control-out announcements of the changed patterns are collected.
+     *  When the batch is destroyed, each changed pattern is announced once,
+     *  with a single flush.  Batches can nest; only the outermost one
+     *  commits.  See batch_begin() and batch_commit().
+     */
+
+    class batch
+    {
+
+    private:
+
+        performer & m_perf;
+        bool m_announce;
+
+    public:
+
+        batch (performer & p, bool announce = true) :
+            m_perf      (p),
+            m_announce  (announce)
+        {
+            m_perf.batch_begin();
+        }
+
+        batch () = delete;
+        batch (const batch &) = delete;
+        batch & operator =(const batch &) = delete;
+
+        ~batch ()
+        {
+            (void) m_perf.batch_commit(m_announce);
+        }
+
+    };
+
     /**
      *  A nested class used for notification of group-learn and other changes.
      *  The easiest way to use this class is by inheriting from it, then
@@ -442,10 +489,12 @@ private:
 
     /**
      *  Provides an optional note-mapper or drum-mapper, read from a ".drums"
-     *  file.
+     *  file.  It is shared, and is loaded and stored with std::atomic_load()
+     *  and std::atomic_store(), so that it can be replaced while the input
+     *  thread is using it.
      */
 
-    std::unique_ptr<notemapper> m_note_mapper;
+    std::shared_ptr<notemapper> m_note_mapper;
 
     /**
      *  Provides an optional pointer to a metronome pattern, owned and managed
@@ -549,10 +598,13 @@ private:                            /* key, midi, and op container section  */
     mutable bool m_port_map_error;
 
     /**
-     *  Provides a default-filled keycontrol container.
+     *  Provides a default-filled keycontrol container.  It is replaced, not
+     *  modified, when a 'ctrl' file is loaded while running, so it is held
+     *  by a shared pointer that is loaded and stored atomically.  See the
+     *  hotswap module.
      */
 
-    keycontainer m_key_controls;
+    std::shared_ptr<keycontainer> m_key_controls;
 
     /**
      *  Provides a default-filled midicontrol container.
@@ -568,10 +620,11 @@ private:                            /* key, midi, and op container section  */
 
     /**
      *  Provides a default-filled mutegroups container.  It is a copy of the
-     *  data read into the global rcsettings object.
+     *  data read into the global rcsettings object.  Like the key controls,
+     *  it is replaced atomically when a 'mutes' file is loaded.
      */
 
-    mutegroups m_mute_groups;
+    std::shared_ptr<mutegroups> m_mute_groups;
 
     /**
      *  Holds a map of midioperation functors to be used to control patterns,
@@ -620,6 +673,81 @@ private:                            /* key, midi, and op container section  */
 
     bool m_out_thread_launched;
 
+    /**
+     *  The optional pool of pattern-evaluation threads, created when the
+     *  'rc' option "play-workers" is greater than 0.  See the playpool
+     *  module.
+     */
+
+    std::unique_ptr<playpool> m_play_pool;
+
+    /**
+     *  The optional shared-memory status surface, created when the 'rc'
+     *  option "status-shm" is not empty.  See the sharedstatus module.
+     */
+
+    std::unique_ptr<sharedstatus> m_shared_status;
+
+    /**
+     *  Holds the patterns, controls, note-mapper, and mute-groups loaded
+     *  while playing, until the output thread reaches a bar boundary.  See
+     *  the hotswap module.
+     */
+
+    hotswap m_hot_swap;
+
+    /**
+     *  If true, install_sequence() adds the patterns to a ready play-set in
+     *  m_hot_swap while playing, instead of the live one.  See
+     *  stage_patterns().
+     */
+
+    bool m_stage_patterns;
+
+    /**
+     *  The precompiled MIDI Thru routes, used and rebuilt by the input
+     *  thread.  See the thruroutes module and thru_changed().
+     */
+
+    thruroutes m_thru_routes;
+
+    /**
+     *  The precompiled recording targets for recording by buss or by
+     *  channel, used and rebuilt by the input thread along with the MIDI
+     *  Thru routes.  See the recordroutes module.
+     */
+
+    recordroutes m_record_routes;
+
+    /**
+     *  Held by a thread that has a batch open (see the batch class), and by
+     *  the output thread while it plays the patterns.  Recursive, so that
+     *  batches can nest, and so that the output thread can open a batch
+     *  itself (e.g. when a playlist song is loaded during playback).
+     */
+
+    std::recursive_mutex m_batch_mutex;
+
+    /**
+     *  The nesting depth of the open batch.  Changed only by the thread
+     *  that holds m_batch_mutex.
+     */
+
+    int m_batch_depth;
+
+    /**
+     *  The thread that has the batch open, so that only its announcements
+     *  are deferred.  The output thread's own announcements are not.
+     */
+
+    std::atomic<std::thread::id> m_batch_owner;
+
+    /**
+     *  The patterns whose announcements were deferred by the open batch.
+     */
+
+    std::set<seq::number> m_batch_pending;
+
     /**
      *  Indicates that the input thread has been started.
      */
@@ -709,6 +837,50 @@ private:                            /* key, midi, and op container section  */
 
     bool m_resume_note_ons;
 
+    /**
+     *  Indicates to also chase controller, program, pressure, and pitch-bend
+     *  state when notes are resumed or playback is repositioned.  A
+     *  usrsettings value.
+     */
+
+    bool m_resume_controls;
+
+    /**
+     *  Raised by move_tick() and jack_reposition() so that the output thread
+     *  chases the pattern state at the new position (see chase_sequences())
+     *  before it plays the next frame.
+     */
+
+    std::atomic<bool> m_chase_pending;
+
+    /**
+     *  Raised when something that affects the output changes while
+     *  render-ahead is active (see mastermidibase::start_render_ahead()).
+     *  The output thread then drops the scheduled events and re-renders the
+     *  patterns from the current pulse.
+     */
+
+    std::atomic<bool> m_ahead_invalid;
+
+    /**
+     *  The pulse up to which the patterns have been rendered ahead.
+     */
+
+    midipulse m_ahead_tick;
+
+    /**
+     *  The length of a pulse in microseconds, used to convert the pulses of
+     *  rendered events to delays.  Updated by the output thread.
+     */
+
+    double m_ahead_pulse_us;
+
+    /**
+     *  The buffer into which the patterns are rendered ahead, reused.
+     */
+
+    renderbuffer m_ahead_buffer;
+
     /**
      *  Holds the current PPQN for usage in various actions.  If 0 is the
      *  value, then m_file_ppqn will be used.
@@ -779,6 +951,17 @@ private:                            /* key, midi, and op container section  */
 
     int m_beat_width;
 
+    /**
+     *  The song's time-signatures, for conversions between pulses and
+     *  bar:beat:tick in the song editor and the B:B:T display.  Built
+     *  lazily by meter_map() from m_beats_per_bar, m_beat_width, and the
+     *  time-signature events of the first pattern that has any.  Any change
+     *  to the song clears m_meter_map_valid.
+     */
+
+    mutable metermap m_meter_map;
+    mutable std::atomic<bool> m_meter_map_valid;
+
     /**
      *  Augments the beats/bar and beat-width with the additional values
      *  included in a Time Signature meta event.  This value provides the
@@ -1169,10 +1352,18 @@ public:
 
     void modify ()
     {
+        invalidate_meter_map();
         if (! playlist_active())
             m_is_modified = true;
     }
 
+    const metermap & meter_map () const;
+
+    void invalidate_meter_map ()
+    {
+        m_meter_map_valid = false;
+    }
+
     /*
      * Added 2022-07-27 for issue #90.  See usage in qsmainwnd.
      */
@@ -1187,6 +1378,9 @@ public:
     }
 
     void unmodify ();                           /* for write_midi_file()    */
+    void compact_patterns ();                   /* for write_midi_file()    */
+    std::string memory_report (int count);
+    std::string bandwidth_report ();
 
     bool get_settings (const rcsettings & rcs, const usrsettings & usrs);
     bool put_settings (rcsettings & rcs, usrsettings & usrs);
@@ -1249,6 +1443,31 @@ public:
 
     bool open_note_mapper (const std::string & notefile);
     bool save_note_mapper (const std::string & notefile = "");
+    bool stage_note_mapper (const std::string & notefile);
+    bool stage_control_file (const std::string & ctrlfile);
+    bool stage_mute_groups (const std::string & mfg);
+
+    /**
+     *  Turn this on around the parsing of a MIDI file imported while
+     *  playing.  Its patterns are installed as they are parsed, but start
+     *  playing at the next bar boundary instead of in the middle of a bar.
+     */
+
+    void stage_patterns (bool flag)
+    {
+        m_stage_patterns = flag;
+    }
+
+    /**
+     *  Called when anything that affects MIDI Thru or recording changes, so
+     *  that the input thread rebuilds its Thru routes and recording targets
+     *  before the next event.
+     */
+
+    void thru_changed ()
+    {
+        m_thru_routes.invalidate();
+    }
     bool open_mutegroups (const std::string & mfg);
     bool save_mutegroups (const std::string & mfg = "");
     bool open_playlist (const std::string & pl);
@@ -1377,6 +1596,12 @@ public:
             m_play_list->song_filepath() : std::string("") ;
     }
 
+    std::string song_summary () const
+    {
+        return bool(m_play_list) ?
+            m_play_list->song_summary() : std::string("") ;
+    }
+
     int song_midi_number () const
     {
         return bool(m_play_list) ? m_play_list->song_midi_number() : 0 ;
@@ -1680,6 +1905,7 @@ public:
     void set_beats_per_bar (int bpm)
     {
         m_beats_per_bar = bpm;
+        invalidate_meter_map();
 #if defined SEQ66_JACK_SUPPORT
         m_jack_asst.set_beats_per_measure(bpm);
 #endif
@@ -1705,6 +1931,7 @@ public:
     void set_beat_length (int bl)
     {
         m_beat_width = bl;
+        invalidate_meter_map();
 #if defined SEQ66_JACK_SUPPORT
         m_jack_asst.set_beat_width(bl);
 #endif
@@ -1769,6 +1996,8 @@ public:
         m_record_by_channel = flag;
         if (master_bus())
             master_bus()->record_by_channel(flag);
+
+        thru_changed();
     }
 
     bool record_by_channel () const
@@ -1781,6 +2010,8 @@ public:
         m_record_by_buss = flag;
         if (master_bus())
             master_bus()->record_by_buss(flag);
+
+        thru_changed();
     }
 
     bool record_by_buss () const
@@ -1789,6 +2020,7 @@ public:
     }
 
     bool sequence_inbus_setup ();
+    bool sequence_inbus_setup (const playset & ps);
     void sequence_inbus_clear ();
     sequence * sequence_inbus_lookup (const event & ev);
 
@@ -1847,6 +2079,20 @@ public:
     }
 #endif
 
+    /**
+     *  Applies the JACK transport news posted by the JACK process thread.
+     *  See jack_assistant::apply_transport().
+     */
+
+    bool jack_apply_transport ()
+    {
+#if defined SEQ66_JACK_SUPPORT
+        return m_jack_asst.apply_transport();
+#else
+        return false;
+#endif
+    }
+
     /**
      * \getter m_jack_asst.is_running()
      *      This function is useful for announcing the status of JACK in
@@ -2281,6 +2527,21 @@ public:
     void auto_play ();
     void play_all_sets (midipulse tick);
     void play (midipulse tick);
+
+    bool use_play_pool () const
+    {
+        return m_play_pool && m_play_pool->active() &&
+            play_set().seq_count() >= c_play_pool_minimum;
+    }
+
+    bool use_render_ahead () const
+    {
+        return m_master_bus && m_master_bus->render_ahead() &&
+            ! is_jack_running() && ! m_usemidiclock;
+    }
+
+    void invalidate_ahead ();
+
     void all_notes_off ();
 
     void unqueue_sequences (int hotseq)
@@ -2546,7 +2807,10 @@ public:
     void toggle_playing_tracks ()
     {
         if (! song_mode())
+        {
+            batch b(*this);
             set_mapper().toggle_playing_tracks();
+        }
     }
 
     bool any_group_unmutes () const
@@ -2558,7 +2822,8 @@ public:
     (
         sequence * seq,
         seq::number & seqno,
-        bool fileload = false
+        bool fileload = false,
+        bool presorted = false
     );
     bool install_metronome ();
     bool reload_metronome ();
@@ -2969,7 +3234,10 @@ public:
     void announce_automation (bool activate = true);
     void announce_exit (bool playstatesoff = true);
     bool announce_sequence (seq::pointer s, seq::number sn);
+    midicontrolout::seqaction sequence_action (seq::pointer s) const;
     bool announce_pattern (seq::number sn);
+    void batch_begin ();
+    bool batch_commit (bool announce = true);
     void announce_mutes ();
     void set_midi_control_out ();
 
@@ -3084,6 +3352,23 @@ public:
         m_resume_note_ons = f;
     }
 
+    bool resume_controls () const
+    {
+        return m_resume_controls;
+    }
+
+    void resume_controls (bool f)
+    {
+        m_resume_controls = f;
+    }
+
+    bool chasing () const
+    {
+        return m_resume_note_ons || m_resume_controls;
+    }
+
+    void chase_sequences (midipulse tick);
+
     void select_triggers_in_range
     (
         seq::number seqlow, seq::number seqhigh,
@@ -3375,10 +3660,34 @@ private:
     bool log_current_tempo ();
     bool create_master_bus ();
     void reset_sequences (bool pause = false);
+    bool install_sequence_now
+    (
+        sequence * seq,
+        seq::number & seqno,
+        bool fileload,
+        bool presorted
+    );
+    bool stage_sequence
+    (
+        sequence * seq,
+        seq::number & seqno,
+        bool fileload,
+        bool presorted
+    );
+    bool read_note_mapper
+    (
+        const std::string & notefile,
+        std::shared_ptr<notemapper> & nm
+    );
+    void stage_controls (const rcsettings & rcs);
+    void publish_patterns ();
+    void publish_controls ();
+    void build_thru_routes ();
+    void build_record_routes ();
 
     bool notemap_exists () const
     {
-        return bool(m_note_mapper);
+        return bool(std::atomic_load(&m_note_mapper));
     }
 
     void copy_triggers ()
@@ -3424,12 +3733,12 @@ public:                                 /* access functions for the containers *
 
     const keycontainer & key_controls () const
     {
-        return m_key_controls;
+        return *std::atomic_load(&m_key_controls);
     }
 
     keycontainer & key_controls ()
     {
-        return m_key_controls;
+        return *std::atomic_load(&m_key_controls);
     }
 
     bool midi_control_keystroke (const keystroke & k);
@@ -3443,12 +3752,12 @@ public:                                 /* access functions for the containers *
 
     std::string lookup_slot_key (int seqno) const
     {
-        return m_key_controls.slot_key(seqno % screenset_size());
+        return key_controls().slot_key(seqno % screenset_size());
     }
 
     std::string lookup_mute_key (int mute_number) const
     {
-        return m_key_controls.mute_key(mute_number);
+        return key_controls().mute_key(mute_number);
     }
 
     const midicontrolin & midi_control_in () const
@@ -3533,12 +3842,12 @@ public:                                 /* access functions for the containers *
 
     const mutegroups & mutes () const
     {
-        return m_mute_groups;
+        return *std::atomic_load(&m_mute_groups);
     }
 
     mutegroups & mutes ()
     {
-        return m_mute_groups;
+        return *std::atomic_load(&m_mute_groups);
     }
 
     /*
@@ -3578,6 +3887,7 @@ private:
 private:
 
     void output_func ();
+    void render_ahead (midipulse tick, bool songmode);
     void input_func ();
     bool poll_cycle ();
     void launch_input_thread ();
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2023-07-13
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  * \todo
@@ -36,8 +36,10 @@
  */
 
 #include <map>                          /* std::map<>                       */
+#include <vector>                       /* std::vector<>                    */
 
 #include "cfg/basesettings.hpp"         /* seq66::basesettings class        */
+#include "midi/songinfo.hpp"            /* seq66::songinfo_map              */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -222,6 +224,15 @@ private:
 
     bool m_deep_verify;
 
+    /**
+     *  Holds the summaries of the songs made by a deep verification, keyed
+     *  by the full path to each song.  Also stored in a ".songcache" file
+     *  next to the playlist file, so that a playlist that has not changed
+     *  is verified without scanning its songs again.
+     */
+
+    songinfo_map m_song_cache;
+
     /**
      *  Provides an iterator to the current playlist.  If valid, it provides
      *  access to the name of the playlist, its file-directory, and its list
@@ -506,6 +517,7 @@ public:
     int next_available_song_number () const;
     int next_available_list_number () const;
 
+    std::string song_summary () const;
     bool open_song (const std::string & filename, bool verifymode = false);
     bool open_select_song (int index, bool opensong = true);
     bool open_select_song_by_midi (int ctrl, bool opensong = true);
@@ -557,6 +569,10 @@ private:
         const std::string & filename
     );
     bool verify (bool strong = false);
+    bool verify_songs (const std::vector<std::string> & fnames);
+    std::string song_cache_filename () const;
+    bool load_song_cache ();
+    bool save_song_cache ();
 
     play_list & play_list_map ()
     {
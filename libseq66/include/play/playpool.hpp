@@ -0,0 +1,234 @@
+#if ! defined SEQ66_PLAYPOOL_HPP
+#define SEQ66_PLAYPOOL_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playpool.hpp
+ *
+ *  This module declares a small pool of worker threads that evaluates the
+ *  patterns of the play-set in parallel.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Normally performer::play() calls sequence::play_queue() for each pattern
+ *  in the play-set, one after the other, and each pattern puts its events
+ *  directly onto the master buss.  With very large sets, that single output
+ *  thread saturates one CPU.
+ *
+ *  When the 'rc' option "play-workers" is greater than 0, the performer
+ *  creates a playpool.  Each output cycle, the play-set is partitioned
+ *  across the workers.  Each sequence "renders" its events into the buffer
+ *  of its worker (see sequence::render_to()) instead of sending them.  Once
+ *  all workers are done, the buffers are merged in a deterministic order
+ *  (time-stamp, then sequence number, then order of generation) and sent on
+ *  the output thread.
+ *
+ *  Patterns that call back into the performer while playing (the metronome,
+ *  song-recording patterns, and queued or one-shot patterns) are still
+ *  evaluated on the output thread, but they render into the same merge.
+ *  In song mode the triggers can arm or disarm any pattern, so then all of
+ *  the patterns are evaluated on the output thread.
+ */
+
+#include <condition_variable>           /* std::condition_variable          */
+#include <memory>                       /* std::shared_ptr<>                */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <thread>                       /* std::thread                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class mastermidibase;
+class performer;
+class sequence;
+
+/**
+ *  An event rendered by a sequence, along with the information needed to
+ *  send it later and to order it.  A tempo event is stored as is, and is
+ *  applied to the performer when merged.
+ */
+
+class renderitem
+{
+
+public:
+
+    midipulse stamp;                    /**< Absolute tick of the event.    */
+    int seqno;                          /**< Sequence number, for ordering. */
+    int order;                          /**< Generation order in the seq.   */
+    bussbyte bus;                       /**< The true output buss.          */
+    midibyte channel;                   /**< The output channel.            */
+    event ev;                           /**< The event, prepared for send.  */
+
+    bool operator < (const renderitem & rhs) const
+    {
+        if (stamp != rhs.stamp)
+            return stamp < rhs.stamp;
+        else if (seqno != rhs.seqno)
+            return seqno < rhs.seqno;
+        else
+            return order < rhs.order;
+    }
+
+};
+
+using renderbuffer = std::vector<renderitem>;
+
+/**
+ *  The fixed pool of pattern-evaluation threads.
+ */
+
+class playpool
+{
+
+public:
+
+    using seqlist = std::vector<std::shared_ptr<sequence>>;
+
+private:
+
+    /**
+     *  The performer whose tempo is changed by rendered tempo events.
+     */
+
+    performer & m_parent;
+
+    /**
+     *  The worker threads.  Their number is fixed at start().
+     */
+
+    std::vector<std::thread> m_threads;
+
+    /**
+     *  Holds the sequences assigned to each worker for the current cycle.
+     *  These vectors are reused from cycle to cycle.
+     */
+
+    std::vector<std::vector<sequence *>> m_jobs;
+
+    /**
+     *  Holds the sequences that must be played on the output thread.
+     */
+
+    std::vector<sequence *> m_serial;
+
+    /**
+     *  One render buffer per worker, plus one (the last) for the sequences
+     *  played on the output thread.
+     */
+
+    std::vector<renderbuffer> m_buffers;
+
+    /**
+     *  The merge buffer, reused from cycle to cycle.
+     */
+
+    renderbuffer m_merged;
+
+    /**
+     *  Synchronizes the start and completion of a cycle.
+     */
+
+    std::mutex m_mutex;
+    std::condition_variable m_start_cv;
+    std::condition_variable m_done_cv;
+
+    /**
+     *  Incremented for each cycle, so that a worker knows it has new work.
+     */
+
+    unsigned m_generation;
+
+    /**
+     *  The number of workers that have not finished the current cycle.
+     */
+
+    int m_pending;
+
+    /**
+     *  Raised to make the workers exit.
+     */
+
+    bool m_exit;
+
+    /**
+     *  The parameters of the current cycle.
+     */
+
+    midipulse m_tick;
+    bool m_song_mode;
+    bool m_resume;
+
+public:
+
+    playpool (performer & p);
+    playpool (const playpool &) = delete;
+    playpool & operator = (const playpool &) = delete;
+    ~playpool ();
+
+    bool start (int workers);
+    void stop ();
+    void play
+    (
+        const seqlist & seqs, midipulse tick,
+        bool songmode, bool resumenoteons
+    );
+
+    int workers () const
+    {
+        return int(m_threads.size());
+    }
+
+    bool active () const
+    {
+        return ! m_threads.empty();
+    }
+
+    static bool parallel_safe (const sequence & s, bool songmode);
+
+private:
+
+    void worker_func (int index);
+    void play_jobs (std::vector<sequence *> & jobs, renderbuffer & rb);
+    void merge (mastermidibase & mmb);
+
+};          // class playpool
+
+}           // namespace seq66
+
+#endif      // SEQ66_PLAYPOOL_HPP
+
+/*
+ * playpool.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,138 @@
+#if ! defined SEQ66_RECORDROUTES_HPP
+#define SEQ66_RECORDROUTES_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          recordroutes.hpp
+ *
+ *  This module declares a precompiled table of recording targets.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  When several patterns record at once, each incoming event used to be
+ *  offered to the recording patterns in turn.  Recording by channel called
+ *  mastermidibase::dump_midi_input(), which called stream_event() (and so
+ *  locked) each pattern until one with a matching channel took the event.
+ *  Recording by buss searched the list of patterns with an input buss.
+ *  With sixteen patterns recording sixteen channels, the last channel paid
+ *  for sixteen locks.
+ *
+ *  Now the input thread looks up the event's input buss and channel in a
+ *  table that gives the patterns to record into, in order.  Normally that
+ *  is one pattern, so each event takes one lock.  The table is rebuilt (by
+ *  the input thread) along with the MIDI Thru routes, i.e. after anything
+ *  that affects recording changes:  the recording status, buss, or channel
+ *  of a pattern, or the recording mode.  See performer::thru_changed().
+ *
+ *  The table follows the old lookup rules exactly:
+ *
+ *      -   By buss:  The first pattern with a given input buss takes all
+ *          the events from that buss.  The channel is not used, but the
+ *          table has the same (buss, channel) layout for both modes.
+ *      -   By channel:  The buss is not used.  A pattern with channel
+ *          matching on takes the events on its channel, and ends the list.
+ *          A pattern with it off takes the events on every channel, along
+ *          with the patterns after it.
+ */
+
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::bussbyte, midibyte, etc.  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class event;
+class sequence;
+
+/**
+ *  Holds the recording targets used by the input thread.
+ */
+
+class recordroutes
+{
+
+public:
+
+    /**
+     *  The patterns that record an event, in the order they get it.
+     */
+
+    using targets = std::vector<sequence *>;
+
+private:
+
+    /**
+     *  If true, the rows of the table are input busses.  Otherwise there is
+     *  one row, used for every buss.
+     */
+
+    bool m_by_buss;
+
+    /**
+     *  The table, indexed by row times the number of channels plus the
+     *  channel.  Used only by the input thread.
+     */
+
+    std::vector<targets> m_table;
+
+public:
+
+    recordroutes ();
+    recordroutes (const recordroutes &) = delete;
+    recordroutes & operator = (const recordroutes &) = delete;
+    ~recordroutes () = default;
+
+    bool empty () const
+    {
+        return m_table.empty();
+    }
+
+    void clear ()
+    {
+        m_table.clear();
+    }
+
+    void build_by_buss (const std::vector<sequence *> & patterns);
+    void build_by_channel (const std::vector<sequence *> & patterns);
+    const targets * lookup (bussbyte buss, midibyte channel) const;
+    const targets * lookup (const event & ev) const;
+    bool route_event (event ev) const;
+
+};          // class recordroutes
+
+}           // namespace seq66
+
+#endif      // SEQ66_RECORDROUTES_HPP
+
+/*
+ * recordroutes.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
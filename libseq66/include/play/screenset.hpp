@@ -29,7 +29,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2023-11-14
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module also creates a small structure for managing sequence
@@ -168,6 +168,16 @@ private:
 
     using container = std::vector<seq>;
 
+    /**
+     *  Provides an alias for the per-set view of the active patterns, in slot
+     *  order.  Pattern storage is radix-indexed: the set number selects a
+     *  lazily-created screenset in the setmaster's map, and the remainder
+     *  selects a slot in its container.  This view lets the play-set be
+     *  filled from the patterns that exist, not from every slot.
+     */
+
+    using playview = std::vector<seq::pointer>;
+
 private:
 
     /**
@@ -220,6 +230,13 @@ private:
 
     container m_container;
 
+    /**
+     *  Holds the active patterns of this set, kept up to date by add(),
+     *  remove(), and clear().
+     */
+
+    playview m_play_view;
+
     /**
      *  Indicates the the set (bank) number represented by this screenset
      *  object.  If set to sm_number_none, this screenset is not active.
@@ -583,6 +600,11 @@ private:
         return m_container;
     }
 
+    const playview & play_view () const
+    {
+        return m_play_view;
+    }
+
     container & seq_container ()
     {
         return m_container;
@@ -671,6 +693,18 @@ public:
         m_sequence_array.clear();
     }
 
+    /**
+     *  Exchanges the contents of two playsets without copying or freeing
+     *  anything, so that the output thread can do it.  See the hotswap
+     *  module.
+     */
+
+    void swap (playset & rhs)
+    {
+        m_screen_sets.swap(rhs.m_screen_sets);
+        m_sequence_array.swap(rhs.m_sequence_array);
+    }
+
     /*
      * Stupid GDB says "cannot evaluate, may be inlined".
      */
@@ -38,13 +38,14 @@
  * Special static test functions:
  *
  *  -   maximum(). Returns the maximum supported usable sequence
- *      number (plus one), which is 1024, but could be increased to 2048.  To
- *      clarify, usable sequence numbers range from 0 to 1023 at present.
- *  -   limit().  Returns 2048 (0x0800), which indicates a legal value that
- *      represents "no background" sequence when present in a Sequencer66 MIDI
- *      file.
- *  -   legal(seqno). Returns true if the number is between 0 and 2048.
- *  -   valid(seqno). Returns true if the number is between 0 and 2047.
+ *      number (plus one), which is 31744 (0x7C00).  Usable sequence numbers
+ *      range from 0 to 31743.
+ *  -   limit().  Returns 32768 (0x8000), which indicates a legal value that
+ *      represents "no background" sequence in memory.
+ *  -   file_none().  Returns 2048 (0x0800), which represents "no background"
+ *      sequence when present in a Sequencer66 MIDI file.
+ *  -   legal(seqno). Returns true if the number is between 0 and limit().
+ *  -   valid(seqno). Returns true if the number is below maximum().
  *  -   none(seqno). Returns true if the sequence number is -1.
  *  -   disabled(seqno). Return true if the sequence number is limit().
  *  -   null(seqno).
@@ -217,14 +218,14 @@ public:
      *  we limit them to a constant value, which seems to be well above the
      *  number of simultaneous playing sequences the application can support.
      *  Based on trials, the b4uacuse-stress.midi file, which has only about 4
-     *  sets (128 patterns) pretty much loads up a CPU.  Based on
-     *  seq::limit(), we can have patterns ranging from 0 to 2047.  For
-     *  testing right now, we leave the old limit in place.
+     *  sets (128 patterns) pretty much loads up a CPU.  But large sessions
+     *  keep many more patterns than they play at once, and the slots are
+     *  allocated only per set in use, so the range is now 0 to 31743.
      */
 
     static int maximum ()
     {
-        return sequence::maximum();             /* 1024 */
+        return sequence::maximum();             /* 31744 */ /* 0x7C00 */
     }
 
     /**
@@ -234,22 +235,47 @@ public:
 
     static number metronome ()
     {
-        return sequence::metronome();           /* 2047 */
+        return sequence::metronome();           /* 32767 */
     }
 
     /**
      *  The limiting sequence number, in macro form.  This value indicates
-     *  that no background sequence value has been assigned yet.  However, we
-     *  have issues saving a negative number in MIDI, so we will use the
-     *  "proprietary" track's bogus sequence number, which doubles the 1024
-     *  sequences we can support.  Values between 0 (inclusive) and 2048
-     *  (exclusive) are valid.  But 2048 is a <i> legal</i> value, used only
-     *  for disabling the selection of a background sequence.
+     *  that no background sequence value has been assigned yet.  Values
+     *  below maximum() are valid.  But limit() is a <i> legal</i> value,
+     *  used only for disabling the selection of a background sequence.  It
+     *  is never written to a file; see file_none().
      */
 
     static number limit ()
     {
-        return sequence::limit();               /* 2048 */  /* 0x0800 */
+        return sequence::limit();               /* 32768 */ /* 0x8000 */
+    }
+
+    /**
+     *  The "no background sequence" value as saved in a MIDI file.  It was
+     *  the old limit(), and stays fixed so that files keep their meaning
+     *  when limit() changes.  A background pattern numbered 2048 therefore
+     *  reads back as "none".
+     */
+
+    static int file_none ()
+    {
+        return 2048;                            /* 0x0800 */
+    }
+
+    /**
+     *  Converts a background sequence number between its in-memory and its
+     *  saved form.
+     */
+
+    static int to_file (number seqno)
+    {
+        return seqno == limit() ? file_none() : int(seqno) ;
+    }
+
+    static number from_file (int seqno)
+    {
+        return seqno == file_none() ? limit() : number(seqno) ;
     }
 
     /**
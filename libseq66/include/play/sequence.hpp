@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-30
- * \updates       2024-08-20
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The functions add_list_var() and add_long_list() have been replaced by
@@ -45,6 +45,10 @@
 #include "seq66_features.hpp"           /* various feature #defines         */
 #include "cfg/usrsettings.hpp"          /* enum class record                */
 #include "midi/calculations.hpp"        /* seq66::lengthfix, alteration     */
+#include "midi/ccreducer.hpp"           /* seq66::ccreducer                 */
+#include "midi/chaseindex.hpp"          /* seq66::chaseindex                */
+#include "midi/metermap.hpp"            /* seq66::metermap                  */
+#include "play/playpool.hpp"            /* seq66::renderbuffer              */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
 #include "play/triggers.hpp"            /* seq66::triggers, etc.            */
 #include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
@@ -282,10 +286,21 @@ private:
 
     /**
      *  Provides a stack of event-lists for use with the undo and redo
-     *  facility.
+     *  facility.  The stacked lists are exposed (read-only) for
+     *  memory_use().
      */
 
-    using eventstack = std::stack<eventlist>;
+    class eventstack : public std::stack<eventlist>
+    {
+
+    public:
+
+        const container_type & items () const
+        {
+            return c;
+        }
+
+    };
 
 public:
 
@@ -311,6 +326,24 @@ public:
 
     using timesig_list = std::vector<timesig>;
 
+    /**
+     *  Holds an estimate of the heap memory used by a pattern, in bytes.
+     *  See memory_use().
+     */
+
+    struct memory
+    {
+        std::size_t events;         /**< The events, by capacity.           */
+        std::size_t sysex;          /**< SysEx and Meta payloads.           */
+        std::size_t undo;           /**< The undo and redo event lists.     */
+        std::size_t triggers;       /**< Triggers with their undo and redo. */
+
+        std::size_t total () const
+        {
+            return events + sysex + undo + triggers;
+        }
+    };
+
 private:
 
     /**
@@ -380,6 +413,23 @@ private:
 
     timesig_list m_time_signatures;
 
+    /**
+     *  Holds the same time-signatures with their starting bars, for fast
+     *  conversion between pulses and bar:beat:tick.  Rebuilt along with
+     *  m_time_signatures in analyze_time_signatures().
+     */
+
+    metermap m_meter_map;
+
+    /**
+     *  Holds the sounding-note intervals and controller snapshots used to
+     *  chase the state of the pattern upon a reposition.  It is invalidated
+     *  in set_dirty() and verify_and_link(), and is rebuilt lazily by
+     *  resume_note_ons().
+     */
+
+    chaseindex m_chase_index;
+
     /**
      *  Provides a list of event actions to undo for the Stazed LFO and
      *  seqdata support.
@@ -499,6 +549,22 @@ private:
 
     unsigned short m_playing_notes[c_notes_count];
 
+    /**
+     *  If not null, put_event_on_bus() and off_playing_notes() append their
+     *  events to this buffer instead of sending them.  Set by the playpool
+     *  workers for the duration of one play_queue() call.  Tempo events are
+     *  also rendered, and applied by the playpool on the output thread.
+     */
+
+    renderbuffer * m_render;
+
+    /**
+     *  Numbers the events rendered by this sequence, so that the merge
+     *  keeps their original order within a time-stamp.
+     */
+
+    int m_render_order;
+
     /**
      *  Indicates if the sequence was playing.  This value is set at the end
      *  of the play() function.  It is used to continue playing after changing
@@ -589,6 +655,14 @@ private:
 
     int m_loop_count_max;
 
+    /**
+     *  The optional reduction of recorded controller data, Pitch Bend, and
+     *  Aftertouch.  The defaults come from the 'usr' file; the settings are
+     *  stored in a c_seq_reduction SeqSpec, if active.
+     */
+
+    ccreducer m_cc_reducer;
+
     /**
      *  Indicates if we have turned off from a snap operation.
      */
@@ -753,10 +827,11 @@ private:
     /**
      *  A new member so that the sequence number is carried along with the
      *  sequence.  This number is set in the performer::install_sequence()
-     *  function.
+     *  function.  An int, because limit() (0x8000) does not fit in a
+     *  short.
      */
 
-    short m_seq_number;
+    int m_seq_number;
 
     /**
      *  Implements a feature from the Kepler34 project.  It is an index into a
@@ -899,7 +974,7 @@ private:
      *  be set.
      */
 
-    short m_background_sequence;
+    int m_background_sequence;
 
     /**
      *  Provides locking for the sequence.  Made mutable for use in
@@ -928,40 +1003,60 @@ public:
     virtual ~sequence ();
 
     void partial_assign (const sequence & rhs, bool toclipboard = false);
+    void copy_for_save (const sequence & rhs);
+
+    /*
+     *  The pattern slots are held sparsely (a map of screensets created on
+     *  demand, see setmapper), so these values cost nothing until patterns
+     *  are added.  They stay below 0x8000 because a pattern number is saved
+     *  in the 16-bit MIDI sequence-number meta event.
+     */
 
     static short maximum ()
     {
-        return 1024;
+        return 0x7C00;                              /* 31744                */
     }
 
     static short recorder ()
     {
-        return 2040;
+        return 0x7FF8;                              /* 32760                */
     }
 
-    static short is_recorder (int s)
+    static bool is_recorder (int s)
     {
-        return short(s) == 2040;
+        return s == 0x7FF8;
     }
 
     static short metronome ()
     {
-        return 2047;
+        return 0x7FFF;                              /* 32767                */
     }
 
     static bool is_metronome (int s)
     {
-        return s == 2047;
+        return s == 0x7FFF;
     }
 
     static int limit ()
     {
-        return 2048;                                /* 0x0800               */
+        return 0x8000;                              /* 32768                */
     }
 
     static bool is_normal (int s)
     {
-        return s < 1024;                            /* see maximum() above  */
+        return s < 0x7C00;                          /* see maximum() above  */
+    }
+
+    /**
+     *  The track numbers that midifile uses to mark the SeqSpec track, the
+     *  current one and the old one.  A pattern saved with one of these
+     *  numbers would be dropped when the song is read back, so no pattern
+     *  is given them.
+     */
+
+    static bool is_reserved (int s)
+    {
+        return s == 0x3FFF || s == 0x7777;
     }
 
     static int unassigned ()
@@ -1061,6 +1156,13 @@ public:
     }
 
     const timesig & get_time_signature (size_t index) const;
+
+    const metermap & meter_map () const
+    {
+        return m_meter_map;
+    }
+
+    bool fill_meter_map (metermap & mm) const;
     bool current_time_signature (midipulse p, int & beats, int & beatwidth) const;
     int measure_number (midipulse p) const;
     midipulse time_signature_pulses (const std::string & s) const;
@@ -1099,7 +1201,7 @@ public:
     void seq_number (int seqno)
     {
         if (seqno >= 0 && seqno <= limit())
-            m_seq_number = short(seqno);
+            m_seq_number = seqno;
     }
 
     int color () const
@@ -1131,6 +1233,11 @@ public:
     }
 
     bool loop_count_max (int m, bool user_change = false);
+    bool cc_reduction
+    (
+        ccreducer::method m, int value, midipulse pulses,
+        bool user_change = false
+    );
     void modify (bool notifychange = true);
 
     void unmodify ()
@@ -1372,7 +1479,10 @@ public:
 
     bool sequence_playing_toggle ();
     bool toggle_playing ();
-    bool toggle_playing (midipulse tick, bool resumenoteons);
+    bool toggle_playing
+    (
+        midipulse tick, bool resumenoteons, bool resumecontrols = false
+    );
     bool toggle_queued ();
 
     bool get_queued () const
@@ -1524,6 +1634,11 @@ public:
         return m_loop_count_max;
     }
 
+    const ccreducer & cc_reducer () const
+    {
+        return m_cc_reducer;
+    }
+
     bool song_recording () const
     {
         return m_song_recording;
@@ -1555,6 +1670,18 @@ public:
     }
 
     void resume_note_ons (midipulse tick);
+    void chase (midipulse tick, bool notes, bool controls);
+
+    /**
+     *  Directs the events of the next play() to a playpool buffer.  Pass a
+     *  null pointer to resume sending directly to the master buss.
+     */
+
+    void render_to (renderbuffer * rb)
+    {
+        m_render = rb;
+        m_render_order = 0;
+    }
     bool toggle_one_shot ();
 
     bool modified () const
@@ -1648,6 +1775,7 @@ public:
         midibyte d0, midibyte d1, bool repaint = false
     );
     bool append_event (const event & er);
+    void reserve_events (int count);
     void sort_events ();
     event find_event (const event & e, bool nextmatch = false);
     note_info find_note (midipulse tick, int note);
@@ -2000,7 +2128,7 @@ public:
 
 protected:
 
-    void set_parent (performer * p);
+    void set_parent (performer * p, bool presorted = false);
 
     void armed (bool flag)
     {
@@ -2033,6 +2161,12 @@ private:
     bool quantize_notes (int divide);
     bool change_ppqn (int p);
     void put_event_on_bus (const event & ev);
+    void put_event_on_bus (const event & ev, midipulse stamp);
+    void add_reduced_events (const std::vector<event> & evs);
+    void render_event
+    (
+        const event & ev, midipulse stamp, midibyte channel
+    );
     void reset_loop ();
     void set_trigger_offset (midipulse trigger_offset);
     void adjust_trigger_offsets_to_length (midipulse newlen);
@@ -2052,6 +2186,8 @@ private:
 
     bool remove_first_match (const event & e, midipulse starttick = 0);
     void remove_all ();
+    memory memory_use () const;
+    void compact (bool force = false);
 
     /**
      *  Checks to see if the event's channel matches the sequence's nominal
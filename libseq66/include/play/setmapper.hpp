@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2023-11-14
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module also creates a small structure for managing sequence
@@ -42,6 +42,8 @@
  *  allowed in a given run of the application.
  */
 
+#include <memory>                       /* std::shared_ptr<>                */
+
 #include "play/mutegroups.hpp"          /* seq66::mutegroups & mutegroup    */
 #include "play/setmaster.hpp"           /* seq66::seqmanager and seqstatus  */
 
@@ -68,10 +70,11 @@ private:
      *  Provides a reference to an external mute group container.  It can be
      *  used to mute and unmute all of the patterns in a set at once.  It can
      *  also be modified to change the pattern when the application is in
-     *  Learn mode.
+     *  Learn mode.  The performer replaces it atomically when a 'mutes' file
+     *  is loaded while running, so this is a reference to its pointer.
      */
 
-    mutegroups & m_mute_groups;
+    std::shared_ptr<mutegroups> & m_mute_groups;
 
     /**
      *  The number of loops/patterns in the set.  Saves a calculation of row x
@@ -101,10 +104,10 @@ private:
     int m_sequence_count;
 
     /**
-     *  A replacement for the c_max_sequence constant.  However, this value is
-     *  already 32 * 32 = 1024, and is probably enough for any usage.  Famous
-     *  last words?  Actually, this value could go up to 2047... 2048 is used
-     *  to indicate that there is no background sequence.  See seq::limit().
+     *  A replacement for the c_max_sequence constant.  It is now
+     *  seq::maximum(), 31744, well below seq::limit(), which is used to
+     *  indicate that there is no background sequence.  Only the sets in use
+     *  hold slots, so a high value costs nothing by itself.
      */
 
     seq::number m_sequence_max;
@@ -180,7 +183,7 @@ public:
     setmapper
     (
         setmaster & mc,
-        mutegroups & mgs,
+        std::shared_ptr<mutegroups> & mgs,
         int rows        = screenset::c_default_rows,
         int columns     = screenset::c_default_columns
     );
@@ -783,7 +786,7 @@ public:
     /**
      *  The screen() functions look for the screen-set that contains the
      *  specified (by number) sequence.  If not found, then the dummy
-     *  screen-set is returned.
+     *  screen-set is returned; a lookup never creates a screen-set.
      *
      *  The play_screen() functions return the screen that is showing in the
      *  main Live grid.
@@ -861,14 +864,13 @@ public:
         return master().is_screenset_active(setno);
     }
 
+    /**
+     *  Screensets are created when first used, so a set that exists but
+     *  has no patterns is not considered available.
+     */
+
     bool is_screenset_available (screenset::number setno) const
     {
-        /*
-         * Now all 32 slots have a screenset, but inactive vs. active.
-         *
-         * return master().is_screenset_available(setno);
-         */
-
          return master().is_screenset_active(setno);
     }
 
@@ -940,6 +942,7 @@ private:
     bool add_to_play_set (playset & p, screenset & s);
     bool add_all_sets_to_play_set (playset & p);
     void recount_sequences ();
+    screenset & make_screen (seq::number seqno);
 
     setmaster::container::iterator add_set (screenset::number setno)
     {
@@ -988,12 +991,12 @@ private:
 
     mutegroups & mutes ()
     {
-        return m_mute_groups;
+        return *std::atomic_load(&m_mute_groups);
     }
 
     const mutegroups & mutes () const
     {
-        return m_mute_groups;
+        return *std::atomic_load(&m_mute_groups);
     }
 
     setmaster & master ()
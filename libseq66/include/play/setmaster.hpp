@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-08-10
- * \updates       2021-11-13
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The setmaster class is meant to encapsulate the sets and their layout,
@@ -110,7 +110,9 @@ private:
     /**
      *  The maximum number of sets supported.  The main purpose for this value
      *  is as a sanity check for set lookup, not necessarily for limiting the
-     *  number of sets.
+     *  number of sets.  It is seq::maximum() divided by the set size, not the
+     *  size of the set grid, because sets are created only when used.  The
+     *  grid and the set keys still reach only the first Size() sets.
      */
 
     int m_set_count;
@@ -242,6 +244,7 @@ private:
     void clear ()
     {
         m_container.clear();                    /* unconditional zappage!   */
+        m_highest_set = -1;
     }
 
     int rows () const
@@ -291,6 +294,7 @@ private:
 
     screenset & screen (screenset::number setno);
     const screenset & screen (screenset::number setno) const;
+    screenset & make_screen (screenset::number setno);
 
     screenset & dummy_screenset ()
     {
@@ -0,0 +1,234 @@
+#if ! defined SEQ66_SHAREDSTATUS_HPP
+#define SEQ66_SHAREDSTATUS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sharedstatus.hpp
+ *
+ *  This module declares a shared-memory segment that publishes the state of
+ *  the performer for external monitors.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  When the 'rc' option "status-shm" names a POSIX shared-memory object
+ *  (e.g. "/seq66-status"), the performer creates it and keeps a
+ *  status_surface structure in it up to date: the tick, tempo, playing set,
+ *  mute group, underrun information, and the state of each pattern slot in
+ *  the play-set (the playing screen-set, or all sets in "all-sets" mode).
+ *  Slots of patterns outside the play-set read as 0.
+ *  A dashboard, stage display, or watchdog can map the object read-only and
+ *  poll it at any rate, without any cost to the sequencer.
+ *
+ *  The surface is written by the output thread while playing, and by the
+ *  input thread while stopped, at most every c_status_period_us.  It is
+ *  protected by a sequence lock.  A reader must do the following:
+ *
+ *      -#  Check that magic is c_status_magic, that version is one it
+ *          knows, and that size is at least the size it expects.
+ *      -#  Load seqlock (with acquire ordering).  If it is odd, a write is
+ *          in progress; try again.
+ *      -#  Copy the fields it needs.
+ *      -#  Issue an acquire fence and load seqlock again.  If it changed,
+ *          discard the copy and try again.
+ *
+ *  New fields are only ever added at the end, with a new version number.
+ *  Not available on Windows.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <cstdint>                      /* std::uint32_t, etc.              */
+#include <mutex>                        /* std::mutex                       */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class performer;
+
+/**
+ *  The identification of a status surface, "S66S".
+ */
+
+const std::uint32_t c_status_magic = 0x53363653;
+
+/**
+ *  The current layout version.
+ */
+
+const std::uint32_t c_status_version = 1;
+
+/**
+ *  The number of pattern slots described.  Slots past this are not shown.
+ */
+
+const int c_status_slots = 2048;
+
+/**
+ *  Bits of status_surface::flags.
+ */
+
+enum status_flags : std::uint32_t
+{
+    status_running      = 0x01,         /**< Playback is in progress.       */
+    status_song_mode    = 0x02,         /**< Song (not live) mode.          */
+    status_looping      = 0x04,         /**< Looping between L and R.       */
+    status_song_record  = 0x08,         /**< Song recording is on.          */
+    status_jack         = 0x10          /**< JACK transport is running.     */
+};
+
+/**
+ *  Bits of the status_surface::slots[] bytes.
+ */
+
+enum status_slot_bits : std::uint8_t
+{
+    slot_present        = 0x01,         /**< A pattern is in the slot.      */
+    slot_armed          = 0x02,         /**< The pattern is unmuted.        */
+    slot_queued         = 0x04,         /**< A mute toggle is queued.       */
+    slot_one_shot       = 0x08,         /**< A one-shot is pending.         */
+    slot_recording      = 0x10          /**< The pattern is recording.      */
+};
+
+/**
+ *  The layout of the shared-memory segment.  Only fixed-size types are
+ *  used, so that a program in any language can read it.
+ */
+
+struct status_surface
+{
+    std::uint32_t magic;                /**< Always c_status_magic.         */
+    std::uint32_t version;              /**< The layout version.            */
+    std::uint32_t size;                 /**< sizeof(status_surface).        */
+    std::uint32_t slot_count;           /**< Always c_status_slots.         */
+    std::atomic<std::uint32_t> seqlock; /**< Odd while being written.       */
+    std::uint32_t flags;                /**< A set of status_flags bits.    */
+    std::int32_t pid;                   /**< The process ID of Seq66.       */
+    std::int32_t ppqn;                  /**< Pulses per quarter note.       */
+    std::int64_t update_count;          /**< Number of updates made.        */
+    std::int64_t update_us;             /**< microtime() of the update.     */
+    std::int64_t tick;                  /**< The current pulse.             */
+    double bpm;                         /**< Beats per minute.              */
+    std::int32_t beats_per_bar;         /**< Time-signature numerator.      */
+    std::int32_t beat_width;            /**< Time-signature denominator.    */
+    std::int32_t playscreen;            /**< The playing set.               */
+    std::int32_t mute_group;            /**< Selected mute-group, or -1.    */
+    std::int32_t sequence_high;         /**< One past the highest pattern.  */
+    std::int32_t last_underrun_us;      /**< Lateness of the last underrun. */
+    std::int64_t underrun_count;        /**< Output cycles that ran late.   */
+    std::uint8_t slots[c_status_slots]; /**< status_slot_bits per slot.     */
+};
+
+/**
+ *  Creates, updates, and removes the shared-memory status surface.
+ */
+
+class sharedstatus
+{
+
+private:
+
+    /**
+     *  The name of the shared-memory object, including the leading slash.
+     */
+
+    std::string m_name;
+
+    /**
+     *  The file descriptor of the shared-memory object, or -1.
+     */
+
+    int m_fd;
+
+    /**
+     *  The mapped surface, or null if not open.
+     */
+
+    status_surface * m_surface;
+
+    /**
+     *  Keeps the output and input threads from writing at the same time.
+     *  A thread that cannot get it simply skips its update.
+     */
+
+    std::mutex m_write_mutex;
+
+    /**
+     *  The time of the last update, to limit the update rate.
+     */
+
+    long m_last_update_us;
+
+    /**
+     *  Underrun information, noted by the output thread.
+     */
+
+    std::atomic<long> m_underrun_count;
+    std::atomic<long> m_last_underrun_us;
+
+    /**
+     *  The slots set by the last update, so that only they need clearing.
+     *  Reserved for c_status_slots, so that publish() does not allocate.
+     */
+
+    std::vector<int> m_lit_slots;
+
+public:
+
+    sharedstatus ();
+    sharedstatus (const sharedstatus &) = delete;
+    sharedstatus & operator = (const sharedstatus &) = delete;
+    ~sharedstatus ();
+
+    bool open (const std::string & name);
+    void close ();
+    void publish (performer & p, bool force = false);
+    void note_underrun (long late_us);
+
+    bool active () const
+    {
+        return m_surface != nullptr;
+    }
+
+    const std::string & name () const
+    {
+        return m_name;
+    }
+
+};          // class sharedstatus
+
+}           // namespace seq66
+
+#endif      // SEQ66_SHAREDSTATUS_HPP
+
+/*
+ * sharedstatus.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
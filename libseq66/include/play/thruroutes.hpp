@@ -0,0 +1,192 @@
+#if ! defined SEQ66_THRUROUTES_HPP
+#define SEQ66_THRUROUTES_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          thruroutes.hpp
+ *
+ *  This module declares a precompiled table of MIDI Thru routes.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  MIDI Thru used to be done at the end of sequence::stream_event(), after
+ *  the recording work, and under the lock of the pattern, which the output
+ *  thread also holds while playing the pattern.  So a busy pattern could
+ *  delay the echo of a key by a good part of an output cycle.
+ *
+ *  Now the input thread looks up each incoming event in a small table of
+ *  routes and sends the echo first, without touching any pattern.  The
+ *  table is rebuilt (by the input thread) only after something that
+ *  affects it changes:  the Thru or recording status, buss, or channel of a
+ *  pattern, the recording mode, or the note-mapper.  Each route holds the
+ *  output buss and channel and a note table, which is the note-map if the
+ *  pattern records with note-mapping, and the identity otherwise.
+ *
+ *  The routes follow the same order and matching rules as the recording
+ *  lookup (by buss, by channel, or the single input pattern), so that the
+ *  echo goes where it went before.  Note Offs follow their Note Ons, even
+ *  if the routes change while a key is held.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/midibytes.hpp"           /* seq66::bussbyte, midibyte, etc.  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+class event;
+class mastermidibase;
+class notemapper;
+class sequence;
+
+/**
+ *  Holds the Thru routes used by the input thread.
+ */
+
+class thruroutes
+{
+
+public:
+
+    /**
+     *  One route.  An event matches it if the input buss and channel match.
+     *  If the route sends, the event is echoed to the output buss; if the
+     *  route stops, no further routes are checked.
+     */
+
+    struct route
+    {
+        bussbyte in_buss;                   /**< Null buss matches any.     */
+        midibyte in_channel;                /**< Null channel matches any.  */
+        bool send;                          /**< Echo the event.            */
+        bool stop;                          /**< Last route checked.        */
+        bussbyte out_buss;                  /**< The true output buss.      */
+        midibyte out_channel;               /**< Null keeps the channel.    */
+        midibyte notes[c_notes_count];      /**< Note-map or identity.      */
+    };
+
+private:
+
+    /**
+     *  Where a Note On was sent, so that its Note Off goes to the same place.
+     */
+
+    struct held
+    {
+        bussbyte in_buss;
+        midibyte in_channel;
+        midibyte in_note;
+        bussbyte out_buss;
+        midibyte out_channel;
+        midibyte out_note;
+    };
+
+    /**
+     *  Set by any thread when the routes need to be rebuilt.
+     */
+
+    std::atomic<bool> m_dirty;
+
+    /**
+     *  The routes, in the order checked.  Used only by the input thread.
+     */
+
+    std::vector<route> m_routes;
+
+    /**
+     *  The notes now sounding through a route.  Used only by the input
+     *  thread.
+     */
+
+    std::vector<held> m_held;
+
+public:
+
+    thruroutes ();
+    thruroutes (const thruroutes &) = delete;
+    thruroutes & operator = (const thruroutes &) = delete;
+    ~thruroutes () = default;
+
+    void invalidate ()
+    {
+        m_dirty = true;
+    }
+
+    /**
+     *  Returns true if the routes need to be rebuilt, and clears the flag.
+     *  Clearing it first means that a change made during the rebuild is not
+     *  lost.
+     */
+
+    bool take_dirty ()
+    {
+        return m_dirty.exchange(false);
+    }
+
+    bool empty () const
+    {
+        return m_routes.empty();
+    }
+
+    void clear ()
+    {
+        m_routes.clear();
+    }
+
+    void add
+    (
+        const sequence & s,
+        const notemapper * nm,
+        bussbyte inbuss,
+        bool claim
+    );
+    bool route_event (const event & ev, mastermidibase & mmb, midipulse tick);
+    void release (mastermidibase & mmb, midipulse tick);
+
+private:
+
+    void send
+    (
+        mastermidibase & mmb, const event & ev, midipulse tick,
+        bussbyte buss, midibyte channel, midibyte note
+    );
+
+};          // class thruroutes
+
+}           // namespace seq66
+
+#endif      // SEQ66_THRUROUTES_HPP
+
+/*
+ * thruroutes.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
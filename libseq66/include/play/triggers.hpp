@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2023-12-20
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  By segregating trigger support into its own module, the sequence class is
@@ -352,10 +352,21 @@ private:
 
     /**
      *  Provides a stack for use with the undo/redo features of the
-     *  trigger support.
+     *  trigger support.  The stacked lists are exposed (read-only) for
+     *  memory_size().
      */
 
-    using stack = std::stack<container>;
+    class stack : public std::stack<container>
+    {
+
+    public:
+
+        const container_type & items () const
+        {
+            return c;
+        }
+
+    };
 
 private:
 
@@ -432,6 +443,15 @@ private:
 
     int m_length;
 
+    /**
+     *  The index of the trigger being grown by song recording, or -1.  It
+     *  lets each output cycle extend that trigger in place, instead of
+     *  searching for it and re-adding it.  It is checked before each use,
+     *  because the triggers can be edited while recording.
+     */
+
+    int m_record_index;
+
 public:
 
     triggers (sequence & parent);
@@ -508,6 +528,8 @@ public:
     void adjust_offsets_to_length (midipulse newlen);
     bool split (midipulse tick, trigger::splitpoint splittype);
     bool grow_trigger (midipulse tickfrom, midipulse tickto, midipulse length);
+    bool grow_recording (midipulse tickfrom, midipulse tickto, midipulse len);
+    bool finish_recording (midipulse tickfrom, midipulse tickto, midipulse len);
     const trigger & find_trigger (midipulse tick) const;
     const trigger & find_trigger_by_index (int index) const;
     bool remove (midipulse tick);
@@ -563,6 +585,9 @@ public:
         m_draw_iterator = m_triggers.begin();
     }
 
+    std::size_t memory_size () const;
+    void compact ();
+
     void set_trigger_paste_tick (midipulse tick)
     {
         m_paste_tick = tick;
@@ -576,6 +601,7 @@ public:
 private:
 
     void sort ();
+    int index_of (midipulse tick) const;
     bool split (trigger & t, midipulse splittick);
     bool rescale (int oldppqn, int newppqn);
     midipulse adjust_offset (midipulse offset);
@@ -28,7 +28,7 @@
  * \library       clinsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-08-31
- * \updates       2023-03-28
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Provides a base class that can be used to manage the command-line version
@@ -153,6 +153,8 @@ private:
         const std::string & midifilepath
     );
     bool detect_session (std::string & url);
+    void show_memory_report ();
+    void show_bandwidth_report ();
 
 };          // class clinsmanager
 
@@ -0,0 +1,162 @@
+#if ! defined SEQ66_MIDISAVER_HPP
+#define SEQ66_MIDISAVER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midisaver.hpp
+ *
+ *  This module declares a thread that writes saved MIDI files to the disk.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  When the 'rc' option "background-save" is on, smanager::save_session()
+ *  does not write the MIDI file itself.  It calls midifile::snapshot(),
+ *  which copies the active patterns (their event lists share the SysEx
+ *  data) and encodes the small SeqSpec track, and the performer is marked as
+ *  saved.  The midifile is then handed to this class, whose thread encodes
+ *  the copies with midifile::encode_snapshot(), writes the bytes to a
+ *  temporary file, flushes it to the disk, and renames it over the MIDI
+ *  file.  The caller (the GUI, the NSM handler, or the command-line loop)
+ *  neither encodes the song nor waits on the disk.
+ *
+ *  The thread never touches the performer, so there is no race with edits
+ *  or file loads.  If several saves of the same file are requested while a
+ *  write is in progress, only the latest snapshot is written.  Saves of other
+ *  files are queued, and written in the order requested.  If a write fails, failed()
+ *  reports it, and the session manager marks the song as modified again.
+ *
+ *  The 'rc' option "autosave-interval" uses the same path; see
+ *  smanager::autosave().
+ */
+
+#include <condition_variable>           /* std::condition_variable          */
+#include <deque>                        /* std::deque<>                     */
+#include <memory>                       /* std::unique_ptr<>                */
+#include <mutex>                        /* std::mutex, std::unique_lock     */
+#include <string>                       /* std::string                      */
+#include <thread>                       /* std::thread                      */
+#include <utility>                      /* std::pair<>                      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+    class midifile;
+
+/**
+ *  The MIDI-file writer thread.
+ */
+
+class midisaver
+{
+
+private:
+
+    /**
+     *  The writer thread.
+     */
+
+    std::thread m_thread;
+
+    /**
+     *  Protects all of the members below, and signals requests and
+     *  completions.
+     */
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    /**
+     *  A request: the full path to the MIDI file and the midifile holding
+     *  the snapshot of the song.
+     */
+
+    using request_t = std::pair<std::string, std::unique_ptr<midifile>>;
+
+    /**
+     *  The requests not yet taken by the thread, at most one per file, in
+     *  the order they were first made.
+     */
+
+    std::deque<request_t> m_requests;
+
+    /**
+     *  True while the thread is writing a file.
+     */
+
+    bool m_busy;
+
+    /**
+     *  Holds the error of the last failed write, until failed() is called.
+     */
+
+    std::string m_error_message;
+    bool m_failed;
+
+    /**
+     *  Raised to make the thread exit, once the pending request is written.
+     */
+
+    bool m_exit;
+
+public:
+
+    midisaver ();
+    midisaver (const midisaver &) = delete;
+    midisaver & operator = (const midisaver &) = delete;
+    ~midisaver ();
+
+    bool start ();
+    void stop ();
+    bool request
+    (
+        const std::string & filename,
+        std::unique_ptr<midifile> & snap
+    );
+    void wait ();
+    bool failed (std::string & errmsg);
+
+    bool active () const
+    {
+        return m_thread.joinable();
+    }
+
+private:
+
+    void save_func ();
+
+};          // class midisaver
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDISAVER_HPP
+
+/*
+ * midisaver.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
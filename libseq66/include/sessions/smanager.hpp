@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-05-30
- * \updates       2023-11-04
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This class provides a process for starting, running, restarting, and
@@ -40,6 +40,7 @@
 #include <memory>                       /* std::shared_ptr<>, unique_ptr<>  */
 
 #include "play/performer.hpp"           /* seq66::performer                 */
+#include "sessions/midisaver.hpp"       /* seq66::midisaver                 */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -74,6 +75,20 @@ private:
 
     pointer m_perf_pointer;
 
+    /**
+     *  Writes MIDI files in the background, if the 'rc' options
+     *  "background-save" or "autosave-interval" are in force.  See
+     *  save_midi_file() and autosave().
+     */
+
+    std::unique_ptr<midisaver> m_midi_saver;
+
+    /**
+     *  The millitime() of the last save of the MIDI file, for autosave().
+     */
+
+    long m_last_save_ms;
+
     /**
      *  Holds the capabilities string (if applicable) for the application
      *  using this session manager.
@@ -147,6 +162,7 @@ public:
     bool open_note_mapper ();
     bool create_performer ();
     std::string open_midi_file (const std::string & fname);
+    bool autosave ();
 
     bool error_active () const
     {
@@ -180,6 +196,12 @@ public:
 
     bool internal_error_check (std::string & msg) const;
     void error_handling ();
+    bool save_midi_file
+    (
+        const std::string & filename,
+        std::string & msg,
+        bool background
+    );
 
     bool internal_error_pending () const
     {
@@ -27,7 +27,7 @@
  *
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2023-11-30
+ * \updates       2026-10-17
  * \version       $Revision$
  *
  *    Also see the filefunctions.cpp module.  The functions here use
@@ -35,6 +35,7 @@
  */
 
 #include <cstdio>                       /* std::FILE *                      */
+#include <ctime>                        /* std::time_t                      */
 #include <string>                       /* std::string ubiquitous class     */
 
 #include "util/basic_macros.hpp"        /* seq6::tokenization vector        */
@@ -60,6 +61,7 @@ extern bool file_is_directory (const std::string & targetfile);
 extern bool file_name_good (const std::string & filename);
 extern bool file_mode_good (const std::string & mode);
 extern size_t file_size (const std::string & filename);
+extern std::time_t file_modification_time (const std::string & filename);
 extern std::FILE * file_open
 (
     const std::string & filename,
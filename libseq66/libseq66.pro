@@ -60,6 +60,7 @@ HEADERS += include/seq66_features.h \
  include/cfg/scales.hpp \
  include/cfg/sessionfile.hpp \
  include/cfg/settings.hpp \
+ include/cfg/songcachefile.hpp \
  include/cfg/userinstrument.hpp \
  include/cfg/usermidibus.hpp \
  include/cfg/usrfile.hpp \
@@ -81,6 +82,8 @@ HEADERS += include/seq66_features.h \
  include/ctrl/opcontrol.hpp \
  include/midi/businfo.hpp \
  include/midi/calculations.hpp \
+ include/midi/ccreducer.hpp \
+ include/midi/chaseindex.hpp \
  include/midi/controllers.hpp \
  include/midi/editable_event.hpp \
  include/midi/editable_events.hpp \
@@ -88,12 +91,18 @@ HEADERS += include/seq66_features.h \
  include/midi/eventlist.hpp \
  include/midi/jack_assistant.hpp \
  include/midi/mastermidibase.hpp \
+ include/midi/metermap.hpp \
  include/midi/midibase.hpp \
  include/midi/midibytes.hpp \
  include/midi/midifile.hpp \
  include/midi/midi_splitter.hpp \
  include/midi/midi_vector_base.hpp \
  include/midi/midi_vector.hpp \
+ include/midi/portshaper.hpp \
+ include/midi/renderahead.hpp \
+ include/midi/sharedbytes.hpp \
+ include/midi/songinfo.hpp \
+ include/midi/songsnapshot.hpp \
  include/midi/wrkfile.hpp \
  include/play/clockslist.hpp \
  include/play/inputslist.hpp \
@@ -103,15 +112,21 @@ HEADERS += include/seq66_features.h \
  include/play/notemapper.hpp \
  include/play/performer.hpp \
  include/play/playlist.hpp \
+ include/play/playpool.hpp \
  include/play/portslist.hpp \
  include/play/screenset.hpp \
  include/play/seq.hpp \
  include/play/sequence.hpp \
  include/play/setmapper.hpp \
  include/play/setmaster.hpp \
+ include/play/sharedstatus.hpp \
+ include/play/hotswap.hpp \
+ include/play/thruroutes.hpp \
+ include/play/recordroutes.hpp \
  include/play/songsummary.hpp \
  include/play/triggers.hpp \
  include/sessions/clinsmanager.hpp \
+ include/sessions/midisaver.hpp \
  include/sessions/smanager.hpp \
  include/os/daemonize.hpp \
  include/os/shellexecute.hpp \
@@ -143,6 +158,7 @@ SOURCES += src/seq66_features.cpp \
  src/cfg/scales.cpp \
  src/cfg/sessionfile.cpp \
  src/cfg/settings.cpp \
+ src/cfg/songcachefile.cpp \
  src/cfg/userinstrument.cpp \
  src/cfg/usermidibus.cpp \
  src/cfg/usrfile.cpp \
@@ -164,6 +180,8 @@ SOURCES += src/seq66_features.cpp \
  src/ctrl/opcontrol.cpp \
  src/midi/businfo.cpp \
  src/midi/calculations.cpp \
+ src/midi/ccreducer.cpp \
+ src/midi/chaseindex.cpp \
  src/midi/controllers.cpp \
  src/midi/editable_event.cpp \
  src/midi/editable_events.cpp \
@@ -171,12 +189,18 @@ SOURCES += src/seq66_features.cpp \
  src/midi/eventlist.cpp \
  src/midi/jack_assistant.cpp \
  src/midi/mastermidibase.cpp \
+ src/midi/metermap.cpp \
  src/midi/midibase.cpp \
  src/midi/midibytes.cpp \
  src/midi/midifile.cpp \
  src/midi/midi_splitter.cpp \
  src/midi/midi_vector_base.cpp \
  src/midi/midi_vector.cpp \
+ src/midi/portshaper.cpp \
+ src/midi/renderahead.cpp \
+ src/midi/sharedbytes.cpp \
+ src/midi/songinfo.cpp \
+ src/midi/songsnapshot.cpp \
  src/midi/wrkfile.cpp \
  src/play/clockslist.cpp \
  src/play/inputslist.cpp \
@@ -186,15 +210,21 @@ SOURCES += src/seq66_features.cpp \
  src/play/notemapper.cpp \
  src/play/performer.cpp \
  src/play/playlist.cpp \
+ src/play/playpool.cpp \
  src/play/portslist.cpp \
  src/play/screenset.cpp \
  src/play/seq.cpp \
  src/play/sequence.cpp \
  src/play/setmapper.cpp \
  src/play/setmaster.cpp \
+ src/play/sharedstatus.cpp \
+ src/play/hotswap.cpp \
+ src/play/thruroutes.cpp \
+ src/play/recordroutes.cpp \
  src/play/songsummary.cpp \
  src/play/triggers.cpp \
  src/sessions/clinsmanager.cpp \
+ src/sessions/midisaver.cpp \
  src/sessions/smanager.cpp \
  src/os/daemonize.cpp \
  src/os/shellexecute.cpp \
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2024-08-08
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The "rc" command-line options override setting that are first read from
@@ -360,6 +360,8 @@ static const std::string s_help_4b =
 "      no-daemonize  Or not. These options do not apply to Windows. If given,\n"
 "                    the application writes these options to the 'usr' file\n"
 "                    and exits. Subsequent runs are thus affected. Tricky!\n"
+"      memory=n      Show the memory used by the n largest patterns (30 if\n"
+"                    '=n' is omitted) after loading and before exiting.\n"
 "\n"
 "Add '--user-save' to make these options permanent.\n"
 "\n"
@@ -588,6 +590,11 @@ cmdlineopts::parse_o_options (int argc, char * argv [])
                                 result = true;
                                 usr().option_use_logfile(true);
                             }
+                            else if (arg == "memory")
+                            {
+                                result = true;
+                                usr().option_memory_report(30);
+                            }
                         }
                         else
                         {
@@ -620,6 +627,13 @@ cmdlineopts::parse_o_options (int argc, char * argv [])
                             {
                                 result = parse_o_virtual(arg);
                             }
+                            else if (optionname == "memory")
+                            {
+                                int count = string_to_int(arg);
+                                result = count > 0;
+                                if (result)
+                                    usr().option_memory_report(count);
+                            }
                         }
                         if (! result)
                         {
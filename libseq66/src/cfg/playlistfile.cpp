@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-09-19
- * \updates       2023-12-05
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Here is a skeletal representation of a Seq66 playlist file:
@@ -133,8 +133,9 @@ playlistfile::set_error_message (const std::string & additional)
  *
  * \param verify_it
  *      If true (the default), call verify() to make sure the playlist is
- *      sane.  The verification is weak, rather than the strong option which
- *      is available.
+ *      sane.  The verification is strong only if the 'deep-verify' option is
+ *      set; it scans the songs without loading them, and caches the
+ *      results.
  *
  * \return
  *      Returns true if the file was parseable and verifiable.  The caller
@@ -156,7 +157,7 @@ playlistfile::open (bool verify_it)
                     msglevel::status, "Verifying playlist %s", name().c_str()
                 );
             }
-            result = play_list().verify();                  /* weak verify  */
+            result = play_list().verify(play_list().deep_verify());
         }
     }
     play_list().loaded(result);
@@ -496,8 +497,9 @@ playlistfile::write ()
 "# automatically when loaded. 'auto-advance' implies the settings noted\n"
 "# above. It automatically loads the next song in the play-list when the\n"
 "# current song ends. 'deep-verify' causes each tune in the play-list to be\n"
-"# loaded to make sure each one can be loaded. Otherwise, only file existence\n"
-"# is checked.\n\n"
+"# scanned to make sure each one can be loaded; the results are cached in a\n"
+"# '.songcache' file next to this one. Otherwise, only file existence is\n"
+"# checked.\n\n"
         ;
 
     write_boolean(file, "unmute-next-song", play_list().auto_arm());
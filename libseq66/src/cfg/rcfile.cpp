@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2024-06-06
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The <code> ~/.config/seq66.rc </code> configuration file is fairly simple
@@ -130,6 +130,11 @@ rcfile::rcfile (const std::string & name, rcsettings & rcs) :
  *      Generally, these busses are shown to the user with names such as "[1]
  *      seq66 1".
  *
+ *  [midi-bandwidth]
+ *
+ *      Optional.  The bytes-per-second limit and the thinning and
+ *      running-status options of slow output busses.  See portshaper.hpp.
+ *
  *  [jack-transport]
  *
  *      This section covers various JACK settings, one setting per line.
@@ -223,6 +228,27 @@ rcfile::parse ()
         rc().thread_priority(priority);
     }
 
+    int workers = get_integer(file, tag, "play-workers");
+    rc_ref().play_workers(workers);
+
+    int latency = get_integer(file, tag, "portmidi-latency");
+    rc_ref().portmidi_latency(latency);
+
+    int ahead = get_integer(file, tag, "render-ahead");
+    rc_ref().render_ahead(ahead);
+
+    s = get_variable(file, tag, "status-shm");
+    rc_ref().status_shm(s);
+
+    bool snap = get_boolean(file, tag, "song-snapshot");
+    rc_ref().song_snapshot(snap);
+
+    bool bgsave = get_boolean(file, tag, "background-save");
+    rc_ref().background_save(bgsave);
+
+    int autosave = get_integer(file, tag, "autosave-interval");
+    rc_ref().autosave_interval(autosave);
+
     /*
      * [comments] Header comments (hash-tag lead) are skipped during parsing.
      * However, we now try to read an optional comment block.
@@ -475,6 +501,26 @@ rcfile::parse ()
     rc().portmaps_present(portmaps_present);
     rc().portmaps_active(inportmap_active && outportmap_active);
 
+    /*
+     *  Check for the optional bandwidth limits of slow output ports.
+     */
+
+    tag = "[midi-bandwidth]";
+    rc_ref().bandwidths().clear();
+    if (line_after(file, tag))
+    {
+        int shaped = 0;
+        int count = std::sscanf(scanline(), "%d", &shaped);
+        if (count > 0 && shaped > 0)
+        {
+            while (next_data_line(file))
+            {
+                if (! rc_ref().bandwidths().add_list_line(line()))
+                    return make_error_message(tag, "bandwidth line error");
+            }
+        }
+    }
+
     /*
      * Moved from original location above so that we have the port-mapping
      * in place for use here.
@@ -770,6 +816,37 @@ rcfile::write ()
 "#\n"
 "# 'priority' greater than 0 is meant to increase the priority of the I/O\n"
 "# threads. It needs Seq66 to run as root, or be installed as setuid 0.\n"
+"#\n"
+"# 'play-workers' greater than 0 evaluates the patterns of a large play-set\n"
+"# on that many worker threads, merging their output in a fixed order.\n"
+"# 0 (the default) plays all patterns on the output thread.\n"
+"#\n"
+"# 'portmidi-latency' applies only to the PortMidi build. Greater than 0, it\n"
+"# is the output latency in milliseconds; events are time-stamped from the\n"
+"# pulse clock and written in batches, to be scheduled by the MIDI driver.\n"
+"# 0 (the default) writes each event immediately.\n"
+"#\n"
+"# 'render-ahead' greater than 0 renders that many milliseconds (at most\n"
+"# 500) of output ahead of time, and sends each event at its exact time from\n"
+"# a separate thread. Mutes, queuing, edits, and tempo changes still take\n"
+"# effect within one output cycle. Not used with JACK transport or MIDI\n"
+"# clock input. 0 (the default) plays the patterns just in time.\n"
+"#\n"
+"# 'status-shm', if not empty, names a POSIX shared-memory object, such as\n"
+"# \"/seq66-status\", in which Seq66 publishes the tick, tempo, playing set,\n"
+"# mute-group, underruns, and pattern states for external monitors. See\n"
+"# play/sharedstatus.hpp for the layout. Not supported on Windows.\n"
+"#\n"
+"# 'song-snapshot' true makes Seq66 save a binary snapshot (extension\n"
+"# '.snap') next to each MIDI file it loads, holding the sorted and linked\n"
+"# patterns. The next load of the unchanged file reads the snapshot instead\n"
+"# of parsing all of the tracks. A changed MIDI file is parsed as usual.\n"
+"#\n"
+"# 'background-save' true makes a session save (including an NSM save)\n"
+"# write the MIDI file on a separate thread, so the caller does not wait.\n"
+"# 'autosave-interval' greater than 0 also saves a modified MIDI file every\n"
+"# that many seconds, on the same thread. Both write to a temporary file\n"
+"# that is then renamed over the MIDI file.\n"
         ;
 
     write_seq66_header(file, "rc", version());
@@ -779,6 +856,13 @@ rcfile::write ()
     write_string(file, "port-naming", rc_ref().port_naming_string());
     write_boolean(file, "init-disabled-ports", rc_ref().init_disabled_ports());
     write_integer(file, "priority", rc_ref().thread_priority());
+    write_integer(file, "play-workers", rc_ref().play_workers());
+    write_integer(file, "portmidi-latency", rc_ref().portmidi_latency());
+    write_integer(file, "render-ahead", rc_ref().render_ahead());
+    write_string(file, "status-shm", rc_ref().status_shm(), true);
+    write_boolean(file, "song-snapshot", rc_ref().song_snapshot());
+    write_boolean(file, "background-save", rc_ref().background_save());
+    write_integer(file, "autosave-interval", rc_ref().autosave_interval());
 
     /*
      * [comments]
@@ -1024,6 +1108,26 @@ rcfile::write ()
         ;
     }
 
+    /*
+     * Bandwidth limits of slow output ports.
+     */
+
+    const bandwidthlist & bwl = rc_ref().bandwidths();
+    file << "\n"
+"# Limits the output rate of slow (DIN or serial) MIDI ports. The first value\n"
+"# is the number of lines that follow. Each line gives the output bus, the\n"
+"# rate in bytes per second (3125 for DIN MIDI at 31.25 kbaud), 'thin' (1 to\n"
+"# drop controller values that are repeated or superseded while waiting),\n"
+"# and 'running-status' (1 to count repeated status bytes as free, as the\n"
+"# serial drivers do). When a port is busy, notes, program changes, and the\n"
+"# pedal/bank controllers are sent before the other controllers, pitch bend,\n"
+"# and aftertouch. seq66cli reports the load of each port at exit.\n"
+"\n[midi-bandwidth]\n\n"
+        << std::setw(2) << bwl.count()
+        << "      # number of shaped output buses\n\n"
+        << bwl.io_list_lines()
+        ;
+
     /*
      * MIDI clock modulo value, and filter by channel, new option as of
      * 2016-08-20.
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2023-12-10
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the legacy global variables, so that
@@ -62,6 +62,7 @@ rcsettings::rcsettings () :
     basesettings                (),
     m_clocks                    (),         /* vector wrapper class         */
     m_inputs                    (),         /* vector wrapper class         */
+    m_bandwidths                (),         /* no shaped output busses      */
     m_metro_settings            (),
     m_mute_group_save           (mutegroups::saving::midi),
     m_keycontainer              ("rc"),
@@ -83,6 +84,13 @@ rcsettings::rcsettings () :
     m_show_midi                 (false),
     m_priority                  (false),
     m_thread_priority           (0),        /* c_thread_priority            */
+    m_play_workers              (0),        /* serial pattern evaluation    */
+    m_portmidi_latency          (0),        /* immediate PortMidi output    */
+    m_render_ahead              (0),        /* just-in-time output          */
+    m_status_shm                (),         /* no status surface            */
+    m_song_snapshot             (false),    /* always parse the MIDI file   */
+    m_background_save           (false),    /* save on the calling thread   */
+    m_autosave_interval         (0),        /* no autosave                  */
     m_pass_sysex                (false),
     m_with_jack_transport       (false),
     m_with_jack_master          (false),
@@ -183,6 +191,7 @@ rcsettings::set_defaults ()
      */
 
     m_metro_settings.set_defaults();
+    m_bandwidths.clear();
     m_mute_group_save           = mutegroups::saving::midi;
     m_drop_empty_in_controls    = false;
     m_midi_control_buss         = null_buss();
@@ -199,6 +208,13 @@ rcsettings::set_defaults ()
     m_show_midi                 = false;
     m_priority                  = false;
     m_thread_priority           = 0;        /* c_thread_priority            */
+    m_play_workers              = 0;
+    m_portmidi_latency          = 0;
+    m_render_ahead              = 0;
+    m_status_shm.clear();
+    m_song_snapshot             = false;
+    m_background_save           = false;
+    m_autosave_interval         = 0;
     m_pass_sysex                = false;
     m_with_jack_transport       = false;
     m_with_jack_master          = false;
@@ -1402,6 +1418,17 @@ rcsettings::mute_group_filename (const std::string & value)
         mute_group_file_active(false);
 }
 
+/**
+ *  Sets the name of the shared-memory status object.  A missing value
+ *  ("?" or "") disables the status surface.
+ */
+
+void
+rcsettings::status_shm (const std::string & name)
+{
+    m_status_shm = is_missing_string(name) ? std::string("") : name ;
+}
+
 void
 rcsettings::notemap_filename (const std::string & value)
 {
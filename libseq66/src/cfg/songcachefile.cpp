@@ -0,0 +1,207 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songcachefile.cpp
+ *
+ *  This module defines the reading and writing of the song-summary cache.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Each song is one line in the [song-cache] section:
+ *
+ *      "path" size mtime hash format tracks ppqn length bpm "error"
+ *
+ *  The hash is written in hexadecimal.  The error is empty for a good song.
+ */
+
+#include <cstdio>                       /* std::sscanf()                    */
+#include <iomanip>                      /* std::hex, std::setprecision()    */
+
+#include "cfg/songcachefile.hpp"        /* seq66::songcachefile class       */
+#include "util/strfunctions.hpp"        /* seq66::add_quotes()              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+static const int s_song_cache_file_version = 0;
+
+/**
+ *  Principal constructor.
+ *
+ * Versions:
+ *
+ *      0:  The initial version.
+ *
+ * \param filename
+ *      The full path to the cache file.
+ *
+ * \param cache
+ *      The destination or source of the song summaries.
+ *
+ * \param rcs
+ *      The configuration object, needed by the configfile base class.
+ */
+
+songcachefile::songcachefile
+(
+    const std::string & filename,
+    songinfo_map & cache,
+    rcsettings & rcs
+) :
+    configfile      (filename, rcs, ".songcache"),
+    m_song_cache    (cache)
+{
+    version(s_song_cache_file_version);
+}
+
+/**
+ *  Reads the cache.  A missing file or a file of another version is not an
+ *  error; the songs are simply scanned again.
+ *
+ * \return
+ *      Returns true if the file was read.
+ */
+
+bool
+songcachefile::parse ()
+{
+    std::ifstream file(name(), std::ios::in | std::ios::ate);
+    bool result = file.is_open();
+    if (result)
+    {
+        file.seekg(0, std::ios::beg);
+        (void) parse_version(file);
+        result = file_version_number() == s_song_cache_file_version;
+        if (result && line_after(file, "[song-cache]"))
+        {
+            do
+            {
+                std::string filepath;
+                songinfo si;
+                if (scan_song_line(filepath, si))
+                    m_song_cache[filepath] = si;
+
+            } while (next_data_line(file));
+        }
+        file.close();
+    }
+    return result;
+}
+
+/**
+ *  Parses one song line.  The line has already been trimmed of white space.
+ */
+
+bool
+songcachefile::scan_song_line (std::string & filepath, songinfo & si)
+{
+    const std::string & ln = line();
+    auto q0 = ln.find_first_of('"');
+    auto q1 = q0 == std::string::npos ? q0 : ln.find_first_of('"', q0 + 1) ;
+    if (q1 == std::string::npos)
+        return false;
+
+    filepath = ln.substr(q0 + 1, q1 - q0 - 1);
+
+    unsigned long long fsize, hash;
+    long long mtime;
+    long length;
+    int consumed = 0;
+    int count = std::sscanf
+    (
+        ln.c_str() + q1 + 1, "%llu %lld %llx %d %d %d %ld %lf %n",
+        &fsize, &mtime, &hash, &si.m_format, &si.m_track_count,
+        &si.m_ppqn, &length, &si.m_bpm, &consumed
+    );
+    bool result = count == 8 && ! filepath.empty();
+    if (result)
+    {
+        si.m_file_size = size_t(fsize);
+        si.m_mod_time = std::time_t(mtime);
+        si.m_hash = songinfo::hash_t(hash);
+        si.m_length = midipulse(length);
+        si.m_error = strip_quotes(ln.substr(q1 + 1 + consumed));
+    }
+    return result;
+}
+
+/**
+ *  Writes the cache.
+ *
+ * \return
+ *      Returns true if the file could be opened for writing.
+ */
+
+bool
+songcachefile::write ()
+{
+    std::ofstream file(name(), std::ios::out | std::ios::trunc);
+    bool result = ! name().empty() && file.is_open();
+    if (! result)
+    {
+        file_error("Write open fail", name());
+        return result;
+    }
+    write_date(file, "song cache");
+    file <<
+"# This file holds the summaries of the songs made by a deep verification of\n"
+"# the playlist of the same name.  Seq66 rewrites it as needed; there is no\n"
+"# need to edit it.  Each line holds the quoted song path, the file size,\n"
+"# time, and hash, the SMF format, track count, PPQN, length in pulses, the\n"
+"# initial BPM, and a quoted error message, empty for a good song.\n"
+        ;
+    write_seq66_header(file, "songcache", version());
+    file << "\n[song-cache]\n\n";
+    for (const auto & sipair : m_song_cache)
+    {
+        const songinfo & si = sipair.second;
+        file
+            << add_quotes(sipair.first) << " "
+            << si.file_size() << " "
+            << static_cast<long long>(si.mod_time()) << " "
+            << std::hex << si.hash() << std::dec << " "
+            << si.format() << " "
+            << si.track_count() << " "
+            << si.ppqn() << " "
+            << si.length() << " "
+            << std::fixed << std::setprecision(2) << si.bpm() << " "
+            << add_quotes(si.error()) << "\n"
+            ;
+    }
+    write_seq66_footer(file);
+    file.close();
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * songcachefile.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -477,6 +477,8 @@ usrfile::parse ()
 
         bool flag = get_boolean(file, tag, "note-resume");
         usr().resume_note_ons(flag);
+        flag = get_boolean(file, tag, "control-resume");
+        usr().resume_controls(flag);
 
 #if defined USE_USR_STYLE_SHEET
 
@@ -557,6 +559,12 @@ usrfile::parse ()
     usr().new_pattern_record_style(s);
     flag = get_boolean(file, tag, "wrap-around");
     usr().new_pattern_wraparound(flag);
+    s = get_variable(file, tag, "cc-reduction");
+    usr().new_pattern_reduction(s);
+    int reduction = get_integer(file, tag, "cc-reduction-value");
+    usr().new_pattern_reduction_value(reduction);
+    reduction = get_integer(file, tag, "cc-reduction-pulses");
+    usr().new_pattern_reduction_pulses(reduction);
 
     /*
      * We have all of the data.  Close the file.
@@ -982,6 +990,8 @@ usrfile::write ()
 "# 'even-numbers', and 'all-numbers'.\n"
 "#\n"
 "# note-resume causes notes-in-progress to resume when the pattern toggles on.\n"
+"# control-resume also resends the latest control, program, pressure, and\n"
+"# pitch-bend values of the pattern when it toggles on or playback moves.\n"
 "#\n"
 #if defined USE_USR_STYLE_SHEET
 "# If specified, a style-sheet (e.g. 'qseq66.qss') is applied at startup.\n"
@@ -1013,6 +1023,7 @@ usrfile::write ()
     write_integer(file, "key-height", usr().key_height());
     write_string(file, "key-view", usr().key_view_string());
     write_boolean(file, "note-resume", usr().resume_note_ons());
+    write_boolean(file, "control-resume", usr().resume_controls());
 #if defined USE_USR_STYLE_SHEET
     write_boolean(file, "style-sheet-active", usr().style_sheet_active());
     write_string(file, "style-sheet", usr().style_sheet(), true);
@@ -1064,7 +1075,11 @@ usrfile::write ()
 "# and 'one-shot-reset'. 'wrap-around' allows recorded notes to wrap to the\n"
 "# pattern start. 'escape-pattern' allows the Esc key to close the pattern\n"
 "# editor if not playing or in paint mode. Currently 'notemap' and quantizing\n"
-"# are mutually exclusive.\n"
+"# are mutually exclusive. 'cc-reduction' thins recorded controllers, pitch\n"
+"# bend, and aftertouch: 'none', 'delta' (keep a value only if it moved by\n"
+"# 'cc-reduction-value' and is 'cc-reduction-pulses' after the last one kept),\n"
+"# or 'curve' (drop values within 'cc-reduction-value' of a straight line;\n"
+"# 'cc-reduction-pulses' is the longest gap, 0 = none). Values are 7-bit.\n"
 "\n[new-pattern-editor]\n\n"
         ;
     write_boolean(file, "escape-pattern", usr().escape_pattern());
@@ -1076,6 +1091,15 @@ usrfile::write ()
     write_boolean(file, "notemap", usr().new_pattern_notemap());
     write_string(file, "record-style", usr().new_pattern_record_string());
     write_boolean(file, "wrap-around", usr().new_pattern_wraparound());
+    write_string(file, "cc-reduction", usr().new_pattern_reduction());
+    write_integer
+    (
+        file, "cc-reduction-value", usr().new_pattern_reduction_value()
+    );
+    write_integer
+    (
+        file, "cc-reduction-pulses", usr().new_pattern_reduction_pulses()
+    );
     write_seq66_footer(file);
     file.close();
     return true;
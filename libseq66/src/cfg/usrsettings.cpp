@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-23
- * \updates       2024-02-22
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the remaining legacy global variables, so
@@ -388,6 +388,7 @@ usrsettings::usrsettings () :
     m_user_save_daemonize       (false),
     m_user_use_logfile          (false),
     m_user_option_logfile       (),
+    m_user_option_memory_report (0),
     m_user_pdf_viewer           (),
     m_user_browser              (),
 
@@ -403,6 +404,7 @@ usrsettings::usrsettings () :
     m_user_ui_style_sheet       (""),
 #endif
     m_resume_note_ons           (false),
+    m_resume_controls           (false),
     m_fingerprint_size          (c_fingerprint_size),
     m_progress_box_width        (c_progress_box_width),
     m_progress_box_height       (c_progress_box_height),
@@ -423,6 +425,9 @@ usrsettings::usrsettings () :
     m_new_pattern_notemap       (false),
     m_new_pattern_record_style  (recordstyle::merge),
     m_new_pattern_wraparound    (false),
+    m_new_pattern_reduction     ("none"),
+    m_new_pattern_reduction_value (2),
+    m_new_pattern_reduction_pulses (0),
     m_record_mode               (alteration::none),
     m_grid_record_style         (recordstyle::merge),
     m_grid_mode                 (gridmode::loop),
@@ -502,6 +507,7 @@ usrsettings::set_defaults ()
     m_user_save_daemonize = false;
     m_user_use_logfile = false;
     m_user_option_logfile.clear();
+    m_user_option_memory_report = 0;
     m_user_pdf_viewer.clear();
     m_user_browser.clear();
     m_user_ui_key_height = c_def_key_height;
@@ -512,6 +518,7 @@ usrsettings::set_defaults ()
     m_user_ui_style_sheet = "";
 #endif
     m_resume_note_ons = false;
+    m_resume_controls = false;
     m_fingerprint_size = c_fingerprint_size;
     m_progress_box_width = c_progress_box_width;
     m_progress_box_height = c_progress_box_height;
@@ -532,6 +539,9 @@ usrsettings::set_defaults ()
     m_new_pattern_notemap = false;
     m_new_pattern_record_style = recordstyle::merge;
     m_new_pattern_wraparound = false;
+    m_new_pattern_reduction = "none";
+    m_new_pattern_reduction_value = 2;
+    m_new_pattern_reduction_pulses = 0;
     m_record_mode = alteration::none;
     m_grid_record_style = recordstyle::merge;
     m_grid_mode = gridmode::loop;
@@ -592,6 +602,20 @@ usrsettings::new_pattern_record_style (const std::string & style)
     m_new_pattern_record_style = rs;
 }
 
+/**
+ *  Sets the default controller-reduction method for new patterns.  Anything
+ *  other than "delta" or "curve" means "none".
+ */
+
+void
+usrsettings::new_pattern_reduction (const std::string & method)
+{
+    if (method == "delta" || method == "curve")
+        m_new_pattern_reduction = method;
+    else
+        m_new_pattern_reduction = "none";
+}
+
 void
 usrsettings::new_pattern_record_style (int index)
 {
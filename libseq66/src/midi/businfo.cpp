@@ -390,6 +390,17 @@ busarray::play (bussbyte bus, const event * e24, midibyte channel)
         m_container[bus].bus()->play(e24, channel);
 }
 
+/**
+ *  Sends an event at once on the given buss.  See midibase::play_direct().
+ */
+
+void
+busarray::play_direct (bussbyte bus, const event * e24, midibyte channel)
+{
+    if (bus < count() && m_container[bus].active())
+        m_container[bus].bus()->play_direct(e24, channel);
+}
+
 /**
  *  Handles SysEx events; used for output busses.
  *
@@ -0,0 +1,353 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          ccreducer.cpp
+ *
+ *  This module defines a filter that thins out recorded controller data.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of ccreducer.hpp for the design.
+ */
+
+#include <cstdlib>                      /* std::abs()                       */
+
+#include "midi/ccreducer.hpp"           /* seq66::ccreducer                 */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+ccreducer::ccreducer () :
+    m_method        (method::none),
+    m_value         (2),
+    m_pulses        (0),
+    m_gap           (48),
+    m_streams       (),
+    m_output        (),
+    m_received      (0),
+    m_kept          (0)
+{
+    // no code
+}
+
+/**
+ *  Sets the reduction parameters, dropping any held events.
+ *
+ * \param m
+ *      The method to use.  method::none turns off the reduction.
+ *
+ * \param value
+ *      The value threshold (delta) or tolerance (curve) in 7-bit units.
+ *
+ * \param pulses
+ *      The smallest (delta) or largest (curve) distance between kept
+ *      events.  0 means no limit.
+ *
+ * \param ppqn
+ *      The PPQN of the pattern, used to size the rest gap.
+ */
+
+void
+ccreducer::configure (method m, int value, midipulse pulses, int ppqn)
+{
+    m_method = m < method::max ? m : method::none ;
+    m_value = value >= 0 ? value : 0 ;
+    if (m_value > c_midibyte_data_max)
+        m_value = c_midibyte_data_max;
+
+    m_pulses = pulses >= 0 ? pulses : 0 ;
+    m_gap = ppqn / 4;                               /* a sixteenth note     */
+    if (m_gap < m_pulses)
+        m_gap = m_pulses;
+
+    if (m_gap < 1)
+        m_gap = 1;
+
+    reset();
+}
+
+/**
+ *  Indicates if the event is one that can be reduced.  The switch-like
+ *  controllers are not:  Bank Select (0, 32), Data Entry (6, 38), the
+ *  pedals (64 to 69), the (N)RPN selectors and increments (96 to 101), and
+ *  the Channel Mode messages (120 to 127).
+ */
+
+bool
+ccreducer::reducible (const event & ev)
+{
+    midibyte status = event::mask_status(ev.get_status());
+    if (status == EVENT_CONTROL_CHANGE)
+    {
+        midibyte d0, d1;
+        ev.get_data(d0, d1);
+        if (d0 == 0 || d0 == 6 || d0 == 32 || d0 == 38)
+            return false;
+
+        if ((d0 >= 64 && d0 <= 69) || (d0 >= 96 && d0 <= 101) || d0 >= 120)
+            return false;
+
+        return true;
+    }
+    return status == EVENT_PITCH_WHEEL ||
+        status == EVENT_CHANNEL_PRESSURE || status == EVENT_AFTERTOUCH;
+}
+
+/**
+ *  The stream key:  the channel times 258, plus the controller number, 128
+ *  for Pitch Bend, 129 for Channel Pressure, or 130 plus the note for
+ *  Aftertouch.
+ */
+
+int
+ccreducer::stream_key (const event & ev)
+{
+    midibyte status = ev.get_status();
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+    int result = int(status & 0x0F) * 258;
+    switch (event::mask_status(status))
+    {
+    case EVENT_CONTROL_CHANGE:      result += int(d0);          break;
+    case EVENT_PITCH_WHEEL:         result += 128;              break;
+    case EVENT_CHANNEL_PRESSURE:    result += 129;              break;
+    default:                        result += 130 + int(d0);    break;
+    }
+    return result;
+}
+
+int
+ccreducer::event_value (const event & ev)
+{
+    midibyte status = event::mask_status(ev.get_status());
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+    if (status == EVENT_PITCH_WHEEL)
+        return int(d0) + (int(d1) << 7);
+    else if (status == EVENT_CHANNEL_PRESSURE)
+        return int(d0);
+    else
+        return int(d1);
+}
+
+/**
+ *  The threshold or tolerance for the event, scaled for Pitch Bend.  For
+ *  delta, it is at least 1, so that repeated values are always dropped.
+ */
+
+int
+ccreducer::threshold (const event & ev) const
+{
+    int result = m_value;
+    if (event::mask_status(ev.get_status()) == EVENT_PITCH_WHEEL)
+        result *= 128;
+
+    if (m_method == method::delta && result < 1)
+        result = 1;
+
+    return result;
+}
+
+/**
+ *  Records the event and makes it the anchor of its stream.
+ */
+
+void
+ccreducer::keep (stream & s, const event & ev)
+{
+    m_output.push_back(ev);
+    ++m_kept;
+    s.anchored = true;
+    s.anchor_tick = ev.timestamp();
+    s.anchor_value = event_value(ev);
+    s.held.clear();
+}
+
+/**
+ *  Writes the newest held event, unless it just repeats the anchor value.
+ */
+
+void
+ccreducer::release_held (stream & s)
+{
+    if (! s.held.empty())
+    {
+        event last = s.held.back();             /* keep() clears the list   */
+        if (! s.anchored || event_value(last) != s.anchor_value)
+            keep(s, last);
+        else
+            s.held.clear();
+    }
+}
+
+/**
+ *  Checks that the line from the anchor to the last event passes within the
+ *  tolerance of every held event.
+ */
+
+bool
+ccreducer::fits_line (const stream & s, const event & last) const
+{
+    int tolerance = threshold(last);
+    midipulse span = last.timestamp() - s.anchor_tick;
+    int rise = event_value(last) - s.anchor_value;
+    for (const auto & e : s.held)
+    {
+        int expected = s.anchor_value;
+        if (span > 0)
+        {
+            midipulse dt = e.timestamp() - s.anchor_tick;
+            expected += int(double(rise) * double(dt) / double(span));
+        }
+        if (std::abs(event_value(e) - expected) > tolerance)
+            return false;
+    }
+    return true;
+}
+
+/**
+ *  Processes one recorded event.
+ *
+ * \param ev
+ *      The event, with its final (wrapped, if applicable) timestamp.
+ *
+ * \return
+ *      Returns the events to add to the pattern, which can be none, the
+ *      event itself, an event held earlier, or both.  The vector is valid
+ *      until the next call.
+ */
+
+const std::vector<event> &
+ccreducer::process (const event & ev)
+{
+    m_output.clear();
+    if (! active() || ! reducible(ev))
+    {
+        m_output.push_back(ev);
+        return m_output;
+    }
+
+    ++m_received;
+    stream & s = m_streams[stream_key(ev)];
+    midipulse t = ev.timestamp();
+    if (! s.anchored || t < s.anchor_tick)          /* first, or looped     */
+    {
+        release_held(s);
+        keep(s, ev);
+        return m_output;
+    }
+    if (! s.held.empty() && t - s.held.back().timestamp() >= m_gap)
+        release_held(s);                            /* it came to rest      */
+
+    if (m_method == method::delta)
+    {
+        bool far = std::abs(event_value(ev) - s.anchor_value) >= threshold(ev);
+        bool late = t - s.anchor_tick >= m_pulses;
+        if (far && late)
+        {
+            keep(s, ev);
+        }
+        else
+        {
+            s.held.clear();
+            s.held.push_back(ev);
+        }
+    }
+    else
+    {
+        if (! s.held.empty())
+        {
+            bool toolong = m_pulses > 0 && t - s.anchor_tick > m_pulses;
+            bool full = int(s.held.size()) >= c_window_max;
+            if (toolong || full || ! fits_line(s, ev))
+            {
+                event last = s.held.back();
+                keep(s, last);
+            }
+        }
+        s.held.push_back(ev);
+    }
+    return m_output;
+}
+
+/**
+ *  Writes the held events of all streams, and starts afresh.  Called when
+ *  recording stops or the pattern stops playing.
+ */
+
+const std::vector<event> &
+ccreducer::flush ()
+{
+    m_output.clear();
+    for (auto & sp : m_streams)
+        release_held(sp.second);
+
+    m_streams.clear();
+    return m_output;
+}
+
+/**
+ *  Drops the held events, e.g. when an overwrite pass clears the pattern.
+ */
+
+void
+ccreducer::reset ()
+{
+    m_streams.clear();
+    m_output.clear();
+}
+
+std::string
+ccreducer::method_name (method m)
+{
+    switch (m)
+    {
+    case method::delta:     return "delta";
+    case method::curve:     return "curve";
+    default:                return "none";
+    }
+}
+
+ccreducer::method
+ccreducer::method_from_name (const std::string & name)
+{
+    if (name == "delta")
+        return method::delta;
+    else if (name == "curve")
+        return method::curve;
+    else
+        return method::none;
+}
+
+}           // namespace seq66
+
+/*
+ * ccreducer.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
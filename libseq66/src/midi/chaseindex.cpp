@@ -0,0 +1,284 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          chaseindex.cpp
+ *
+ *  This module defines the note and controller chase index of a pattern.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of chaseindex.hpp for the design.
+ */
+
+#include <algorithm>                    /* std::lower_bound(), std::sort()  */
+
+#include "midi/chaseindex.hpp"          /* seq66::chaseindex                */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The number of notes or state events between checkpoints.  This is the
+ *  maximum number of items a lookup has to replay past the checkpoint.
+ */
+
+static const std::size_t c_chase_stride = 64;
+
+/**
+ *  Default constructor.  The index starts out invalid, and is built the
+ *  first time a chase is requested.
+ */
+
+chaseindex::chaseindex () :
+    m_notes             (),
+    m_note_checkpoints  (),
+    m_states            (),
+    m_state_checkpoints (),
+    m_final_state       (),
+    m_length            (0),
+    m_valid             (false)
+{
+    // no code
+}
+
+void
+chaseindex::clear ()
+{
+    m_notes.clear();
+    m_note_checkpoints.clear();
+    m_states.clear();
+    m_state_checkpoints.clear();
+    m_final_state.clear();
+    m_length = 0;
+    m_valid = false;
+}
+
+/**
+ *  Builds the index from a sorted and linked event list.  Only linked Note
+ *  Ons are indexed, as in the original resume_note_ons() code.  Events at
+ *  or beyond the pattern length are never played, so they are skipped.
+ *
+ *  The note checkpoints are built with a sweep:  the "active" multimap is
+ *  keyed by Note Off time, and notes that have ended before the checkpoint
+ *  are dropped from the front of it.  Wrapped notes (Note Off before Note
+ *  On) sound at the end of the pattern, so they are kept in every
+ *  checkpoint that follows them.
+ *
+ * \param evlist
+ *      The events of the sequence, sorted by time stamp and linked.
+ *
+ * \param len
+ *      The length of the sequence in pulses.
+ */
+
+void
+chaseindex::build (const event::buffer & evlist, midipulse len)
+{
+    clear();
+    m_length = len;
+    if (len <= 0)
+        return;
+
+    for (const auto & e : evlist)
+    {
+        midipulse ts = e.timestamp();
+        if (ts >= len)
+            continue;
+
+        if (e.is_note_on_linked())
+        {
+            interval i;
+            i.on = ts;
+            i.off = e.link()->timestamp();
+            i.note_on = e;
+            m_notes.push_back(i);
+        }
+        else if (is_state_event(e))
+            m_states.push_back(e);
+    }
+
+    std::multimap<midipulse, std::size_t> active;
+    std::vector<std::size_t> wrapped;
+    m_note_checkpoints.reserve(m_notes.size() / c_chase_stride + 1);
+    m_note_checkpoints.push_back(std::vector<std::size_t>());
+    for (std::size_t n = 0; n < m_notes.size(); ++n)
+    {
+        const interval & i = m_notes[n];
+        if (i.on > i.off)
+            wrapped.push_back(n);
+        else
+            active.emplace(i.off, n);
+
+        if ((n + 1) % c_chase_stride == 0)
+        {
+            midipulse t = i.on;
+            while (! active.empty() && active.begin()->first <= t)
+                active.erase(active.begin());
+
+            std::vector<std::size_t> cp(wrapped);
+            for (const auto & a : active)
+                cp.push_back(a.second);
+
+            m_note_checkpoints.push_back(cp);
+        }
+    }
+
+    statemap running;
+    m_state_checkpoints.reserve(m_states.size() / c_chase_stride + 1);
+    for (std::size_t s = 0; s < m_states.size(); ++s)
+    {
+        if (s % c_chase_stride == 0)
+            m_state_checkpoints.push_back(running);
+
+        running[state_key(m_states[s])] = s;
+    }
+    if (m_state_checkpoints.empty() || m_states.size() % c_chase_stride == 0)
+        m_state_checkpoints.push_back(running);
+
+    m_final_state = running;
+    m_valid = true;
+}
+
+/**
+ *  Finds the Note Ons that are sounding at the given tick.
+ *
+ * \param tick
+ *      The absolute tick of the reposition.  It is reduced modulo the
+ *      pattern length.
+ *
+ * \param [out] out
+ *      The Note On events are appended to this buffer.
+ *
+ * \return
+ *      Returns the number of events appended.
+ */
+
+int
+chaseindex::chase_notes (midipulse tick, event::buffer & out) const
+{
+    int result = 0;
+    if (m_valid && m_length > 0 && ! m_notes.empty())
+    {
+        midipulse rem = tick % m_length;
+        auto it = std::lower_bound
+        (
+            m_notes.begin(), m_notes.end(), rem,
+            [] (const interval & i, midipulse t) { return i.on < t; }
+        );
+        std::size_t count = std::size_t(it - m_notes.begin());
+        std::size_t k = count / c_chase_stride;
+        for (auto n : m_note_checkpoints[k])
+        {
+            if (m_notes[n].sounding(rem))
+            {
+                out.push_back(m_notes[n].note_on);
+                ++result;
+            }
+        }
+        for (std::size_t n = k * c_chase_stride; n < count; ++n)
+        {
+            if (m_notes[n].sounding(rem))
+            {
+                out.push_back(m_notes[n].note_on);
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  Finds the latest controller, program, pressure, and pitch-bend events
+ *  before the given tick.  If the tick shows that the pattern has already
+ *  played through at least once, the values left at the end of the pattern
+ *  are used for the keys that have not yet changed in the current loop.
+ *
+ * \param tick
+ *      The absolute tick of the reposition.
+ *
+ * \param [out] out
+ *      The events are appended to this buffer, in the order in which they
+ *      were originally played.
+ *
+ * \return
+ *      Returns the number of events appended.
+ */
+
+int
+chaseindex::chase_states (midipulse tick, event::buffer & out) const
+{
+    int result = 0;
+    if (m_valid && m_length > 0 && ! m_states.empty())
+    {
+        midipulse rem = tick % m_length;
+        auto it = std::lower_bound
+        (
+            m_states.begin(), m_states.end(), rem,
+            [] (const event & e, midipulse t) { return e.timestamp() < t; }
+        );
+        std::size_t count = std::size_t(it - m_states.begin());
+        std::size_t k = count / c_chase_stride;
+        statemap current = m_state_checkpoints[k];
+        for (std::size_t s = k * c_chase_stride; s < count; ++s)
+            current[state_key(m_states[s])] = s;
+
+        std::vector<std::size_t> previous;              /* last loop        */
+        if (tick >= m_length)
+        {
+            for (const auto & f : m_final_state)
+            {
+                if (current.find(f.first) == current.end())
+                    previous.push_back(f.second);
+            }
+        }
+
+        std::vector<std::size_t> latest;
+        latest.reserve(current.size());
+        for (const auto & c : current)
+            latest.push_back(c.second);
+
+        std::sort(previous.begin(), previous.end());
+        std::sort(latest.begin(), latest.end());
+        for (auto s : previous)
+            out.push_back(m_states[s]);
+
+        for (auto s : latest)
+            out.push_back(m_states[s]);
+
+        result = int(previous.size() + latest.size());
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * chaseindex.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
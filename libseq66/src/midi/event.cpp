@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-08-22
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  A MIDI event (i.e. "track event") is encapsulated by the seq66::event
@@ -115,9 +115,11 @@ event::event () :
     m_status        (EVENT_NOTE_OFF),           /* note-off, channel 0      */
     m_channel       (null_channel()),           /* 0x80                     */
     m_data          (),                         /* a two-element array      */
-    m_sysex         (),                         /* an std::vector           */
+    m_sysex         (),                         /* no bytes allocated       */
     m_linked        (),                         /* uninit'd iterator #124   */
     m_has_link      (false),
+    m_id            (0),
+    m_link_id       (0),
     m_selected      (false),
     m_marked        (false),
     m_painted       (false)
@@ -149,9 +151,11 @@ event::event (midipulse tstamp, midibyte status, midibyte d0, midibyte d1) :
     m_status        (status),               /* keep the channel 2021-08-09  */
     m_channel       (mask_channel(status)),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
+    m_sysex         (),                     /* no bytes allocated yet       */
     m_linked        (),                     /* removed nullptr issue #124   */
     m_has_link      (false),
+    m_id            (0),
+    m_link_id       (0),
     m_selected      (false),
     m_marked        (false),
     m_painted       (false)
@@ -169,9 +173,11 @@ event::event (midipulse tstamp, midibpm tempo) :
     m_status        (EVENT_MIDI_META),
     m_channel       (EVENT_META_SET_TEMPO),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
+    m_sysex         (),                     /* no bytes allocated yet       */
     m_linked        (),                     /* removed nullptr issue #124   */
     m_has_link      (false),
+    m_id            (0),
+    m_link_id       (0),
     m_selected      (false),
     m_marked        (false),
     m_painted       (false)
@@ -196,9 +202,11 @@ event::event
     m_status        (notekind),
     m_channel       (channel),
     m_data          (),                     /* two-element array, midibytes */
-    m_sysex         (),                     /* an std::vector of midibytes  */
+    m_sysex         (),                     /* no bytes allocated yet       */
     m_linked        (),                     /* removed nullptr issue #124   */
     m_has_link      (false),
+    m_id            (0),
+    m_link_id       (0),
     m_selected      (false),
     m_marked        (false),
     m_painted       (false)
@@ -246,9 +254,11 @@ event::event (const event & rhs) :
     m_status        (rhs.m_status),
     m_channel       (rhs.m_channel),
     m_data          (),                     /* a two-element array      */
-    m_sysex         (rhs.m_sysex),          /* copies a vector of data  */
+    m_sysex         (rhs.m_sysex),          /* shares the data, see COW */
     m_linked        (rhs.m_linked),         /* for vector implemenation */
     m_has_link      (rhs.m_has_link),       /* m_linked has 2 linkers!  */
+    m_id            (rhs.m_id),             /* eventlist::relink() fixes    */
+    m_link_id       (rhs.m_link_id),        /* ...m_linked from these two   */
     m_selected      (rhs.m_selected),
     m_marked        (rhs.m_marked),
     m_painted       (rhs.m_painted)
@@ -291,6 +301,8 @@ event::operator = (const event & rhs)
         m_sysex         = rhs.m_sysex;
         m_linked        = rhs.m_linked;             /* vector implemenation */
         m_has_link      = rhs.m_has_link;           /* two linkers!         */
+        m_id            = rhs.m_id;
+        m_link_id       = rhs.m_link_id;
         m_selected      = rhs.m_selected;           /* false instead?       */
         m_marked        = rhs.m_marked;             /* false instead?       */
         m_painted       = rhs.m_painted;            /* false instead?       */
@@ -301,7 +313,7 @@ event::operator = (const event & rhs)
 /**
  *  This destructor explicitly deletes m_sysex and sets it to null.
  *  The reset_sysex() function does what we need.  But now that m_sysex is a
- *  vector, no action is needed.
+ *  shared, reference-counted payload, no action is needed.
  */
 
 event::~event ()
@@ -822,9 +834,10 @@ event::set_text (const std::string & s)
     bool result = ! s.empty();
     if (result)
     {
-        m_sysex.clear();
+        midibytes & bytes = m_sysex.edit();
+        bytes.clear();
         for (const auto c : s)
-            m_sysex.push_back(c);
+            bytes.push_back(c);
     }
     return result;
 }
@@ -866,9 +879,10 @@ event::append_meta_data (midibyte metatype, const midibyte * data, int dsize)
     bool result = not_nullptr(data) && (dsize > 0);
     if (result)
     {
+        midibytes & bytes = m_sysex.edit();
         set_meta_status(metatype);
         for (int i = 0; i < dsize; ++i)
-            m_sysex.push_back(data[i]);
+            bytes.push_back(data[i]);
     }
     else
     {
@@ -899,9 +913,10 @@ event::append_meta_data (midibyte metatype, const midibytes & data)
     bool result = dsize > 0;
     if (result)
     {
+        midibytes & bytes = m_sysex.edit();
         set_meta_status(metatype);
         for (int i = 0; i < dsize; ++i)
-             m_sysex.push_back(data[i]);
+             bytes.push_back(data[i]);
     }
     else
     {
@@ -929,7 +944,7 @@ bool
 event::append_sysex_byte (midibyte data)
 {
     bool firstbyte = m_sysex.empty();
-    m_sysex.push_back(data);
+    m_sysex.edit().push_back(data);
     return firstbyte || data != EVENT_MIDI_SYSEX_END;
 }
 
@@ -958,8 +973,9 @@ event::append_sysex (const midibyte * data, int dsize)
     bool result = not_nullptr(data) && (dsize > 0);
     if (result)
     {
+        midibytes & bytes = m_sysex.edit();
         for (int i = 0; i < dsize; ++i)
-            m_sysex.push_back(data[i]);
+            bytes.push_back(data[i]);
     }
     else
     {
@@ -974,8 +990,9 @@ event::append_sysex (const midibytes & data)
     bool result = ! data.empty();
     if (result)
     {
+        midibytes & bytes = m_sysex.edit();
         for (auto b : data)
-            m_sysex.push_back(b);
+            bytes.push_back(b);
     }
     else
     {
@@ -1018,7 +1035,7 @@ event::set_sysex_size (int len)
     if (len == 0)
         m_sysex.clear();
     else if (len > 0)
-        m_sysex.resize(len);
+        m_sysex.edit().resize(len);
 }
 
 /**
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2023-10-09
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This container now can indicate if certain Meta events (time-signaure or
@@ -33,6 +33,7 @@
  */
 
 #include <algorithm>                    /* std::sort(), std::merge()        */
+#include <iterator>                     /* std::make_move_iterator()        */
 
 #include "cfg/settings.hpp"             /* seq66::usr()                     */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
@@ -44,6 +45,13 @@
 namespace seq66
 {
 
+/**
+ *  The number of unused event slots that compact() tolerates without being
+ *  forced.  Small patterns are not worth reallocating.
+ */
+
+static const std::size_t c_compact_slack = 1024;
+
 /**
  *  Principal constructor.
  */
@@ -59,7 +67,10 @@ eventlist::eventlist () :
     m_has_tempo             (false),
     m_has_time_signature    (false),
     m_has_key_signature     (false),
-    m_link_wraparound       (usr().new_pattern_wraparound())
+    m_link_wraparound       (usr().new_pattern_wraparound()),
+    m_next_id               (1),
+    m_id_positions          (),
+    m_partners              ()
 {
     // No code needed
 }
@@ -67,7 +78,8 @@ eventlist::eventlist () :
 /**
  *  We have to now define this copy constructor because the atomic copy
  *  constructor is deleted, making the compiler-generated copy constructor
- *  ill-formed.
+ *  ill-formed.  The copied links still point into the events of rhs, so
+ *  they are restored from the event IDs.
  */
 
 eventlist::eventlist (const eventlist & rhs) :
@@ -81,9 +93,12 @@ eventlist::eventlist (const eventlist & rhs) :
     m_has_tempo             (rhs.m_has_tempo),
     m_has_time_signature    (rhs.m_has_time_signature),
     m_has_key_signature     (false),
-    m_link_wraparound       (rhs.m_link_wraparound)
+    m_link_wraparound       (rhs.m_link_wraparound),
+    m_next_id               (rhs.m_next_id),
+    m_id_positions          (),
+    m_partners              ()
 {
-    // no code
+    relink();
 }
 
 eventlist &
@@ -102,6 +117,8 @@ eventlist::operator = (const eventlist & rhs)
         m_has_time_signature    = rhs.m_has_time_signature;
         m_has_key_signature     = rhs.m_has_key_signature;
         m_link_wraparound       = rhs.m_link_wraparound;
+        m_next_id               = rhs.m_next_id;
+        relink();
     }
     return *this;
 }
@@ -229,19 +246,113 @@ eventlist::add (const event & e)
     return result;
 }
 
+/**
+ *  Moves the events that are out of order, starting at the first descent,
+ *  to a separate list, leaving the rest of the events sorted.  At each
+ *  descent, either the new event is too small, or the last event kept was
+ *  too large (it was moved later); the following event tells which.
+ *
+ * \param evs
+ *      The events, sorted before index start.
+ *
+ * \param start
+ *      The index of the first event that is less than its predecessor.
+ *
+ * \param [out] strays
+ *      Receives the events that were removed, unsorted.
+ */
+
+static void
+remove_strays (event::buffer & evs, size_t start, event::buffer & strays)
+{
+    size_t count = evs.size();
+    size_t w = start;                               /* next place to keep   */
+    for (size_t i = start; i < count; ++i)
+    {
+        event & x = evs[i];
+        if (w == 0 || ! (x < evs[w - 1]))
+        {
+            if (w != i)
+                evs[w] = std::move(x);
+
+            ++w;
+        }
+        else if (i + 1 < count && ! (evs[i + 1] < evs[w - 1]))
+        {
+            strays.push_back(std::move(x));         /* x moved earlier      */
+        }
+        else if (w >= 2 && ! (x < evs[w - 2]))
+        {
+            strays.push_back(std::move(evs[w - 1]));    /* it moved later   */
+            evs[w - 1] = std::move(x);
+        }
+        else
+            strays.push_back(std::move(x));
+    }
+    evs.erase(evs.begin() + w, evs.end());
+}
+
 /**
  *  Sorts the event list.  For the vector, equivalent elements are not
  *  guaranteed to keep their original relative order [see
  *  std::stable_sort(), which we could try at some point].
  *
- *  This method is probably flawed.
+ *  Most calls follow an edit of a few events (a nudge, a paste, a recorded
+ *  note appended at the end), so a full std::sort() is wasted.  Instead,
+ *  the events that are out of order are moved aside by remove_strays(),
+ *  sorted, and merged back, starting at the first event greater than the
+ *  smallest of them.  An already-sorted list costs one pass, and an edit
+ *  of k events costs about n + k log k.  An edit of k events leaves at most
+ *  about 2k descents, so the descents after the sorted prefix are counted
+ *  first; if there are many (more than one event in 16), the list is
+ *  scrambled, merging does not pay, and the whole list is sorted by
+ *  std::sort() at once.
+ *
+ *  The sort moves the events, so the Note On/Off links are then restored
+ *  from the event IDs by relink().
  */
 
 void
 eventlist::sort ()
 {
     m_action_in_progress = true;
-    std::sort(m_events.begin(), m_events.end());
+    auto first = m_events.begin();
+    auto last = m_events.end();
+    auto mid = std::is_sorted_until(first, last);
+    if (mid != last)
+    {
+        size_t limit = m_events.size() / 16;
+        size_t descents = 0;
+        for (auto e = mid; e != last && descents <= limit; ++e)
+        {
+            if (*e < *(e - 1))
+                ++descents;
+        }
+        if (descents > limit)                       /* merging is no help   */
+        {
+            std::sort(first, last);
+        }
+        else
+        {
+            event::buffer strays;
+            remove_strays(m_events, size_t(mid - first), strays);
+            std::sort(strays.begin(), strays.end());
+
+            size_t kept = m_events.size();
+            m_events.insert
+            (
+                m_events.end(), std::make_move_iterator(strays.begin()),
+                std::make_move_iterator(strays.end())
+            );
+            first = m_events.begin();
+            mid = first + kept;
+            std::inplace_merge
+            (
+                std::upper_bound(first, mid, *mid), mid, m_events.end()
+            );
+        }
+    }
+    relink();
     m_action_in_progress = false;
 }
 
@@ -339,7 +450,7 @@ void
 eventlist::link_new (bool wrap)
 {
     bool wrap_em = m_link_wraparound || wrap;       /* a Stazed extension   */
-    sort();                                         /* IMPORTANT!           */
+    sort();                                         /* IMPORTANT! relinks   */
     for (auto on = m_events.begin(); on != m_events.end(); ++on)
     {
         if (on->on_linkable())
@@ -376,6 +487,126 @@ eventlist::link_new (bool wrap)
     }
 }
 
+/**
+ *  Restores the m_linked iterators of the events from their IDs, after the
+ *  container has been sorted, copied, or had events inserted or erased.
+ *  This takes linear time, instead of the search done by link_new().
+ *
+ *  -   Events added since the last relink (ID 0) get a new ID, and are
+ *      unlinked unless their partner was linked to them.
+ *  -   A link is kept only if both events still exist, point to each other,
+ *      and are still a Note On and a Note Off for the same note.  Otherwise
+ *      both are unlinked, and link_new() will pair them again.
+ *  -   An ID found more than once (e.g. notes pasted into the pattern they
+ *      were copied from) is ambiguous, and those events are unlinked.
+ *
+ *  Finally, the events are renumbered from 1 in their current order, so that
+ *  the IDs stay small.
+ */
+
+void
+eventlist::relink ()
+{
+    int count = int(m_events.size());
+    int maxid = 0;
+    for (auto & e : m_events)
+    {
+        if (e.m_id <= 0)
+            e.m_id = m_next_id++;
+
+        if (e.m_id > maxid)
+            maxid = e.m_id;
+    }
+    m_id_positions.assign(size_t(maxid) + 1, (-1));
+    for (int i = 0; i < count; ++i)
+    {
+        int & pos = m_id_positions[size_t(m_events[size_t(i)].m_id)];
+        pos = pos == (-1) ? i : (-2) ;              /* -2 flags a duplicate */
+    }
+    m_partners.assign(size_t(count), (-1));
+    for (int i = 0; i < count; ++i)
+    {
+        const event & e = m_events[size_t(i)];
+        int lid = e.m_link_id;
+        if (lid > 0 && lid <= maxid && m_id_positions[size_t(e.m_id)] >= 0)
+        {
+            int pos = m_id_positions[size_t(lid)];
+            if (pos >= 0)
+            {
+                const event & p = m_events[size_t(pos)];
+                bool ok = p.m_link_id == e.m_id &&
+                    p.get_note() == e.get_note() &&
+                    (
+                        (e.is_note_on() && p.is_note_off()) ||
+                        (e.is_note_off() && p.is_note_on())
+                    );
+
+                if (ok)
+                    m_partners[size_t(i)] = pos;
+            }
+        }
+    }
+    for (int i = 0; i < count; ++i)
+        m_events[size_t(i)].m_id = i + 1;
+
+    for (int i = 0; i < count; ++i)
+    {
+        event & e = m_events[size_t(i)];
+        int pos = m_partners[size_t(i)];
+        if (pos >= 0)
+            e.link(m_events.begin() + pos);         /* also sets m_link_id  */
+        else
+            e.unlink();
+    }
+    m_next_id = count + 1;
+}
+
+/**
+ *  Replaces the events with a list that is already sorted, and links them
+ *  by index, skipping the sort and the search done by link_new().  Used by
+ *  songsnapshot to restore a pattern.
+ *
+ * \param evlist
+ *      The sorted events.  Its contents are moved into this list.
+ *
+ * \param links
+ *      For each event, the index of its linked event, or -1.
+ */
+
+void
+eventlist::assign_linked
+(
+    event::buffer & evlist,
+    const std::vector<int> & links
+)
+{
+    m_events = std::move(evlist);
+    m_has_tempo = m_has_time_signature = m_has_key_signature = false;
+
+    int count = int(m_events.size());
+    for (int i = 0; i < count; ++i)
+        m_events[size_t(i)].m_id = i + 1;
+
+    m_next_id = count + 1;
+    for (int i = 0; i < count; ++i)
+    {
+        event & e = m_events[size_t(i)];
+        int lk = i < int(links.size()) ? links[size_t(i)] : (-1) ;
+        if (lk >= 0 && lk < count)
+            e.link(m_events.begin() + lk);
+
+        if (e.is_tempo())
+            m_has_tempo = true;
+
+        if (e.is_time_signature())
+            m_has_time_signature = true;
+
+        if (e.is_key_signature())
+            m_has_key_signature = true;
+    }
+    m_is_modified = true;
+}
+
 /**
  *  If we're in legacy merge mode for a loop, the Note Off is actually earlier
  *  than the Note On.  And in replace mode, the Note On is cleared, leaving us
@@ -413,7 +644,9 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
 
 /**
  *  This function verifies state: all note-ons have an off, and it links
- *  note-offs with their note-ons.
+ *  note-offs with their note-ons.  Existing links are no longer discarded;
+ *  they are carried across the sort by relink(), so only unlinked notes are
+ *  searched for.  Call clear_links() first to force a complete relinking.
  *
  * No longer correct:
  *
@@ -442,8 +675,8 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
 void
 eventlist::verify_and_link (midipulse slength, bool wrap)
 {
-    clear_links();                          /* unlink and unmark all events */
-    link_new(wrap);
+    unmark_all();                           /* links are kept, by event ID  */
+    link_new(wrap);                         /* sort, relink, link new notes */
     if (slength > 0)
     {
         mark_out_of_range(slength);
@@ -474,6 +707,73 @@ eventlist::clear ()
     }
 }
 
+/**
+ *  Releases unused memory.  Unless forced, this is done only if at least half
+ *  of the capacity of the container, and at least c_compact_slack events,
+ *  are unused, as after a bulk delete.  Since the events might move, they
+ *  are relinked.
+ *
+ * \param force
+ *      If true, always release the unused capacity, and share the SysEx and
+ *      Meta payloads with identical ones elsewhere.  Used when saving.
+ *
+ * \return
+ *      Returns true if the container was compacted.
+ */
+
+bool
+eventlist::compact (bool force)
+{
+    std::size_t count = m_events.size();
+    std::size_t slack = m_events.capacity() - count;
+    bool result = force || (slack >= count && slack >= c_compact_slack);
+    if (result)
+    {
+        m_action_in_progress = true;
+        if (slack > 0)
+        {
+            m_events.shrink_to_fit();
+            m_match_iterating = false;
+            m_match_iterator = m_events.end();
+            relink();
+            m_id_positions.shrink_to_fit();
+            m_partners.shrink_to_fit();
+        }
+        for (auto & e : m_events)
+            e.share_sysex();                /* dedupes, drops the slack */
+
+        m_action_in_progress = false;
+    }
+    return result;
+}
+
+/**
+ *  Estimates the heap memory used by the events themselves, including the
+ *  linking scratch space.  Capacity, not size, is counted.
+ */
+
+std::size_t
+eventlist::memory_events () const
+{
+    return m_events.capacity() * sizeof(event) +
+        (m_id_positions.capacity() + m_partners.capacity()) * sizeof(int);
+}
+
+/**
+ *  Estimates the heap memory used by the SysEx and Meta payloads.  Shared
+ *  payloads are divided among their users.
+ */
+
+std::size_t
+eventlist::memory_sysex () const
+{
+    std::size_t result = 0;
+    for (const auto & e : m_events)
+        result += e.sysex_memory();
+
+    return result;
+}
+
 /**
  *  Clears all event links and unmarks them all. We get a segfault here
  *  pretty regulary when recording is enabled and the pattern's event list
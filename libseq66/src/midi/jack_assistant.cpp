@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-14
- * \updates       2022-10-11
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This module was created from code that existed in the performer object.
@@ -304,6 +304,11 @@ jack_dummy_callback (jack_nframes_t nframes, void * arg)
  *
  *  Be vewwy vewwy carweful!  This code is really prickly and touchy!
  *
+ *  This callback runs in the JACK process thread, so it must not lock,
+ *  notify, or log.  It only posts the tempo, the start request, and the
+ *  position to the transport mailbox (see jack_assistant::apply_transport()),
+ *  which the performer empties on its own threads.
+ *
  * \param nframes
  *      Unused.
  *
@@ -324,7 +329,7 @@ jack_transport_callback (jack_nframes_t /*nframes*/, void * arg)
     {
         jack_position_t pos;
         jack_transport_state_t s = ::jack_transport_query(j->client(), &pos);
-        performer & p = j->parent();
+        const performer & p = j->parent();
 
         /*
          * int psize = ::jack_get_buffer_size(j->client());
@@ -343,55 +348,32 @@ jack_transport_callback (jack_nframes_t /*nframes*/, void * arg)
         }
         s_last = timeus;
 #endif
-        if (p.is_running())
+        if (j->is_slave())
         {
-            if (j->is_slave())
+            if (pos.beats_per_minute > 1.0)             /* a sanity check   */
             {
-                if (pos.beats_per_minute > 1.0)         /* a sanity check   */
+                if (pos.beats_per_minute != j->m_transport_bpm)
                 {
-                    static double s_old_bpm = 0.0;
-                    if (pos.beats_per_minute != s_old_bpm)
-                    {
-                        s_old_bpm = pos.beats_per_minute;
-                        j->parent().set_beats_per_minute(pos.beats_per_minute);
-                    }
+                    j->m_transport_bpm = pos.beats_per_minute;
+                    j->m_mail_bpm.store(pos.beats_per_minute);
                 }
             }
-
-            long tick = j->current_jack_position();
-            p.jack_reposition(tick, j->jack_stop_tick());
         }
-        else
-        {
-            /*
-             * At start or FF/RW when not running, start or reposition the
-             * transport marker.  Using "! j->is_master()" may lead to a hang
-             * at exit [in ~QApplication()].  Not sure, very tricky, sporadic.
-             */
 
-            if (j->is_slave())
-            {
-                if (pos.beats_per_minute > 1.0)         /* a sanity check   */
-                {
-                    static double s_old_bpm = 0.0;
-                    if (pos.beats_per_minute != s_old_bpm)
-                    {
-                        s_old_bpm = pos.beats_per_minute;
-                        j->parent().set_beats_per_minute(pos.beats_per_minute);
-                    }
-                }
-            }
-            if (s == JackTransportRolling || s == JackTransportStarting)
-            {
-                j->m_transport_state_last = JackTransportStarting;
-                p.inner_start();
-            }
-            else                            /* reposition transport marker  */
-            {
-                long tick = j->current_jack_position();
-                p.jack_reposition(tick, j->jack_stop_tick());
-            }
+        /*
+         * At start or FF/RW when not running, start or reposition the
+         * transport marker.  Using "! j->is_master()" may lead to a hang
+         * at exit [in ~QApplication()].  Not sure, very tricky, sporadic.
+         */
+
+        bool starting = s == JackTransportRolling || s == JackTransportStarting;
+        if (! p.is_running() && starting)
+        {
+            j->m_transport_state_last = JackTransportStarting;
+            j->m_mail_start.store(true);
         }
+        else
+            j->m_mail_tick.store(j->current_jack_position());
     }
     return 0;
 }
@@ -891,7 +873,11 @@ jack_assistant::jack_assistant
     m_ppqn                      (choose_ppqn(ppqn)),
     m_beats_per_measure         (bpmeasure),
     m_beat_width                (beatwidth),
-    m_beats_per_minute          (bpminute)
+    m_beats_per_minute          (bpminute),
+    m_mail_bpm                  (0.0),
+    m_mail_tick                 (c_null_midipulse),
+    m_mail_start                (false),
+    m_transport_bpm             (0.0)
 {
     /*
      * Do this in the rtmidi constructor.
@@ -2036,6 +2022,44 @@ jack_assistant::current_jack_position () const
     }
 }
 
+/**
+ *  Empties the transport mailbox filled by jack_transport_callback(), and
+ *  applies the news to the performer.  Called by the performer's output
+ *  thread at the top of each cycle while playing, and by its input thread
+ *  while stopped.  Each slot is taken with an atomic exchange, so a message
+ *  is applied once even if both threads call this function.
+ *
+ *  The order is that of the old callback: the tempo first, then the start
+ *  or the reposition.
+ *
+ * \return
+ *      Returns true if anything was applied.
+ */
+
+bool
+jack_assistant::apply_transport ()
+{
+    bool result = false;
+    midibpm bpm = m_mail_bpm.exchange(0.0);
+    if (bpm > 0.0)
+    {
+        (void) m_jack_parent.set_beats_per_minute(bpm);
+        result = true;
+    }
+    if (m_mail_start.exchange(false))
+    {
+        m_jack_parent.inner_start();
+        result = true;
+    }
+    midipulse tick = m_mail_tick.exchange(c_null_midipulse);
+    if (! is_null_midipulse(tick))
+    {
+        m_jack_parent.jack_reposition(tick, jack_stop_tick());
+        result = true;
+    }
+    return result;
+}
+
 /*
  *  JACK callbacks.
  */
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2024-08-16
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -33,9 +33,12 @@
  *  buss classes.
  */
 
+#include <cstdio>                       /* std::snprintf()                  */
+
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
 #include "midi/event.hpp"               /* seq66::event                     */
 #include "midi/mastermidibase.hpp"      /* seq66::mastermidibase            */
+#include "midi/renderahead.hpp"         /* seq66::renderahead queue         */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 #include "os/timing.hpp"                /* seq66::microsleep()              */
 
@@ -80,6 +83,8 @@ mastermidibase::mastermidibase
     m_record_by_buss    (false),        /* set based on configuration       */
     m_record_by_channel (false),        /* ditto, but mutually exclusive    */
     m_seq               (nullptr),
+    m_render_ahead      (),
+    m_shapers           (),
     m_mutex             ()
 {
     // Empty body now
@@ -100,6 +105,7 @@ mastermidibase::mastermidibase
 
 mastermidibase::~mastermidibase ()
 {
+    stop_render_ahead();
     if (not_nullptr(m_bus_announce))
     {
         delete m_bus_announce;
@@ -191,6 +197,7 @@ void
 mastermidibase::stop ()
 {
     automutex locker(m_mutex);
+    release_shapers();                      /* no Note Off left waiting     */
     m_outbus_array.stop();
     api_stop();
 }
@@ -264,19 +271,251 @@ void
 mastermidibase::flush ()
 {
     automutex locker(m_mutex);
+    drain_shapers();
     api_flush();
 }
 
+/**
+ *  Creates a bandwidth shaper for each output buss listed in the 'rc' file's
+ *  [midi-bandwidth] section.  Called when the master buss is created.
+ */
+
+void
+mastermidibase::set_bandwidths (const bandwidthlist & bwl)
+{
+    automutex locker(m_mutex);
+    m_shapers.clear();
+    for (const auto & sp : bwl.settings())
+    {
+        std::size_t bus = std::size_t(sp.first);
+        if (bus >= m_shapers.size())
+            m_shapers.resize(bus + 1);
+
+        m_shapers[bus].reset(new (std::nothrow) portshaper(sp.second));
+    }
+}
+
+/**
+ *  Returns the shaper for the buss, or a null pointer if the buss is not
+ *  shaped.  The caller locks the mutex.
+ */
+
+portshaper *
+mastermidibase::shaper (bussbyte bus)
+{
+    std::size_t b = std::size_t(bus);
+    return b < m_shapers.size() ? m_shapers[b].get() : nullptr ;
+}
+
+/**
+ *  Sends the queued events that the bandwidth of each shaped buss allows.
+ *  The caller locks the mutex.
+ *
+ * \return
+ *      Returns true if any events were waiting.
+ */
+
+bool
+mastermidibase::drain_shapers ()
+{
+    bool result = false;
+    for (std::size_t b = 0; b < m_shapers.size(); ++b)
+    {
+        portshaper * ps = m_shapers[b].get();
+        if (not_nullptr(ps) && ps->pending())
+        {
+            ps->drain(m_outbus_array, bussbyte(b));
+            result = true;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Sends all of the queued events of each shaped buss, whatever the
+ *  bandwidth, and flushes them.  The caller locks the mutex.
+ */
+
+void
+mastermidibase::release_shapers ()
+{
+    bool sent = false;
+    for (std::size_t b = 0; b < m_shapers.size(); ++b)
+    {
+        portshaper * ps = m_shapers[b].get();
+        if (not_nullptr(ps) && ps->pending())
+        {
+            ps->release(m_outbus_array, bussbyte(b));
+            sent = true;
+        }
+    }
+    if (sent)
+        api_flush();
+}
+
+/**
+ *  Called by the performer's output loop once per pass, so that the shaped
+ *  queues keep draining when no other events are played, e.g. in the tail
+ *  of a burst.
+ *
+ * \threadsafe
+ */
+
+void
+mastermidibase::drain_bandwidth ()
+{
+    if (bandwidth_shaping())
+    {
+        automutex locker(m_mutex);
+        if (drain_shapers())
+            api_flush();
+    }
+}
+
+/**
+ *  Returns the saturation report of the shaped output busses, or an empty
+ *  string if there are none.
+ */
+
+std::string
+mastermidibase::bandwidth_report ()
+{
+    automutex locker(m_mutex);
+    std::string result;
+    if (bandwidth_shaping())
+    {
+        char temp[160];
+        (void) std::snprintf
+        (
+            temp, sizeof temp,
+            "%3s %7s %10s %10s %8s %8s %8s %7s %7s %6s\n",
+            "Bus", "Rate", "Messages", "Bytes", "Saved", "Delayed",
+            "Thinned", "Backlog", "Max ms", "Load"
+        );
+        result = "Output bandwidth per shaped port:\n";
+        result += temp;
+        for (std::size_t b = 0; b < m_shapers.size(); ++b)
+        {
+            if (m_shapers[b])
+                result += m_shapers[b]->report(bussbyte(b));
+        }
+    }
+    return result;
+}
+
+/**
+ *  Creates the render-ahead queue and starts its dispatch thread.
+ *
+ * \param lookahead_ms
+ *      The look-ahead period in milliseconds.  If 0, nothing is done.
+ *
+ * \return
+ *      Returns true if render-ahead is now active.
+ */
+
+bool
+mastermidibase::start_render_ahead (int lookahead_ms)
+{
+    if (lookahead_ms > 0 && ! m_render_ahead)
+    {
+        m_render_ahead.reset(new (std::nothrow) renderahead(*this));
+        if (m_render_ahead)
+            (void) m_render_ahead->start(lookahead_ms);
+    }
+    return render_ahead();
+}
+
+/**
+ *  Stops the dispatch thread, sending any pending Note Offs, and deletes
+ *  the render-ahead queue.
+ */
+
+void
+mastermidibase::stop_render_ahead ()
+{
+    if (m_render_ahead)
+    {
+        m_render_ahead->stop();
+        m_render_ahead.reset();
+    }
+}
+
+bool
+mastermidibase::render_ahead () const
+{
+    return m_render_ahead && m_render_ahead->active();
+}
+
+int
+mastermidibase::render_ahead_ms () const
+{
+    return render_ahead() ? m_render_ahead->lookahead_ms() : 0 ;
+}
+
+/**
+ *  Schedules an event to be sent after the given delay.  If render-ahead is
+ *  not active, the event is sent now.
+ */
+
+void
+mastermidibase::schedule
+(
+    bussbyte bus, const event & ev, midibyte channel, long delay_us
+)
+{
+    if (render_ahead())
+    {
+        m_render_ahead->schedule(bus, ev, channel, delay_us);
+    }
+    else
+    {
+        event e = ev;
+        play(bus, &e, channel);
+    }
+}
+
+/**
+ *  Drops the scheduled events other than Note Offs.
+ *
+ * \return
+ *      Returns the number of events dropped.
+ */
+
+int
+mastermidibase::invalidate_ahead ()
+{
+    return render_ahead() ? m_render_ahead->invalidate() : 0 ;
+}
+
+/**
+ *  Sends the scheduled Note Offs now, and drops the other scheduled events.
+ */
+
+void
+mastermidibase::release_ahead ()
+{
+    if (render_ahead())
+        m_render_ahead->release();
+}
+
 /**
  *  Stops all notes on all channels on all busses.  Adapted from Oli Kester's
  *  Kepler34 project.  Whether the buss is active or not is ultimately checked
  *  in the busarray::play() function.  A bit wasteful, but do we really care?
+ *  The events waiting in the bandwidth shapers are sent first, whatever the
+ *  bandwidth, so that the Note Offs come after them, and bypass the shapers.
  */
 
 void
 mastermidibase::panic (int displaybuss)
 {
     automutex locker(m_mutex);
+    release_shapers();                      /* send the queued events       */
+    for (auto & sp : m_shapers)             /* forget the last values       */
+    {
+        if (sp)
+            sp->clear();
+    }
     for (int bus = 0; bus < c_busscount_max; ++bus)
     {
         if (bus == displaybuss)             /* do not clear the Launchpad   */
@@ -308,7 +547,11 @@ void
 mastermidibase::sysex (bussbyte bus, const event * ev)
 {
     automutex locker(m_mutex);
-    m_outbus_array.sysex(bus, ev);
+    portshaper * ps = shaper(bus);
+    if (not_nullptr(ps))
+        ps->sysex(m_outbus_array, bus, *ev);    /* behind queued notes  */
+    else
+        m_outbus_array.sysex(bus, ev);
 }
 
 /**
@@ -334,17 +577,49 @@ void
 mastermidibase::play (bussbyte bus, event * e24, midibyte channel)
 {
     automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    portshaper * ps = shaper(bus);
+    if (not_nullptr(ps))
+        ps->play(m_outbus_array, bus, *e24, channel);
+    else
+        m_outbus_array.play(bus, e24, channel);
 }
 
 void
 mastermidibase::play_and_flush (bussbyte bus, event * e24, midibyte channel)
 {
     automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    portshaper * ps = shaper(bus);
+    if (not_nullptr(ps))
+    {
+        ps->play(m_outbus_array, bus, *e24, channel);
+        ps->drain(m_outbus_array, bus);
+    }
+    else
+        m_outbus_array.play(bus, e24, channel);
+
     api_flush();
 }
 
+/**
+ *  Sends an event at once without locking the master buss, which the output
+ *  thread holds while it plays the patterns.  Only the buss itself is
+ *  locked.  Used for the MIDI Thru echo (see thruroutes::send()).  The
+ *  busses are created and removed only by the input thread (see port_start()
+ *  and port_exit()), which is the thread that calls this function.
+ *
+ *  A buss with a bandwidth shaper goes through play_and_flush(), since its
+ *  queues are protected by the master buss lock.
+ */
+
+void
+mastermidibase::play_direct (bussbyte bus, event * e24, midibyte channel)
+{
+    if (not_nullptr(shaper(bus)))
+        play_and_flush(bus, e24, channel);
+    else
+        m_outbus_array.play_direct(bus, e24, channel);
+}
+
 /**
  *  Set the clock for the given (legal) buss number.  The legality checks
  *  are a little loose, however.
@@ -768,9 +1043,10 @@ mastermidibase::api_poll_for_midi ()
  *  Test the sequencer to see if any more input is pending.  Calls the
  *  implementation-specific API function.
  *
- *  Note that the ALSA implementation calls a single "input-pending" function,
- *  while the PortMidi implementation loops through all of the input midibus
- *  objects, calling the poll_for_midi() function of each.
+ *  Note that the ALSA implementation drains its input FIFO in batches, and
+ *  reports the rest of the batch via api_input_pending(), without the lock
+ *  or a poll.  The PortMidi implementation loops through all of the input
+ *  midibus objects, calling the poll_for_midi() function of each.
  *
  * \threadsafe
  *
@@ -782,6 +1058,9 @@ mastermidibase::api_poll_for_midi ()
 bool
 mastermidibase::is_more_input ()
 {
+    if (api_input_pending() > 0)
+        return true;
+
     automutex locker(m_mutex);
     return m_inbus_array.poll_for_midi() > 0;
 }
@@ -834,6 +1113,7 @@ void
 mastermidibase::port_exit (int client, int port)
 {
     automutex locker(m_mutex);
+    release_shapers();                      /* before the port goes away    */
     m_outbus_array.port_exit(client, port);
     m_inbus_array.port_exit(client, port);
 }
@@ -953,6 +1233,10 @@ mastermidibase::set_sequence_input (bool state, sequence * seqp)
  *  sequence will get the events.  So now we add an additional call to the new
  *  sequence::channel_match() function.
  *
+ *  The performer's input thread no longer calls this function; it records
+ *  through the precompiled table of the recordroutes module, which follows
+ *  the same rules with one lookup per event.
+ *
  * \param ev
  *      The event that was recorded, passed as a copy.  (Do we really need a
  *      copy?)
@@ -988,6 +1272,20 @@ mastermidibase::dump_midi_input (event ev)
     return result;
 }
 
+/**
+ *  Gets a copy of the list of patterns used by dump_midi_input(), for
+ *  building the MIDI Thru routes.
+ *
+ * \threadsafe
+ */
+
+std::vector<sequence *>
+mastermidibase::input_sequences ()
+{
+    automutex locker(m_mutex);
+    return m_vector_sequence;
+}
+
 }           // namespace seq66
 
 /*
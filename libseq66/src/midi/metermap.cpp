@@ -0,0 +1,335 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          metermap.cpp
+ *
+ *  This module defines the time-signature map used for bar:beat:tick
+ *  conversions.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of metermap.hpp for the design.
+ */
+
+#include <algorithm>                    /* std::upper_bound()               */
+#include <cstdio>                       /* std::snprintf()                  */
+
+#include "cfg/usrsettings.hpp"          /* seq66::c_base_ppqn               */
+#include "midi/calculations.hpp"        /* default_pulses_per_measure()     */
+#include "midi/metermap.hpp"            /* seq66::metermap                  */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  Default constructor.  Creates a 4/4 map at the default PPQN.
+ */
+
+metermap::metermap () :
+    m_meters    (),
+    m_ppqn      (0)
+{
+    reset(c_base_ppqn, 4, 4);
+}
+
+metermap::metermap (int ppqn, int beats, int width) :
+    m_meters    (),
+    m_ppqn      (0)
+{
+    reset(ppqn, beats, width);
+}
+
+/**
+ *  Creates a meter, sanitizing the values so that the pulse sizes are never
+ *  0.
+ */
+
+metermap::meter
+metermap::make_meter (int ppqn, midipulse tick, int beats, int width)
+{
+    meter result;
+    if (ppqn <= 0)
+        ppqn = c_base_ppqn;
+
+    if (beats <= 0)
+        beats = 4;
+
+    if (width <= 0)
+        width = 4;
+
+    result.start = tick;
+    result.bar = 0;
+    result.beats_per_bar = beats;
+    result.beat_width = width;
+    result.beat_ticks = midipulse(default_pulses_per_measure(ppqn) / width);
+    if (result.beat_ticks <= 0)
+        result.beat_ticks = 1;
+
+    result.bar_ticks = result.beat_ticks * beats;
+    return result;
+}
+
+/**
+ *  Clears the map, leaving a single time signature starting at pulse 0.
+ */
+
+void
+metermap::reset (int ppqn, int beats, int width)
+{
+    m_ppqn = ppqn > 0 ? ppqn : c_base_ppqn ;
+    m_meters.clear();
+    m_meters.push_back(make_meter(m_ppqn, 0, beats, width));
+}
+
+/**
+ *  Adds a time signature, keeping the list sorted, and recounts the bars.
+ *  A time signature at the same pulse as an existing one replaces it.
+ *  Meant to be called while building the map, not per paint.
+ *
+ * \return
+ *      Returns false if the tick is negative.
+ */
+
+bool
+metermap::add (midipulse tick, int beats, int width)
+{
+    bool result = tick >= 0;
+    if (result)
+    {
+        meter m = make_meter(m_ppqn, tick, beats, width);
+        auto it = std::upper_bound
+        (
+            m_meters.begin(), m_meters.end(), tick,
+            [] (midipulse t, const meter & mt) { return t < mt.start; }
+        );
+        if (it != m_meters.begin() && (it - 1)->start == tick)
+            *(it - 1) = m;
+        else
+            (void) m_meters.insert(it, m);
+
+        recount_bars();
+    }
+    return result;
+}
+
+/**
+ *  Accumulates the starting bar of each meter.  A partial bar at the end of
+ *  a meter counts as a whole bar.
+ */
+
+void
+metermap::recount_bars ()
+{
+    int bar = 0;
+    for (std::size_t i = 0; i < m_meters.size(); ++i)
+    {
+        meter & m = m_meters[i];
+        if (i > 0)
+        {
+            const meter & prev = m_meters[i - 1];
+            midipulse span = m.start - prev.start;
+            bar = prev.bar + int((span + prev.bar_ticks - 1) / prev.bar_ticks);
+        }
+        m.bar = bar;
+    }
+}
+
+/**
+ *  Finds the meter in force at the given pulse.
+ */
+
+metermap::meters::const_iterator
+metermap::find_tick (midipulse p) const
+{
+    auto it = std::upper_bound
+    (
+        m_meters.cbegin(), m_meters.cend(), p,
+        [] (midipulse t, const meter & mt) { return t < mt.start; }
+    );
+    if (it != m_meters.cbegin())
+        --it;
+
+    return it;
+}
+
+const metermap::meter &
+metermap::at (midipulse p) const
+{
+    return *find_tick(p);
+}
+
+/**
+ *  Converts pulses to bar:beat:tick, all but the ticks numbered from 1.
+ *  Negative or null pulses are treated as 0.
+ */
+
+midi_measures
+metermap::to_measures (midipulse p) const
+{
+    if (p < 0)
+        p = 0;
+
+    const meter & m = at(p);
+    midipulse offset = p - m.start;
+    int bar = m.bar + int(offset / m.bar_ticks);
+    midipulse inbar = offset % m.bar_ticks;
+    int beat = int(inbar / m.beat_ticks);
+    int ticks = int(inbar % m.beat_ticks);
+    return midi_measures(bar + 1, beat + 1, ticks);
+}
+
+/**
+ *  Converts bar:beat:tick to pulses.  Bars and beats less than 1 are
+ *  treated as 1.
+ */
+
+midipulse
+metermap::to_pulses (const midi_measures & mm) const
+{
+    int bar = mm.measures() > 0 ? mm.measures() - 1 : 0 ;
+    int beat = mm.beats() > 0 ? mm.beats() - 1 : 0 ;
+    auto it = std::upper_bound
+    (
+        m_meters.cbegin(), m_meters.cend(), bar,
+        [] (int b, const meter & mt) { return b < mt.bar; }
+    );
+    if (it != m_meters.cbegin())
+        --it;
+
+    return it->start + midipulse(bar - it->bar) * it->bar_ticks +
+        midipulse(beat) * it->beat_ticks + mm.divisions();
+}
+
+/**
+ *  Formats pulses as "bar:beat:ticks", in the same way as
+ *  pulses_to_measurestring().
+ */
+
+std::string
+metermap::to_string (midipulse p) const
+{
+    midi_measures mm = to_measures(is_null_midipulse(p) ? 0 : p);
+    int width = 3;
+    if (m_ppqn >= 1000)
+    {
+        if (m_ppqn < 10000)
+            width = 4;
+        else if (m_ppqn < 100000)
+            width = 5;
+    }
+    char tmp[32];
+    (void) std::snprintf
+    (
+        tmp, sizeof tmp, "%03d:%d:%0*d",
+        mm.measures(), mm.beats(), width, mm.divisions()
+    );
+    return std::string(tmp);
+}
+
+/**
+ *  Returns the 1-based number of the bar holding the pulse.
+ */
+
+int
+metermap::bar_number (midipulse p) const
+{
+    if (p < 0)
+        p = 0;
+
+    const meter & m = at(p);
+    return m.bar + int((p - m.start) / m.bar_ticks) + 1;
+}
+
+/**
+ *  Returns the pulse at which the given 1-based bar starts.
+ */
+
+midipulse
+metermap::bar_start (int barnumber) const
+{
+    return to_pulses(midi_measures(barnumber, 1, 0));
+}
+
+/**
+ *  Returns the pulse of the beat holding the given pulse.
+ */
+
+midipulse
+metermap::beat_start (midipulse p) const
+{
+    if (p < 0)
+        p = 0;
+
+    const meter & m = at(p);
+    return p - (p - m.start) % m.beat_ticks;
+}
+
+/**
+ *  Returns the pulse of the next beat after the given pulse.  The start of
+ *  the next time signature is always a beat.  Used for drawing the grid.
+ */
+
+midipulse
+metermap::next_beat (midipulse p) const
+{
+    if (p < 0)
+        return 0;
+
+    auto it = find_tick(p);
+    midipulse result = beat_start(p) + it->beat_ticks;
+    auto next = it + 1;
+    if (next != m_meters.cend() && next->start < result)
+        result = next->start;
+
+    return result;
+}
+
+/**
+ *  Snaps a pulse down to the grid, measuring from the start of the time
+ *  signature in force, so that the grid stays aligned with the bars after
+ *  a change of meter.  With a single meter this is the same as
+ *  "p - p % snaplength".
+ */
+
+midipulse
+metermap::snap (midipulse p, midipulse snaplength) const
+{
+    if (snaplength <= 0 || p < 0)
+        return p;
+
+    const meter & m = at(p);
+    return p - (p - m.start) % snaplength;
+}
+
+}           // namespace seq66
+
+/*
+ * metermap.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
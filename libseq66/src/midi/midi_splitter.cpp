@@ -54,6 +54,7 @@ namespace seq66
 midi_splitter::midi_splitter () :
     m_smf0_channels_count   (0),
     m_smf0_channels         (),         /* array, initialized in parse()    */
+    m_smf0_event_counts     (),
     m_smf0_main_sequence    (nullptr),
     m_smf0_seq_number       (-1)
 {
@@ -70,14 +71,18 @@ midi_splitter::initialize ()
 {
     m_smf0_channels_count = 0;
     for (int i = 0; i < c_midichannel_max; ++i)
+    {
         m_smf0_channels[i] = false;
+        m_smf0_event_counts[i] = 0;
+    }
 }
 
 /**
  *  Processes a channel number by raising its flag in the m_smf0_channels[]
  *  array.  If it is the first entry for that channel, m_smf0_channels_count
- *  is incremented.  We won't check the channel number, to save time,
- *  until someday we segfault :-D
+ *  is incremented.  The event count for the channel is also incremented.
+ *  We won't check the channel number, to save time, until someday we
+ *  segfault :-D
  *
  * \param channel
  *      The MIDI channel number.  The caller is responsible to make sure it
@@ -92,6 +97,7 @@ midi_splitter::increment (int channel)
         m_smf0_channels[channel] = true;
         ++m_smf0_channels_count;
     }
+    ++m_smf0_event_counts[channel];
 }
 
 /**
@@ -143,6 +149,27 @@ midi_splitter::log_main_sequence (sequence & seq, int seqnum)
  *  one channel it contains.  In fact, we just want to keep it in pattern slot
  *  number 16, to keep it out of the way.
  *
+ *  The SMF 0 track is walked only once.  A sequence is created for each
+ *  channel found, sized by the event count logged by increment(), and each
+ *  event is appended to the sequence(s) it belongs to:
+ *
+ *      -   A channel event goes to the sequence for its channel.  An event
+ *          with no channel goes to every sequence.
+ *      -   A SysEx event goes to every sequence.
+ *      -   A Meta event (e.g. Set Tempo) goes to the channel 0 sequence, if
+ *          there is one.
+ *
+ *  Note that the events that are read from the MIDI file have delta times.
+ *  Seq66 converts these delta times to cumulative times.  We need to
+ *  preserve that here.  Conversion back to delta times is needed only when
+ *  saving the sequences to a file.  This is done in midi_vector_base::fill().
+ *  Since the main sequence is sorted, the length of each new sequence is the
+ *  time-stamp of the last event appended to it.  Each new sequence is then
+ *  sorted once.
+ *
+ *  Luckily, we don't have to worry about copying triggers, since the imported
+ *  SMF 0 track won't have any Seq24/Sequencer24 triggers.
+ *
  * \param p
  *      Provides a reference to the performer object into which sequences/tracks
  *      are to be added.
@@ -167,9 +194,12 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
     {
         if (m_smf0_channels_count > 0)
         {
-            int seqnum = screenset * usr().seqs_in_set();
-            for (int chan = 0; chan < c_midichannel_max; ++chan, ++seqnum)
+            sequence * seqs[c_midichannel_max];
+            midipulse lengths[c_midichannel_max];
+            for (int chan = 0; chan < c_midichannel_max; ++chan)
             {
+                seqs[chan] = nullptr;
+                lengths[chan] = 0;
                 if (m_smf0_channels[chan])
                 {
                     /*
@@ -178,8 +208,70 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
                      */
 
                     sequence * s = new sequence(ppqn);
-                    if (split_channel(p, *m_smf0_main_sequence, s, chan))
+                    setup_channel(p, *m_smf0_main_sequence, s, chan);
+                    s->reserve_events(m_smf0_event_counts[chan]);
+                    seqs[chan] = s;
+                }
+            }
+
+            const eventlist & evl = m_smf0_main_sequence->events();
+            for (auto i = evl.cbegin(); i != evl.cend(); ++i)
+            {
+                const event & er = eventlist::cdref(i);
+                midipulse ts = er.timestamp();
+                if (er.is_ex_data())
+                {
+                    if (er.is_sysex())
+                    {
+                        for (int chan = 0; chan < c_midichannel_max; ++chan)
+                        {
+                            if (not_nullptr(seqs[chan]))
+                            {
+                                (void) seqs[chan]->append_event(er);
+                                lengths[chan] = ts;
+                            }
+                        }
+                    }
+                    else if (not_nullptr(seqs[0]))
+                    {
+                        (void) seqs[0]->append_event(er);
+                        lengths[0] = ts;
+                    }
+                }
+                else if (is_null_channel(er.channel()))
+                {
+                    for (int chan = 0; chan < c_midichannel_max; ++chan)
+                    {
+                        if (not_nullptr(seqs[chan]))
+                        {
+                            (void) seqs[chan]->append_event(er);
+                            lengths[chan] = ts;
+                        }
+                    }
+                }
+                else
+                {
+                    int chan = int(er.channel());
+                    if (chan < c_midichannel_max && not_nullptr(seqs[chan]))
+                    {
+                        (void) seqs[chan]->append_event(er);
+                        lengths[chan] = ts;
+                    }
+                }
+            }
+
+            int seqnum = screenset * usr().seqs_in_set();
+            for (int chan = 0; chan < c_midichannel_max; ++chan, ++seqnum)
+            {
+                sequence * s = seqs[chan];
+                if (not_nullptr(s))
+                {
+                    if (s->event_count() > 0)
+                    {
+                        s->set_length(lengths[chan]);
+                        s->sort_events();
                         p.install_sequence(s, seqnum);
+                    }
                     else
                         delete s;   /* empty sequence, not even meta events */
                 }
@@ -192,48 +284,23 @@ midi_splitter::split (performer & p, int screenset, int ppqn)
 }
 
 /**
- *  This function splits the given sequence into a new sequence, for the given
- *  channel found in the SMF 0 track.  It is called for each possible channel,
- *  resulting in multiple passes over the SMF 0 track.
- *
- *  Note that the events that are read from the MIDI file have delta times.
- *  Seq66 converts these delta times to cumulative times.    We
- *  need to preserve that here.  Conversion back to delta times is needed only
- *  when saving the sequences to a file.  This is done in
- *  midi_vector_base::fill().
- *
- *  We have to accumulate the delta times in order to be able to set the
- *  length of the sequence in pulses.
- *
- *  Luckily, we don't have to worry about copying triggers, since the imported
- *  SMF 0 track won't have any Seq24/Sequencer24 triggers.
- *
- *  It doesn't set the sequence number of the sequence; that is set when the
- *  sequence is added to the performer object.
+ *  Makes the settings of a new sequence for the given channel found in the
+ *  SMF 0 track.  It doesn't set the sequence number of the sequence; that is
+ *  set when the sequence is added to the performer object.
  *
  * \param main_seq
  *      This parameter is the whole SMF 0 track that was read from the MIDI
- *      file.  It contains all of the channel data that needs to be split into
- *      separate sequences.
+ *      file.  It provides the name and buss of the new sequence.
  *
  * \param s
- *      Provides the new sequence that needs to have its settings made, and
- *      all of the selected channel events added to it.
+ *      Provides the new sequence that needs to have its settings made.
  *
  * \param channel
- *      Provides the MIDI channel number (re 0) that marks the channel data
- *      the needs to be extracted and added to the new sequence.  If this
- *      channel is 0, then we need to add certain Meta events to this
- *      sequence, as well.  So far we support only Tempo Meta events.
- *
- * \return
- *      Returns true if at least one event got added.   If none were added,
- *      the caller should delete the sequence object represented by parameter
- *      \a s.
+ *      Provides the MIDI channel number (re 0) of the new sequence.
  */
 
-bool
-midi_splitter::split_channel
+void
+midi_splitter::setup_channel
 (
     const performer & p,
     const sequence & main_seq,
@@ -241,7 +308,6 @@ midi_splitter::split_channel
     int channel
 )
 {
-    bool result = false;
     char tmp[32];
     if (main_seq.name().empty())
     {
@@ -265,38 +331,6 @@ midi_splitter::split_channel
     s->set_midi_channel(channel);
     s->set_midi_bus(main_seq.seq_midi_bus());
     s->zero_markers();
-
-    midipulse length_in_ticks = 0;      /* an accumulator of delta times    */
-    const eventlist & evl = main_seq.events();
-    for (auto i = evl.cbegin(); i != evl.cend(); ++i)
-    {
-        const event & er = eventlist::cdref(i);
-        if (er.is_ex_data())
-        {
-            if (channel == 0 || er.is_sysex())
-            {
-                length_in_ticks = er.timestamp();
-                if (s->append_event(er))    /* adds event, no sorting       */
-                    result = true;          /* the event got added          */
-            }
-        }
-        else if (er.match_channel(channel))
-        {
-            length_in_ticks = er.timestamp();
-            if (s->append_event(er))        /* adds event, no sorting       */
-                result = true;              /* the event got added          */
-        }
-    }
-
-    /*
-     * No triggers to add.  Whew!  And setting the length is now a no-brainer,
-     * since the tick value is that of the last logged event in the sequence.
-     * Also, sort all the events after they have been appended.
-     */
-
-    s->set_length(length_in_ticks);
-    s->sort_events();
-    return result;
 }
 
 }           // namespace seq66
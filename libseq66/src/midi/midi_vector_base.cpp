@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-10 (as midi_container.cpp)
- * \updates       2023-12-12
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This class is important when writing the MIDI and sequencer data out to a
@@ -53,6 +53,7 @@
             c_seq_color (performance colors for a sequence)
             c_seq_edit_mode (unused by Seq66)
             c_seq_loopcount
+            c_seq_reduction (recorded controller reduction)
             c_midiinbus (new)
 \endverbatim
  *
@@ -576,7 +577,7 @@ midi_vector_base::fill_proprietary ()
         if (seq::valid(seq().background_sequence()))
         {
             put_seqspec(c_backsequence, 4);
-            add_long(seq().background_sequence());
+            add_long(seq::to_file(seq().background_sequence()));
         }
     }
 
@@ -597,6 +598,14 @@ midi_vector_base::fill_proprietary ()
         put_seqspec(c_seq_loopcount, 2);                        /* short    */
         add_short(midishort(seq().loop_count_max()));
     }
+    if (seq().cc_reducer().active())
+    {
+        const ccreducer & ccr = seq().cc_reducer();
+        put_seqspec(c_seq_reduction, 4);                        /* 4 bytes  */
+        put(midibyte(ccr.get_method()));
+        put(midibyte(ccr.value()));
+        add_short(midishort(ccr.pulses()));
+    }
 }
 
 /**
@@ -803,10 +812,6 @@ midi_vector_base::song_fill_seq_trigger
  *      Provides the track number, re 0.  This number is masked into the track
  *      information.
  *
- * \param p
- *      The performance object that will hold some of the parameters needed
- *      when filling the MIDI container.  Not used!!!
- *
  * \param doseqspec
  *      If true (the default), writes out the SeqSpec information.  If false,
  *      we want to write out a regular MIDI track without this information; it
@@ -814,7 +819,7 @@ midi_vector_base::song_fill_seq_trigger
  */
 
 void
-midi_vector_base::fill (int track, const performer & /*p*/, bool doseqspec)
+midi_vector_base::fill (int track, bool doseqspec)
 {
     eventlist evl = seq().events();           /* used below */
     evl.sort();
@@ -462,6 +462,29 @@ midibase::play (const event * e24, midibyte channel)
     api_play(e24, channel);
 }
 
+/**
+ *  Sends an event at once, locking only this buss.  Used for the MIDI Thru
+ *  echo on the input thread, which must not wait for the master buss while
+ *  the output thread plays the patterns.  The API makes sure the event does
+ *  not go through an output buffer shared with the other busses (see
+ *  midi_alsa::api_play_direct()).
+ *
+ * \threadsafe
+ *
+ * \param e24
+ *      The event to be played on this bus.
+ *
+ * \param channel
+ *      The channel of the playback.
+ */
+
+void
+midibase::play_direct (const event * e24, midibyte channel)
+{
+    automutex locker(m_mutex);
+    api_play_direct(e24, channel);
+}
+
 /**
  *  Takes a native SYSEX event, encodes it to an ALSA event, and then
  *  puts it in the queue.
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-05-21
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the MIDI format, see, for example:
@@ -84,6 +84,7 @@
  *      -#  Any data bytes are ignored when the buffer is 0.
  */
 
+#include <cstdio>                       /* std::fopen(), std::rename()      */
 #include <fstream>                      /* std::ifstream and std::ofstream  */
 #include <memory>                       /* std::unique_ptr<>                */
 
@@ -96,6 +97,12 @@
 #include "util/filefunctions.hpp"       /* seq66::get_full_path()           */
 #include "util/palette.hpp"             /* seq66::palette_to_int(), colors  */
 
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <cstdlib>                      /* ::realpath(), std::free()        */
+#include <sys/stat.h>                   /* ::stat(), ::fchmod()             */
+#include <unistd.h>                     /* ::fsync()                        */
+#endif
+
 /*
  *  Do not document a namespace; it breaks Doxygen.
  */
@@ -137,13 +144,6 @@ static const size_t c_minimum_midi_file_size = 14;
 
 static const unsigned c_legacy_mute_group = 1024;           /* 0x0400       */
 
-/**
- *  A manifest constant for controlling the length of the stream buffering
- *  array in a MIDI file.
- */
-
-static const int c_midi_line_max = 1024;
-
 /**
  *  The maximum length of a Seq24/Seq66 track nam3.
  */
@@ -305,7 +305,12 @@ midifile::midifile
     m_ppqn                      (ppqn),                 /* can start as 0   */
     m_file_ppqn                 (0),                    /* can change       */
     m_ppqn_ratio                (1.0),                  /* for scaled()     */
-    m_smf0_splitter             ()
+    m_smf0_splitter             (),
+    m_song_values               (),
+    m_saved_tracks              (),
+    m_saved_format              (1),
+    m_saved_doseqspec           (true),
+    m_saved_seqspec             ()
 {
     // no other code needed
 }
@@ -866,7 +871,12 @@ midifile::parse (performer & p, int screenset, bool importing)
             return set_error_dump("Invalid MIDI header chunk detected", ID);
 
         midishort Format = read_short();                /* 0, 1, or 2       */
+        bool snapshot = Format == 1 && snapshot_allowed(screenset, importing);
         m_smf0_splitter.initialize();                   /* SMF 0 support    */
+        m_song_values = snapshot_song();
+        m_song_values.ppqn = ppqn();
+        m_song_values.default_ppqn = usr().default_ppqn();
+        m_song_values.use_file_ppqn = usr().use_file_ppqn() ? 1 : 0 ;
         if (Format == 0)
         {
             result = parse_smf_0(p, screenset);
@@ -874,7 +884,15 @@ midifile::parse (performer & p, int screenset, bool importing)
         }
         else if (Format == 1)
         {
-            result = parse_smf_1(p, screenset);
+            if (snapshot && load_snapshot(p))
+            {
+                snapshot = false;                       /* already current  */
+            }
+            else
+            {
+                result = parse_smf_1(p, screenset);
+                m_song_values.seqspec_offset = m_pos;
+            }
             p.smf_format(1);
         }
         else
@@ -894,6 +912,9 @@ midifile::parse (performer & p, int screenset, bool importing)
             }
             if (result && importing)
                  p.modify();                            /* modify flag      */
+
+            if (result && snapshot && m_error_message.empty())
+                save_snapshot(p);
         }
     }
     else
@@ -1146,19 +1167,7 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
     midishort track_count = read_short();
     midishort fileppqn = read_short();
     bool gotfirst_bpm = false;
-    file_ppqn(int(fileppqn));                       /* original file PPQN   */
-    if (usr().use_file_ppqn())
-    {
-        p.file_ppqn(file_ppqn());                   /* let performer know   */
-        ppqn(file_ppqn());                          /* PPQN == file PPQN    */
-        scaled(false);                              /* do not scale time    */
-    }
-    else
-    {
-        scaled(file_ppqn() != usr().default_ppqn());
-        if (scaled())
-            ppqn_ratio(double(ppqn()) / double(file_ppqn()));
-    }
+    setup_ppqn(p, fileppqn);
     if (rc().investigate())
     {
         infoprintf("Track count %d", int(track_count));
@@ -1394,6 +1403,9 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
                                             gotfirst_bpm = true;
                                             p.set_beats_per_minute(bpm);
                                             p.us_per_quarter_note(int(tt));
+                                            m_song_values.bpm = bpm;
+                                            m_song_values.us_per_quarter_note =
+                                                long(tt);
                                             s.us_per_quarter_note(int(tt));
                                         }
                                     }
@@ -1567,7 +1579,10 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
                             }
                             else if (seqspec == c_backsequence)
                             {
-                                s.background_sequence(int(read_long()));
+                                s.background_sequence
+                                (
+                                    seq::from_file(int(read_long()))
+                                );
                                 len -= 4;
                             }
                             else if (seqspec == c_transpose)
@@ -1585,6 +1600,21 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
                                 s.loop_count_max(int(read_short()));
                                 len -= 2;
                             }
+                            else if (seqspec == c_seq_reduction)
+                            {
+                                int m = int(read_byte());
+                                int v = int(read_byte());
+                                int p = int(read_short());
+                                len -= 4;
+                                if (m < int(ccreducer::method::max))
+                                {
+                                    s.cc_reduction
+                                    (
+                                        static_cast<ccreducer::method>(m),
+                                        v, midipulse(p)
+                                    );
+                                }
+                            }
                             else if (seqspec == c_mutegroups)
                             {
                                 /* handled in parse_seqspec_track() */
@@ -1643,7 +1673,10 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
                                         if (get_song_info)
                                         {
                                             got_song_info = true;
-                                            p.song_info(e.get_text());
+                                            m_song_values.song_info =
+                                                e.get_text();
+
+                                            p.song_info(m_song_values.song_info);
                                         }
                                         ++evcount;
                                     }
@@ -1743,7 +1776,10 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
             if (seqnum == c_midishort_max)
                 seqnum = track;
 
-            if (seqnum < c_prop_seq_number)
+            bool usable = seqnum < sequence::maximum() &&
+                ! sequence::is_reserved(seqnum);    /* not a SeqSpec track  */
+
+            if (usable)
             {
                 s.set_midi_channel(tentative_channel);
                 if (! is_null_buss(buss_override))
@@ -1783,6 +1819,104 @@ midifile::parse_smf_1 (performer & p, int screenset, bool is_smf0)
     return result;
 }
 
+/**
+ *  Sets up the PPQN of the patterns from the PPQN in the MIDI header and the
+ *  'usr' settings.
+ *
+ * \param p
+ *      The performer, which is told the file PPQN if it is to be used.
+ *
+ * \param fileppqn
+ *      The PPQN read from the MIDI header.
+ */
+
+void
+midifile::setup_ppqn (performer & p, midishort fileppqn)
+{
+    file_ppqn(int(fileppqn));                       /* original file PPQN   */
+    if (usr().use_file_ppqn())
+    {
+        p.file_ppqn(file_ppqn());                   /* let performer know   */
+        ppqn(file_ppqn());                          /* PPQN == file PPQN    */
+        scaled(false);                              /* do not scale time    */
+    }
+    else
+    {
+        scaled(file_ppqn() != usr().default_ppqn());
+        if (scaled())
+            ppqn_ratio(double(ppqn()) / double(file_ppqn()));
+    }
+}
+
+/**
+ *  A songsnapshot is used only for a full load of a song, without a buss
+ *  override, which the snapshot would otherwise bake into the patterns.
+ */
+
+bool
+midifile::snapshot_allowed (int screenset, bool importing) const
+{
+    return rc().song_snapshot() && ! importing && screenset == 0 &&
+        ! m_verify_mode && is_null_buss(usr().midi_buss_override());
+}
+
+/**
+ *  Tries to restore the patterns from the songsnapshot of this file.  On
+ *  success, the read position is moved to the SeqSpec track, which is
+ *  parsed as usual.  On failure, anything installed is cleared, and the
+ *  read position is restored for a normal parse.
+ *
+ * \param p
+ *      The performer to receive the patterns.
+ *
+ * \return
+ *      Returns true if the snapshot was used.
+ */
+
+bool
+midifile::load_snapshot (performer & p)
+{
+    size_t start = m_pos;                           /* at the track count   */
+    (void) read_short();                            /* track count          */
+    setup_ppqn(p, read_short());
+    m_song_values.effective_ppqn = ppqn();
+
+    songsnapshot snap(m_name);
+    bool result = snap.load(p, m_data, m_song_values);
+    if (result)
+    {
+        m_pos = m_song_values.seqspec_offset;
+        if (rc().verbose())
+            file_message("Loaded snapshot", snap.name());
+    }
+    else
+    {
+        if (p.sequence_count() > 0)
+            (void) p.clear_all();
+
+        m_pos = start;
+    }
+    return result;
+}
+
+/**
+ *  Writes the songsnapshot of the patterns just parsed.  A failure is only
+ *  reported; the next load simply parses the file again.
+ */
+
+void
+midifile::save_snapshot (performer & p)
+{
+    songsnapshot snap(m_name);
+    if (snap.write(p, m_data, m_song_values))
+    {
+        if (rc().verbose())
+            file_message("Saved snapshot", snap.name());
+    }
+    else
+        (void) file_error("Snapshot write failed", snap.name());
+}
+
 sequence *
 midifile::create_sequence (performer & p)
 {
@@ -2027,7 +2161,7 @@ midifile::parse_seqspec_track (performer & p, int file_size)
  *
  * Not handled:
  *
- *      c_gap_A to _F      c_reserved_3      c_reserved_4     c_seq_edit_mode
+ *      c_gap_A to _F      c_reserved_4      c_seq_edit_mode
  */
 
 bool
@@ -2065,7 +2199,7 @@ midifile::prop_header_loop (performer & p, int file_size)
              * case c_seq_color:
              * case c_seq_edit_mode:    (unhandled)
              * case c_seq_loopcount:
-             * case c_reserved_3:       (unhandled)
+             * case c_seq_reduction:
              * case c_reserved_4:       (unhandled)
              * case c_trig_transpose:
              */
@@ -2344,7 +2478,7 @@ midifile::parse_c_musicscale ()
 bool
 midifile::parse_c_backsequence ()
 {
-    int seqnum = int(read_long());
+    int seqnum = seq::from_file(int(read_long()));
     usr().seqedit_bgsequence(seqnum);
     return true;
 }
@@ -2882,117 +3016,185 @@ midifile::prop_item_size (long data_length) const
 
 bool
 midifile::write (performer & p, bool doseqspec)
+{
+    automutex locker(m_mutex);
+    midibytes data;
+    bool result = encode(p, data, doseqspec);
+    if (result)
+        result = write_file_data(m_name, data, m_error_message);
+
+    if (result)
+        p.unmodify();               /* it worked, tell performer about it   */
+
+    return result;
+}
+
+/**
+ *  Encodes the whole song, exactly as write() would save it, into a block of
+ *  bytes, without touching the disk.  It is simply snapshot() followed by
+ *  encode_snapshot().
+ *
+ * \param p
+ *      Provides the performance to encode.
+ *
+ * \param [out] data
+ *      Receives the bytes of the MIDI file.  Cleared first.
+ *
+ * \param doseqspec
+ *      If true (the default), the Seq66-specific SeqSpec sections are
+ *      included.
+ *
+ * \return
+ *      Returns true if the encoding succeeded.  If false is returned,
+ *      then m_error_message will contain a description of the error.
+ */
+
+bool
+midifile::encode (performer & p, midibytes & data, bool doseqspec)
+{
+    automutex locker(m_mutex);
+    data.clear();
+    bool result = snapshot(p, doseqspec);
+    if (result)
+        result = encode_snapshot(data);
+
+    return result;
+}
+
+/**
+ *  Takes what a save needs from the performer, as cheaply as possible, so
+ *  that the encoding can be done later by another thread (see the midisaver
+ *  class).  Each active pattern is copied with sequence::copy_for_save(),
+ *  which holds the pattern's lock only for the copy of its event list, and
+ *  shares the SysEx data.  The SeqSpec track (mute-groups, set names, and
+ *  so on) is small, and is encoded here.
+ *
+ * \param p
+ *      Provides the performance to save.
+ *
+ * \param doseqspec
+ *      If true (the default), the Seq66-specific SeqSpec sections are
+ *      included.
+ *
+ * \return
+ *      Returns true if there is something to save.  If false is returned,
+ *      then m_error_message will contain a description of the error.
+ */
+
+bool
+midifile::snapshot (performer & p, bool doseqspec)
 {
     automutex locker(m_mutex);
     bool result = usr().is_ppqn_valid(m_ppqn);
+    m_saved_tracks.clear();
+    m_saved_seqspec.clear();
     m_error_message.clear();
-    if (! result)
-        m_error_message = "Invalid PPQN for MIDI file to write.";
-
     if (result)
     {
-        int numtracks = 0;
         int sequencehigh = p.sequence_high();
         if (rc().verbose())
         {
             infoprintf("Highest track is %d", sequencehigh - 1);
         }
-        for (int i = 0; i < sequencehigh; ++i)
+        for (int track = 0; track < sequencehigh; ++track)
         {
-            if (p.is_seq_active(i))
-                ++numtracks;             /* count number of active tracks   */
+            if (p.is_seq_active(track))
+            {
+                seq::pointer s = p.get_sequence(track);
+                if (s)
+                {
+                    seq::pointer copy = std::make_shared<sequence>
+                    (
+                        s->get_ppqn()
+                    );
+                    copy->copy_for_save(*s);
+                    m_saved_tracks.push_back(copy);
+                }
+            }
         }
-        result = numtracks > 0;
+        result = ! m_saved_tracks.empty();
         if (result)
         {
-            int smfformat = p.smf_format();
-            bool result = write_header(numtracks, smfformat);
-            if (result)
+            m_saved_format = p.smf_format();
+            m_saved_doseqspec = doseqspec;
+            if (doseqspec)
             {
-                std::string temp = "Writing ";
-                temp += doseqspec ? "Seq66" : "Normal" ;
-                temp += " SMF ";
-                temp += std::to_string(smfformat);
-                temp += " MIDI file ";
-                temp += std::to_string(m_ppqn);
-                temp += " PPQN";
-                file_message(temp, m_name);
+                result = write_seqspec_track(p);
+                if (result)
+                    m_saved_seqspec.swap(m_char_list);
+                else
+                    m_error_message = "Could not write SeqSpec.";
             }
-            else
-                m_error_message = "Failed to write header to MIDI file.";
         }
         else
             m_error_message = "No patterns/tracks to write.";
     }
+    else
+        m_error_message = "Invalid PPQN for MIDI file to write.";
 
-    /*
-     * Write out the active tracks.
-     * Note that we don't need to check the sequence pointer.
-     */
+    m_char_list.clear();
+    return result;
+}
+
+/**
+ *  Encodes the song taken by snapshot().  It uses only the copies, so it
+ *  can be called from another thread while the performer is edited.
+ *
+ * \param [out] data
+ *      Receives the bytes of the MIDI file.  Cleared first.
+ *
+ * \return
+ *      Returns true if the encoding succeeded.  If false is returned,
+ *      then m_error_message will contain a description of the error.
+ */
 
+bool
+midifile::encode_snapshot (midibytes & data)
+{
+    automutex locker(m_mutex);
+    int numtracks = int(m_saved_tracks.size());
+    bool result = numtracks > 0;
+    data.clear();
+    m_char_list.clear();
     if (result)
     {
-        for (int track = 0; track < p.sequence_high(); ++track)
+        result = write_header(numtracks, m_saved_format);
+        if (result)
         {
-            if (p.is_seq_active(track))
-            {
-                seq::pointer s = p.get_sequence(track);
-                if (s)
-                {
-                    sequence & seq = *s;
-                    midi_vector lst(seq);
-
-                    /*
-                     * midi_vector_base::fill() also handles the time-signature
-                     * and tempo meta events, if they are not part of the
-                     * file's MIDI data.  All the events are put into the
-                     * container, and then the container's bytes are written
-                     * out below.
-                     */
-
-                    lst.fill(track, p, doseqspec);
-                    write_track(lst);
-                }
-            }
+            std::string temp = "Writing ";
+            temp += m_saved_doseqspec ? "Seq66" : "Normal" ;
+            temp += " SMF ";
+            temp += std::to_string(m_saved_format);
+            temp += " MIDI file ";
+            temp += std::to_string(m_ppqn);
+            temp += " PPQN";
+            file_message(temp, m_name);
         }
+        else
+            m_error_message = "Failed to write header to MIDI file.";
     }
-    if (result && doseqspec)
-    {
-        result = write_seqspec_track(p);
-        if (! result)
-            m_error_message = "Could not write SeqSpec.";
-    }
+    else
+        m_error_message = "No patterns/tracks to write.";
+
     if (result)
     {
-        std::ofstream file
-        (
-            m_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
-        );
-        if (file.is_open())
+        for (auto & s : m_saved_tracks)
         {
-            char file_buffer[c_midi_line_max];      /* enable bufferization */
-            file.rdbuf()->pubsetbuf(file_buffer, sizeof file_buffer);
-            for (auto c : m_char_list)              /* list of midibytes    */
-            {
-                char kc = char(c);
-                file.write(&kc, 1);
-                if (file.fail())
-                {
-                    m_error_message = "Error writing byte.";
-                    result = false;
-                }
-            }
-            m_char_list.clear();
+            midi_vector lst(*s);
+            lst.fill(s->seq_number(), m_saved_doseqspec);
+            write_track(lst);
         }
-        else
+        if (m_saved_doseqspec)
         {
-            m_error_message = "Failed to open MIDI file for writing.";
-            result = false;
+            m_char_list.insert
+            (
+                m_char_list.end(),
+                m_saved_seqspec.begin(), m_saved_seqspec.end()
+            );
         }
+        data.swap(m_char_list);
     }
-    if (result)
-        p.unmodify();               /* it worked, tell performer about it   */
-
+    m_char_list.clear();
     return result;
 }
 
@@ -3122,28 +3324,99 @@ midifile::write_song (performer & p)
         }
     }
     if (result)
+        result = write_file_data(m_name, m_char_list, m_error_message);
+
+    m_char_list.clear();
+    return result;
+}
+
+/**
+ *  Writes a block of file data to a temporary file next to the destination,
+ *  flushes it to the disk, then renames it to the destination.  An
+ *  interrupted or failed write therefore never leaves a truncated MIDI file
+ *  behind, and a reader (or the songsnapshot check) never sees a
+ *  half-written one.  This function uses no midifile members, so that the
+ *  midisaver thread can call it with the bytes made by encode().
+ *
+ *  If the destination is a symbolic link, the file it points to is the one
+ *  replaced, so the link survives.  The permissions of an existing file are
+ *  given to the temporary file before the rename.
+ *
+ * \param filename
+ *      The full path to the destination file.
+ *
+ * \param data
+ *      The bytes to write.
+ *
+ * \param [out] errmsg
+ *      Set to a description of the error, if any.
+ *
+ * \return
+ *      Returns true if the file was written and renamed.
+ */
+
+bool
+midifile::write_file_data
+(
+    const std::string & filename,
+    const midibytes & data,
+    std::string & errmsg
+)
+{
+    std::string target = filename;
+#if defined SEQ66_PLATFORM_POSIX_API
+    struct stat st;
+    bool exists = ::stat(filename.c_str(), &st) == 0;
+    if (exists)
     {
-        std::ofstream file
-        (
-            m_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc
-        );
-        if (file.is_open())
+        char * real = ::realpath(filename.c_str(), nullptr);
+        if (not_nullptr(real))
         {
-            char file_buffer[c_midi_line_max];      /* enable bufferization */
-            file.rdbuf()->pubsetbuf(file_buffer, sizeof file_buffer);
-            for (auto c : m_char_list)
-            {
-                char kc = char(c);
-                file.write(&kc, 1);
-            }
-            m_char_list.clear();
+            target = real;                          /* resolve any symlink  */
+            std::free(real);
         }
-        else
-        {
-            m_error_message = "Failed to open MIDI file for export.";
+    }
+#endif
+
+    std::string tempname = target + ".tmp";
+    std::FILE * file = std::fopen(tempname.c_str(), "wb");
+    bool result = not_nullptr(file);
+    if (result)
+    {
+        size_t count = data.size();
+        if (count > 0)
+            result = std::fwrite(data.data(), 1, count, file) == count;
+
+        if (result)
+            result = std::fflush(file) == 0;
+
+#if defined SEQ66_PLATFORM_POSIX_API
+        if (result && exists)
+            result = ::fchmod(fileno(file), st.st_mode & 07777) == 0;
+
+        if (result)
+            result = ::fsync(fileno(file)) == 0;
+#endif
+
+        if (std::fclose(file) != 0)
             result = false;
+
+        if (result)
+        {
+#if defined SEQ66_PLATFORM_WINDOWS
+            (void) file_delete(target);             /* rename() won't replace */
+#endif
+            result = std::rename(tempname.c_str(), target.c_str()) == 0;
+        }
+        if (! result)
+        {
+            errmsg = "Error writing MIDI file.";
+            (void) file_delete(tempname);
         }
     }
+    else
+        errmsg = "Failed to open MIDI file for writing.";
+
     return result;
 }
 
@@ -3278,7 +3551,7 @@ midifile::write_seqspec_track (performer & p)
         write_seqspec_header(c_musicscale, 1);           /* control tag+1   */
         write_byte(midibyte(usr().seqedit_scale()));     /* scale change    */
         write_seqspec_header(c_backsequence, 4);         /* control tag+4   */
-        write_long(long(usr().seqedit_bgsequence()));    /* background      */
+        write_long(long(seq::to_file(usr().seqedit_bgsequence()))); /* bg */
     }
     write_seqspec_header(c_perf_bp_mes, 4);              /* control tag+4   */
     write_long(long(p.get_beats_per_bar()));             /* perfedit BPM    */
@@ -3665,6 +3938,7 @@ write_midi_file
     {
         bool glob = usr().global_seq_feature();
         midifile f(fname, p.ppqn(), glob);
+        p.compact_patterns();                       /* a good time for it   */
         result = f.write(p);
         if (result)
         {
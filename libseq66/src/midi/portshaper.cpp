@@ -0,0 +1,515 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          portshaper.cpp
+ *
+ *  This module defines the bandwidth model used to shape the output of
+ *  slow (DIN or serial) MIDI ports.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of portshaper.hpp for the design.
+ */
+
+#include <algorithm>                    /* std::fill()                      */
+#include <cstdio>                       /* std::sscanf(), std::snprintf()   */
+
+#include "midi/businfo.hpp"             /* seq66::busarray                  */
+#include "midi/portshaper.hpp"          /* seq66::portshaper                */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The lowest rate accepted, in bytes per second.  Anything slower is not a
+ *  MIDI port.
+ */
+
+static const int c_bandwidth_min = 100;
+
+/**
+ *  The burst allowed, in milliseconds of wire time.  Small enough that a
+ *  note is never stuck behind much controller data in the driver.
+ */
+
+static const int c_burst_ms = 3;
+
+/*
+ * class bandwidthlist
+ */
+
+bandwidthlist::bandwidthlist () : m_settings ()
+{
+    // no code
+}
+
+/**
+ *  Adds or replaces the settings for a buss.
+ *
+ * \return
+ *      Returns false if the buss or the rate is out of range.
+ */
+
+bool
+bandwidthlist::add (bussbyte bus, const setting & s)
+{
+    bool result = is_good_buss(bus) && s.bytes_per_second >= c_bandwidth_min;
+    if (result)
+        m_settings[bus] = s;
+
+    return result;
+}
+
+/**
+ *  Parses a line of the form
+ *
+ *      1  3125  1  1
+ *
+ *  giving the output buss, the rate in bytes per second, the "thin" flag,
+ *  and the "running-status" flag.  The flags are optional, and default to
+ *  1.
+ */
+
+bool
+bandwidthlist::add_list_line (const std::string & line)
+{
+    int bus = -1;
+    int rate = 0;
+    int thin = 1;
+    int running = 1;
+    int count = std::sscanf
+    (
+        line.c_str(), "%d %d %d %d", &bus, &rate, &thin, &running
+    );
+    bool result = count >= 2 && bus >= 0;
+    if (result)
+    {
+        setting s;
+        s.bytes_per_second = rate;
+        s.thin = thin != 0;
+        s.running_status = running != 0;
+        result = add(bussbyte(bus), s);
+    }
+    return result;
+}
+
+std::string
+bandwidthlist::io_list_lines () const
+{
+    std::string result;
+    for (const auto & sp : m_settings)
+    {
+        char temp[64];
+        (void) std::snprintf
+        (
+            temp, sizeof temp, "%2d %6d %d %d\n", int(sp.first),
+            sp.second.bytes_per_second,
+            sp.second.thin ? 1 : 0, sp.second.running_status ? 1 : 0
+        );
+        result += temp;
+    }
+    return result;
+}
+
+/*
+ * class portshaper
+ */
+
+portshaper::portshaper (const bandwidthlist::setting & s) :
+    m_setting           (s),
+    m_credit            (0.0),
+    m_burst             (0.0),
+    m_last_refill       (clock::now()),
+    m_start             (m_last_refill),
+    m_running_status    (0),
+    m_urgent            (),
+    m_continuous        (),
+    m_last_values       (c_midichannel_max * c_key_count, short(-1)),
+    m_messages          (0),
+    m_bytes             (0),
+    m_saved_bytes       (0),
+    m_delayed           (0),
+    m_thinned           (0),
+    m_backlog           (0),
+    m_peak_backlog      (0),
+    m_max_delay_us      (0)
+{
+    if (m_setting.bytes_per_second < c_bandwidth_min)
+        m_setting.bytes_per_second = c_bandwidth_min;
+
+    m_burst = double(m_setting.bytes_per_second) * c_burst_ms / 1000.0;
+    if (m_burst < 3.0)
+        m_burst = 3.0;                          /* one whole message        */
+
+    m_credit = m_burst;
+}
+
+/**
+ *  Adds the budget earned since the last refill, up to the burst size.
+ */
+
+void
+portshaper::refill ()
+{
+    clock::time_point now = clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>
+    (
+        now - m_last_refill
+    ).count();
+    m_last_refill = now;
+    m_credit += double(us) * m_setting.bytes_per_second / 1000000.0;
+    if (m_credit > m_burst)
+        m_credit = m_burst;
+}
+
+/**
+ *  The thinning key of a continuous event, or -1 for an urgent event.
+ *  Bank Select, the pedals (64 to 69), and the Channel Mode messages (120
+ *  to 127) are urgent, because they must stay in order with the notes.
+ */
+
+int
+portshaper::thin_key (const event & ev)
+{
+    int result = -1;
+    midibyte status = event::mask_status(ev.get_status());
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+    switch (status)
+    {
+    case EVENT_CONTROL_CHANGE:
+
+        if (d0 != 0 && d0 != 32 && (d0 < 64 || d0 > 69) && d0 < 120)
+            result = int(d0);
+        break;
+
+    case EVENT_PITCH_WHEEL:
+
+        result = 128;
+        break;
+
+    case EVENT_CHANNEL_PRESSURE:
+
+        result = 129;
+        break;
+
+    case EVENT_AFTERTOUCH:
+
+        result = 130 + int(d0);
+        break;
+    }
+    return result;
+}
+
+/**
+ *  The value of a continuous event, for detecting repeats.
+ */
+
+int
+portshaper::thin_value (const event & ev)
+{
+    midibyte d0, d1;
+    ev.get_data(d0, d1);
+    midibyte status = event::mask_status(ev.get_status());
+    if (status == EVENT_PITCH_WHEEL)
+        return int(d0) + (int(d1) << 7);
+    else if (status == EVENT_CHANNEL_PRESSURE)
+        return int(d0);
+    else
+        return int(d1);
+}
+
+/**
+ *  The size of a message on the wire, leaving out the status byte if it
+ *  repeats the running status.
+ */
+
+int
+portshaper::message_size (const event & ev, midibyte channel) const
+{
+    midibyte status = ev.get_status(channel);
+    int result = event::is_one_byte_msg(status) ? 2 : 3 ;
+    if (m_setting.running_status && status == m_running_status)
+        --result;
+
+    return result;
+}
+
+/**
+ *  Sends an event, charging its size to the budget, and remembering its
+ *  value for thinning.  A SysEx message also cancels the running status.
+ */
+
+void
+portshaper::send
+(
+    busarray & outs, bussbyte bus,
+    const event & ev, midibyte channel, int key
+)
+{
+    if (key == c_sysex_key)
+    {
+        int size = int(ev.sysex_size());
+        outs.sysex(bus, &ev);
+        m_credit -= double(size);
+        m_bytes += size;
+        ++m_messages;
+        m_running_status = 0;
+        return;
+    }
+
+    midibyte status = ev.get_status(channel);
+    int size = message_size(ev, channel);
+    if (m_setting.running_status)
+    {
+        if (status == m_running_status)
+            ++m_saved_bytes;
+        else
+            m_running_status = status;
+    }
+    outs.play(bus, &ev, channel);
+    m_credit -= double(size);
+    m_bytes += size;
+    ++m_messages;
+    if (key >= 0)
+    {
+        int index = int(channel & 0x0F) * c_key_count + key;
+        m_last_values[index] = short(thin_value(ev));
+    }
+}
+
+void
+portshaper::enqueue
+(
+    std::deque<item> & q, const event & ev,
+    midibyte channel, int key, int size
+)
+{
+    item it;
+    it.queued = clock::now();
+    it.channel = channel;
+    it.key = key;
+    it.size = size;
+    it.ev = ev;
+    q.push_back(it);
+    ++m_delayed;
+    m_backlog += size;
+    if (m_backlog > m_peak_backlog)
+        m_peak_backlog = m_backlog;
+}
+
+/**
+ *  Sends an event now if there is budget left and nothing of the same or
+ *  higher priority is waiting; otherwise queues it.  If thinning is on, a
+ *  continuous event replaces the queued value of its controller, if any;
+ *  otherwise it is dropped if it repeats the last value sent.  The queue
+ *  is checked first, so that a value that returns to the last one sent
+ *  still overrides the value waiting in the queue.
+ *
+ *  Called by the master buss with its mutex locked.
+ */
+
+void
+portshaper::play
+(
+    busarray & outs, bussbyte bus, const event & ev, midibyte channel
+)
+{
+    refill();
+    int key = thin_key(ev);
+    if (key < 0)
+    {
+        if (m_urgent.empty() && m_credit > 0.0)
+            send(outs, bus, ev, channel, key);
+        else
+            enqueue(m_urgent, ev, channel, key, message_size(ev, channel));
+    }
+    else
+    {
+        if (m_setting.thin)
+        {
+            for (auto & it : m_continuous)
+            {
+                if (it.key == key && it.channel == channel)
+                {
+                    it.ev = ev;             /* keep its place in the queue  */
+                    ++m_thinned;
+                    return;
+                }
+            }
+
+            int index = int(channel & 0x0F) * c_key_count + key;
+            if (m_last_values[index] == short(thin_value(ev)))
+            {
+                ++m_thinned;                /* nothing queued, a repeat     */
+                return;
+            }
+        }
+        if (! pending() && m_credit > 0.0)
+            send(outs, bus, ev, channel, key);
+        else
+            enqueue(m_continuous, ev, channel, key, message_size(ev, channel));
+    }
+}
+
+/**
+ *  Sends queued events while there is budget, oldest first.
+ *
+ * \param all
+ *      If true, the budget is ignored and the whole queue is sent.
+ */
+
+void
+portshaper::send_queued
+(
+    busarray & outs, bussbyte bus, std::deque<item> & q, bool all
+)
+{
+    clock::time_point now = m_last_refill;
+    while (! q.empty() && (all || m_credit > 0.0))
+    {
+        const item & it = q.front();
+        long us = long
+        (
+            std::chrono::duration_cast<std::chrono::microseconds>
+            (
+                now - it.queued
+            ).count()
+        );
+        if (us > m_max_delay_us)
+            m_max_delay_us = us;
+
+        m_backlog -= it.size;
+        send(outs, bus, it.ev, it.channel, it.key);
+        q.pop_front();
+    }
+}
+
+/**
+ *  Sends what the budget allows, urgent events first.  Called at each flush
+ *  of the master buss, and once per output cycle (see
+ *  mastermidibase::drain_bandwidth()).
+ */
+
+void
+portshaper::drain (busarray & outs, bussbyte bus)
+{
+    if (pending())
+    {
+        refill();
+        send_queued(outs, bus, m_urgent);
+        if (m_urgent.empty())
+            send_queued(outs, bus, m_continuous);
+
+        if (! pending())
+            m_backlog = 0;
+    }
+}
+
+/**
+ *  Sends all of the queued events now, urgent events first, whatever the
+ *  budget.  Used when playback stops, at panic, and when a port goes away,
+ *  so that no Note Off is left waiting.
+ */
+
+void
+portshaper::release (busarray & outs, bussbyte bus)
+{
+    if (pending())
+    {
+        refill();
+        send_queued(outs, bus, m_urgent, true);
+        send_queued(outs, bus, m_continuous, true);
+        m_backlog = 0;
+    }
+}
+
+/**
+ *  Sends a SysEx message now if there is budget left and no urgent event
+ *  is waiting; otherwise queues it behind the urgent events, so that it
+ *  cannot overtake queued notes.  Its size is charged to the budget, so
+ *  that the events after it wait for it to go out.
+ */
+
+void
+portshaper::sysex (busarray & outs, bussbyte bus, const event & ev)
+{
+    refill();
+    if (m_urgent.empty() && m_credit > 0.0)
+        send(outs, bus, ev, 0, c_sysex_key);
+    else
+        enqueue(m_urgent, ev, 0, c_sysex_key, int(ev.sysex_size()));
+}
+
+/**
+ *  Drops the queued events and forgets the running status and the last
+ *  values.  Used by panic, after release(), since panic turns all the notes
+ *  off anyway.
+ */
+
+void
+portshaper::clear ()
+{
+    m_urgent.clear();
+    m_continuous.clear();
+    m_backlog = 0;
+    m_running_status = 0;
+    std::fill(m_last_values.begin(), m_last_values.end(), short(-1));
+}
+
+/**
+ *  Returns one line of the saturation report.  The load is the bytes sent
+ *  compared to what the wire could carry since the shaper was created.
+ */
+
+std::string
+portshaper::report (bussbyte bus) const
+{
+    double secs = std::chrono::duration<double>(clock::now() - m_start).count();
+    double capacity = secs * m_setting.bytes_per_second;
+    double load = capacity > 0.0 ? 100.0 * double(m_bytes) / capacity : 0.0 ;
+    char temp[256];
+    (void) std::snprintf
+    (
+        temp, sizeof temp,
+        "%3d %7d %10lu %10lu %8lu %8lu %8lu %7d %7.1f %5.1f%%%s\n",
+        int(bus), m_setting.bytes_per_second, m_messages, m_bytes,
+        m_saved_bytes, m_delayed, m_thinned, m_peak_backlog,
+        double(m_max_delay_us) / 1000.0, load,
+        saturated() ? "  saturated" : ""
+    );
+    return std::string(temp);
+}
+
+}           // namespace seq66
+
+/*
+ * portshaper.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
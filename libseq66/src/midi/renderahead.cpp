@@ -0,0 +1,307 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          renderahead.cpp
+ *
+ *  This module defines the render-ahead output queue of the master buss.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of renderahead.hpp.
+ */
+
+#include <algorithm>                    /* std::upper_bound()               */
+
+#include "midi/mastermidibase.hpp"      /* seq66::mastermidibase            */
+#include "midi/renderahead.hpp"         /* seq66::renderahead               */
+#include "util/basic_macros.hpp"        /* seq66::infoprintf()              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The longest look-ahead allowed, in milliseconds.  Longer than this, the
+ *  Note Offs kept by invalidate() could be noticeably late after a tempo
+ *  change.
+ */
+
+static const int c_max_lookahead_ms = 500;
+
+renderahead::renderahead (mastermidibase & mmb) :
+    m_master        (mmb),
+    m_thread        (),
+    m_mutex         (),
+    m_cv            (),
+    m_queue         (),
+    m_due           (),
+    m_serial        (0),
+    m_kept_offs     (0),
+    m_lookahead_ms  (0),
+    m_exit          (false)
+{
+    // no code
+}
+
+renderahead::~renderahead ()
+{
+    stop();
+}
+
+/**
+ *  Starts the dispatch thread.
+ *
+ * \param lookahead_ms
+ *      The look-ahead period, clamped to c_max_lookahead_ms.
+ *
+ * \return
+ *      Returns true if the thread was started.
+ */
+
+bool
+renderahead::start (int lookahead_ms)
+{
+    bool result = lookahead_ms > 0 && ! active();
+    if (result)
+    {
+        if (lookahead_ms > c_max_lookahead_ms)
+            lookahead_ms = c_max_lookahead_ms;
+
+        m_lookahead_ms = lookahead_ms;
+        m_exit = false;
+        m_thread = std::thread(&renderahead::dispatch_func, this);
+        infoprintf("Render-ahead of %d ms started", lookahead_ms);
+    }
+    return result;
+}
+
+/**
+ *  Stops the dispatch thread.  Pending Note Offs are sent first.
+ */
+
+void
+renderahead::stop ()
+{
+    if (active())
+    {
+        release();
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_exit = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+    }
+}
+
+/**
+ *  Adds an event to the queue.  Events usually arrive in time order, so the
+ *  insertion point is normally at the end.
+ *
+ * \param bus
+ *      The true output buss.
+ *
+ * \param ev
+ *      The event, already prepared for sending.
+ *
+ * \param channel
+ *      The output channel.
+ *
+ * \param delay_us
+ *      The time from now until the event is due, in microseconds.  If not
+ *      positive, the event is sent as soon as possible.
+ *
+ *  A Note Off replaces the Note Off for the same note kept by invalidate(),
+ *  if any.
+ */
+
+void
+renderahead::schedule
+(
+    bussbyte bus, const event & ev, midibyte channel, long delay_us
+)
+{
+    item i;
+    i.when = clock::now();
+    if (delay_us > 0)
+        i.when += std::chrono::microseconds(delay_us);
+
+    i.bus = bus;
+    i.channel = channel;
+    i.kept = false;
+    i.ev = ev;
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_kept_offs > 0 && ev.is_note_off())
+            drop_kept_off(i);
+
+        i.serial = m_serial++;
+        auto pos = std::upper_bound(m_queue.begin(), m_queue.end(), i);
+        wake = pos == m_queue.begin();          /* new earliest due time    */
+        m_queue.insert(pos, i);
+    }
+    if (wake)
+        m_cv.notify_one();
+}
+
+/**
+ *  Removes the first kept Note Off for the same buss, channel, and note as
+ *  the given Note Off.  The caller holds the mutex.
+ */
+
+void
+renderahead::drop_kept_off (const item & i)
+{
+    midibyte note = i.ev.get_note();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+        if (it->kept && it->bus == i.bus && it->channel == i.channel)
+        {
+            if (it->ev.get_note() == note)
+            {
+                (void) m_queue.erase(it);
+                --m_kept_offs;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ *  Drops all queued events except the Note Offs, which are marked as kept.
+ *  The caller re-renders the patterns from the current pulse.  The Note
+ *  Offs it renders again replace the kept ones (see schedule()).
+ *
+ * \return
+ *      Returns the number of events dropped.
+ */
+
+int
+renderahead::invalidate ()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto keep = std::stable_partition
+    (
+        m_queue.begin(), m_queue.end(),
+        [] (const item & i) { return i.ev.is_note_off(); }
+    );
+    int result = int(m_queue.end() - keep);
+    m_queue.erase(keep, m_queue.end());
+    for (auto & i : m_queue)
+        i.kept = true;
+
+    m_kept_offs = int(m_queue.size());
+    return result;
+}
+
+/**
+ *  Sends all queued Note Offs now and drops the other events.  Used when
+ *  playback stops.
+ */
+
+void
+renderahead::release ()
+{
+    std::vector<item> offs;
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (const auto & i : m_queue)
+        {
+            if (i.ev.is_note_off())
+                offs.push_back(i);
+        }
+        m_queue.clear();
+        m_kept_offs = 0;
+    }
+    send(offs);
+}
+
+/**
+ *  The dispatch thread.  It sleeps until the earliest event is due (or a
+ *  new earlier event is scheduled), then sends all of the events that are
+ *  due with a single flush.
+ */
+
+void
+renderahead::dispatch_func ()
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (;;)
+    {
+        if (m_exit)
+            break;
+
+        if (m_queue.empty())
+        {
+            m_cv.wait(lk);
+            continue;
+        }
+
+        clock::time_point due = m_queue.front().when;
+        if (clock::now() < due)
+        {
+            (void) m_cv.wait_until(lk, due);
+            continue;
+        }
+
+        clock::time_point now = clock::now();
+        m_due.clear();
+        while (! m_queue.empty() && m_queue.front().when <= now)
+        {
+            if (m_queue.front().kept)
+                --m_kept_offs;
+
+            m_due.push_back(m_queue.front());
+            m_queue.pop_front();
+        }
+        lk.unlock();
+        send(m_due);
+        lk.lock();
+    }
+}
+
+void
+renderahead::send (std::vector<item> & items)
+{
+    if (! items.empty())
+    {
+        for (auto & i : items)
+            m_master.play(i.bus, &i.ev, i.channel);
+
+        m_master.flush();
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * renderahead.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,235 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sharedbytes.cpp
+ *
+ *  This module defines the copy-on-write SysEx and Meta payload holder and
+ *  its store.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of sharedbytes.hpp for the design.
+ */
+
+#include <mutex>                        /* std::mutex, std::lock_guard<>    */
+#include <unordered_map>                /* std::unordered_multimap<>        */
+
+#include "midi/sharedbytes.hpp"         /* seq66::sharedbytes               */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The store of shared payloads, keyed by the hash of the bytes.  Expired
+ *  entries are removed when found, and in a sweep whenever the store has
+ *  doubled in size since the last sweep.
+ */
+
+using bytestore = std::unordered_multimap
+<
+    std::size_t, std::weak_ptr<midibytes>
+>;
+
+static bytestore &
+byte_store ()
+{
+    static bytestore s_store;
+    return s_store;
+}
+
+static std::mutex &
+byte_store_mutex ()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+static std::size_t s_sweep_size = 256;
+
+/**
+ *  An FNV-1a hash of the bytes.  Good enough for short texts and long dumps
+ *  alike.
+ */
+
+static std::size_t
+hash_bytes (const midibytes & b)
+{
+    std::size_t result = 2166136261U;
+    for (auto byte : b)
+    {
+        result ^= std::size_t(byte);
+        result *= 16777619U;
+    }
+    return result ^ b.size();
+}
+
+/**
+ *  Removes the expired entries of the store.  The caller locks the mutex.
+ */
+
+static void
+sweep_store (bytestore & store)
+{
+    for (auto it = store.begin(); it != store.end(); /* in body */)
+    {
+        if (it->second.expired())
+            it = store.erase(it);
+        else
+            ++it;
+    }
+    s_sweep_size = 2 * store.size();
+    if (s_sweep_size < 256)
+        s_sweep_size = 256;
+}
+
+/**
+ *  The shared empty payload returned by bytes() when there are no bytes.
+ */
+
+static const midibytes &
+empty_bytes ()
+{
+    static const midibytes s_empty;
+    return s_empty;
+}
+
+sharedbytes::sharedbytes () :
+    m_bytes     (),
+    m_shared    (false)
+{
+    // no code
+}
+
+/**
+ *  Provides read-only access to the bytes, shared or not.  Safe to use in
+ *  the output thread.
+ */
+
+const midibytes &
+sharedbytes::bytes () const
+{
+    return m_bytes ? *m_bytes : empty_bytes() ;
+}
+
+/**
+ *  Provides writable access to the bytes.  If they are in the store, or
+ *  used by another event, a private copy is made first.
+ */
+
+midibytes &
+sharedbytes::edit ()
+{
+    if (! m_bytes)
+        m_bytes = std::make_shared<midibytes>();
+    else if (m_shared || m_bytes.use_count() > 1)
+        m_bytes = std::make_shared<midibytes>(*m_bytes);
+
+    m_shared = false;
+    return *m_bytes;
+}
+
+/**
+ *  Replaces the bytes with an identical payload from the store, if there is
+ *  one, or else adds them to the store (without unused capacity).  Meant to
+ *  be called when the payload is complete.
+ */
+
+void
+sharedbytes::share ()
+{
+    if (m_shared || empty())
+        return;
+
+    std::lock_guard<std::mutex> locker(byte_store_mutex());
+    bytestore & store = byte_store();
+    std::size_t key = hash_bytes(*m_bytes);
+    auto range = store.equal_range(key);
+    for (auto it = range.first; it != range.second; /* in body */)
+    {
+        pointer p = it->second.lock();
+        if (p)
+        {
+            if (*p == *m_bytes)
+            {
+                m_bytes = p;
+                m_shared = true;
+                return;
+            }
+            ++it;
+        }
+        else
+            it = store.erase(it);
+    }
+    m_bytes->shrink_to_fit();
+    (void) store.emplace(key, m_bytes);
+    m_shared = true;
+    if (store.size() > s_sweep_size)
+        sweep_store(store);
+}
+
+/**
+ *  Estimates the heap memory used by the bytes.  A shared payload is
+ *  divided among its users, so that the sum over all events is about
+ *  right.
+ */
+
+std::size_t
+sharedbytes::memory () const
+{
+    std::size_t result = 0;
+    if (m_bytes)
+    {
+        long users = m_bytes.use_count();
+        result = m_bytes->capacity();
+        if (users > 1)
+            result /= std::size_t(users);
+    }
+    return result;
+}
+
+/**
+ *  Returns the number of distinct payloads in the store, for
+ *  troubleshooting.
+ */
+
+std::size_t
+sharedbytes::store_count ()
+{
+    std::lock_guard<std::mutex> locker(byte_store_mutex());
+    bytestore & store = byte_store();
+    sweep_store(store);
+    return store.size();
+}
+
+}           // namespace seq66
+
+/*
+ * sharedbytes.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
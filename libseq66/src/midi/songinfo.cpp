@@ -0,0 +1,405 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songinfo.cpp
+ *
+ *  This module defines the detached song-file scanner.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of songinfo.hpp.  The scanner is deliberately more
+ *  lenient than midifile::parse(): it only needs to find the chunks and
+ *  step over the events correctly.
+ */
+
+#include <cstdio>                       /* std::snprintf()                  */
+#include <cstring>                      /* std::memcmp()                    */
+#include <fstream>                      /* std::ifstream                    */
+
+#include "cfg/settings.hpp"             /* seq66::choose_ppqn()             */
+#include "midi/songinfo.hpp"            /* seq66::songinfo                  */
+#include "midi/wrkfile.hpp"             /* seq66::wrkfile                   */
+#include "util/filefunctions.hpp"       /* seq66::file_size(), etc.         */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The FNV-1a 64-bit parameters.
+ */
+
+static const songinfo::hash_t c_fnv_offset = 14695981039346656037ULL;
+static const songinfo::hash_t c_fnv_prime = 1099511628211ULL;
+
+/**
+ *  How far into the file to look for "MThd", to allow for an RMID (RIFF)
+ *  wrapper.
+ */
+
+static const size_t c_header_search = 64;
+
+static unsigned
+get_long (const midibyte * p)
+{
+    return (unsigned(p[0]) << 24) | (unsigned(p[1]) << 16) |
+        (unsigned(p[2]) << 8) | unsigned(p[3]);
+}
+
+static unsigned
+get_short (const midibyte * p)
+{
+    return (unsigned(p[0]) << 8) | unsigned(p[1]);
+}
+
+/**
+ *  Detects the Seq66 SeqSpec track, which starts with a Sequence Number of
+ *  0x3FFF (or 0x7777 in old files).  The midifile parser reads that track
+ *  tag by tag, and older versions did not always write exact SeqSpec or
+ *  chunk lengths, so it is not stepped through here.
+ */
+
+static bool
+is_seqspec_track (const midibyte * p, size_t len)
+{
+    bool result = len >= 6 && p[0] == 0 && p[1] == 0xFF &&
+        p[2] == 0x00 && p[3] == 0x02;
+
+    if (result)
+    {
+        unsigned seqnum = get_short(p + 4);
+        result = seqnum == 0x3FFF || seqnum == 0x7777;
+    }
+    return result;
+}
+
+/**
+ *  Reads a variable-length value.
+ *
+ * \param [in,out] p
+ *      The read position, advanced past the value.
+ *
+ * \param end
+ *      The end of the track data.
+ *
+ * \param [out] value
+ *      The value.
+ *
+ * \return
+ *      Returns false if the value is truncated or longer than 4 bytes.
+ */
+
+static bool
+get_varinum (const midibyte * & p, const midibyte * end, midilong & value)
+{
+    value = 0;
+    for (int count = 0; count < 4; ++count)
+    {
+        if (p >= end)
+            return false;
+
+        midibyte c = *p++;
+        value = (value << 7) | (c & 0x7F);
+        if ((c & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+songinfo::songinfo () :
+    m_file_size     (0),
+    m_mod_time      (0),
+    m_hash          (0),
+    m_format        (0),
+    m_track_count   (0),
+    m_ppqn          (0),
+    m_length        (0),
+    m_bpm           (0.0),
+    m_error         ()
+{
+    // no code
+}
+
+/**
+ *  Reads and summarizes a song file.  Safe to call from any thread, as long
+ *  as each thread uses its own songinfo object.
+ *
+ * \param filepath
+ *      The full path to the song file.
+ *
+ * \return
+ *      Returns true if the file could be read and its structure is sane.
+ *      Otherwise error() describes the problem.
+ */
+
+bool
+songinfo::scan (const std::string & filepath)
+{
+    *this = songinfo();
+    m_mod_time = file_modification_time(filepath);
+
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (! file.is_open())
+        return set_error("cannot open file");
+
+    std::vector<midibyte> data
+    (
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>()
+    );
+    m_file_size = data.size();
+    m_hash = hash_data(data);
+    if (data.size() >= 8 && std::memcmp(data.data(), "CAKEWALK", 8) == 0)
+    {
+        wrkfile f(filepath, choose_ppqn());
+        m_format = (-1);
+        if (f.scan(*this))
+            return true;
+
+        std::string msg = f.error_message();
+        return set_error(msg.empty() ? std::string("bad WRK file") : msg);
+    }
+    return scan_smf(data);
+}
+
+/**
+ *  Calculates the FNV-1a hash of a file's bytes.  Also used by the
+ *  songsnapshot class to check that a snapshot matches its MIDI file.
+ */
+
+songinfo::hash_t
+songinfo::hash_data (const std::vector<midibyte> & data)
+{
+    hash_t result = c_fnv_offset;
+    for (midibyte b : data)
+    {
+        result ^= hash_t(b);
+        result *= c_fnv_prime;
+    }
+    return result;
+}
+
+/**
+ *  Indicates if the summary still applies to the file, judging by its size
+ *  and modification time.
+ */
+
+bool
+songinfo::current (const std::string & filepath) const
+{
+    return m_file_size > 0 &&
+        seq66::file_size(filepath) == m_file_size &&
+        file_modification_time(filepath) == m_mod_time;
+}
+
+/**
+ *  Returns a one-line description for the user-interface.
+ */
+
+std::string
+songinfo::summary () const
+{
+    std::string result;
+    if (! valid())
+    {
+        result = "Error: " + m_error;
+    }
+    else if (m_format < 0)
+    {
+        char temp[128];
+        (void) std::snprintf
+        (
+            temp, sizeof temp,
+            "WRK, %d tracks, PPQN %d, %ld pulses, %.2f BPM",
+            m_track_count, m_ppqn, m_length, m_bpm
+        );
+        result = temp;
+    }
+    else
+    {
+        char temp[128];
+        (void) std::snprintf
+        (
+            temp, sizeof temp,
+            "SMF %d, %d tracks, PPQN %d, %ld pulses, %.2f BPM",
+            m_format, m_track_count, m_ppqn, m_length, m_bpm
+        );
+        result = temp;
+    }
+    return result;
+}
+
+bool
+songinfo::scan_smf (const std::vector<midibyte> & data)
+{
+    size_t limit = data.size() < c_header_search ?
+        data.size() : c_header_search ;
+
+    size_t offset = 0;
+    for ( ; offset + 4 <= limit; ++offset)
+    {
+        if (std::memcmp(&data[offset], "MThd", 4) == 0)
+            break;
+    }
+    if (offset + 14 > data.size())
+        return set_error("no MThd header");
+
+    const midibyte * p = &data[offset];
+    const midibyte * end = data.data() + data.size();
+    unsigned hdrlen = get_long(p + 4);
+    if (hdrlen < 6 || size_t(end - p) - 8 < hdrlen)
+        return set_error("bad MThd length");
+
+    unsigned division = get_short(p + 12);
+    m_format = int(get_short(p + 8));
+    m_ppqn = (division & 0x8000) != 0 ? 0 : int(division) ;
+    if (m_format > 2)
+        return set_error("unsupported SMF format");
+
+    p += 8 + hdrlen;
+    while (end - p >= 8)
+    {
+        unsigned len = get_long(p + 4);
+        const midibyte * body = p + 8;
+        size_t avail = size_t(end - body);
+        bool mtrk = std::memcmp(p, "MTrk", 4) == 0;
+        if (mtrk && is_seqspec_track(body, avail))
+        {
+            ++m_track_count;
+            break;                                  /* always the last one  */
+        }
+        if (avail < len)
+            return set_error("truncated chunk");
+
+        if (mtrk)
+        {
+            ++m_track_count;
+            if (! scan_track(body, body + len))
+                return false;
+        }
+        p = body + len;
+    }
+    if (m_track_count == 0)
+        return set_error("no MTrk chunks");
+
+    return true;
+}
+
+/**
+ *  Steps through the events of one track, tracking the end pulse and the
+ *  first tempo.
+ */
+
+bool
+songinfo::scan_track (const midibyte * p, const midibyte * end)
+{
+    midipulse tick = 0;
+    midibyte running = 0;                           /* running status       */
+    while (p < end)
+    {
+        midilong delta;
+        if (! get_varinum(p, end, delta))
+            return set_error("bad delta time");
+
+        tick += midipulse(delta);
+        if (p >= end)
+            return set_error("truncated event");
+
+        /*
+         * A meta event leaves the running status alone.  Some files use
+         * running status after a SysEx, too, so it is not cleared there,
+         * as in the "recover" running-status action of the midifile class.
+         */
+
+        midibyte status = running;
+        if ((*p & 0x80) != 0)
+        {
+            status = *p++;
+            if (status < 0xF0)
+                running = status;
+        }
+        else if (running == 0)
+            return set_error("data byte without status");
+
+        if (status == 0xFF)
+        {
+            if (p >= end)
+                return set_error("truncated meta event");
+
+            midibyte metatype = *p++;
+            midilong len;
+            if (! get_varinum(p, end, len) || midilong(end - p) < len)
+                return set_error("truncated meta event");
+
+            if (metatype == 0x51 && len == 3 && m_bpm == 0.0)
+            {
+                double us = double((p[0] << 16) | (p[1] << 8) | p[2]);
+                if (us > 0.0)
+                    m_bpm = 60000000.0 / us;
+            }
+            p += len;
+            if (metatype == 0x2F)
+                break;                              /* End of Track         */
+        }
+        else if (status == 0xF0 || status == 0xF7)
+        {
+            midilong len;
+            if (! get_varinum(p, end, len) || midilong(end - p) < len)
+                return set_error("truncated SysEx");
+
+            p += len;
+        }
+        else
+        {
+            midibyte hi = status & 0xF0;
+            int count = (hi == 0xC0 || hi == 0xD0) ? 1 : 2 ;
+            if (end - p < count)
+                return set_error("truncated channel event");
+
+            p += count;
+        }
+    }
+    if (tick > m_length)
+        m_length = tick;
+
+    return true;
+}
+
+bool
+songinfo::set_error (const std::string & msg)
+{
+    m_error = msg;
+    return false;
+}
+
+}           // namespace seq66
+
+/*
+ * songinfo.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,620 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          songsnapshot.cpp
+ *
+ *  This module defines the binary snapshot of the patterns of a MIDI file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  Layout of a snapshot file.  Every record is a multiple of 8 bytes, and
+ *  every string or byte blob is padded to 8 bytes, so that the records can
+ *  be used in place in the mapped file:
+ *
+ *      -   snap_header, then the song-info text.
+ *      -   For each pattern: snap_sequence, the pattern name, the
+ *          snap_trigger records, the snap_event records, then the SysEx
+ *          and Meta data of the events, in event order.
+ *
+ *  An event's link is the index of the linked event in the same pattern,
+ *  or -1.
+ */
+
+#include <cstring>                      /* std::memcmp(), std::memcpy()     */
+#include <fstream>                      /* std::ifstream                    */
+#include <iterator>                     /* std::istreambuf_iterator<>       */
+#include <new>                          /* std::nothrow                     */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "midi/midifile.hpp"            /* midifile::write_file_data()      */
+#include "midi/songsnapshot.hpp"        /* seq66::songsnapshot              */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "util/filefunctions.hpp"       /* seq66::file_extension_set()      */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <fcntl.h>                      /* ::open(), O_RDONLY               */
+#include <sys/mman.h>                   /* ::mmap(), ::munmap()             */
+#include <sys/stat.h>                   /* ::fstat()                        */
+#include <unistd.h>                     /* ::close()                        */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The identification and version of a snapshot file.  Bump the version
+ *  whenever a record changes.
+ */
+
+static const char s_snapshot_magic [8] = { 'S', 'e', 'q', '6', '6', 'S', 'n', 'p' };
+static const std::uint32_t s_snapshot_version = 1;
+static const std::uint32_t s_byte_order = 0x01020304;
+
+/**
+ *  The records of the snapshot file.  See the banner.
+ */
+
+struct snap_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t midi_size;
+    std::uint64_t midi_hash;
+    std::int32_t ppqn;
+    std::int32_t default_ppqn;
+    std::int32_t use_file_ppqn;
+    std::int32_t sequence_count;
+    std::int64_t us_per_quarter_note;
+    double bpm;
+    std::uint64_t seqspec_offset;
+    std::uint32_t song_info_size;
+    std::uint32_t reserved;
+};
+
+struct snap_sequence
+{
+    std::int64_t length;
+    std::int64_t us_per_quarter_note;
+    std::int32_t seq_number;
+    std::int32_t name_size;
+    std::int32_t event_count;
+    std::int32_t trigger_count;
+    std::int32_t sysex_size;
+    std::int32_t beats_per_bar;
+    std::int32_t beat_width;
+    std::int32_t clocks_per_metronome;
+    std::int32_t thirtyseconds;
+    std::int32_t color;
+    std::int32_t loop_count_max;
+    std::int32_t background;
+    std::uint8_t channel;
+    std::uint8_t bus;
+    std::uint8_t in_bus;
+    std::uint8_t key;
+    std::uint8_t scale;
+    std::uint8_t transposable;
+    std::uint8_t reserved[2];
+};
+
+struct snap_trigger
+{
+    std::int64_t tick_start;
+    std::int64_t tick_end;
+    std::int64_t offset;
+    std::int32_t transpose;
+    std::int32_t reserved;
+};
+
+struct snap_event
+{
+    std::int64_t timestamp;
+    std::int32_t link;
+    std::uint32_t sysex_size;
+    std::uint8_t status;
+    std::uint8_t channel;
+    std::uint8_t d0;
+    std::uint8_t d1;
+    std::uint8_t input_buss;
+    std::uint8_t reserved[3];
+};
+
+/**
+ *  Rounds a size up to a multiple of 8.
+ */
+
+static size_t
+padded (size_t sz)
+{
+    return (sz + 7) & ~size_t(7);
+}
+
+/**
+ *  Appends a record or blob, padded to 8 bytes, to the file data.
+ */
+
+static void
+write_padded (midibytes & file, const void * data, size_t sz)
+{
+    const midibyte * bytes = static_cast<const midibyte *>(data);
+    if (sz > 0)
+        file.insert(file.end(), bytes, bytes + sz);
+
+    file.resize(file.size() + padded(sz) - sz, 0);
+}
+
+songsnapshot::songsnapshot (const std::string & midifilename) :
+    m_name      (snapshot_name(midifilename)),
+    m_data      (nullptr),
+    m_size      (0),
+    m_pos       (0),
+    m_buffer    ()
+{
+    // no code
+}
+
+songsnapshot::~songsnapshot ()
+{
+    unmap_file();
+}
+
+std::string
+songsnapshot::snapshot_name (const std::string & midifilename)
+{
+    return file_extension_set(midifilename, ".snap");
+}
+
+/**
+ *  Saves the patterns currently in the performer, which must have just been
+ *  loaded from the MIDI file.  The data is built in memory and written by
+ *  midifile::write_file_data(), which writes a temporary file and renames
+ *  it, so a failed write leaves the old snapshot (if any) intact.
+ *
+ * \param p
+ *      The performer holding the loaded patterns.
+ *
+ * \param mididata
+ *      The bytes of the MIDI file, for the size and hash.
+ *
+ * \param song
+ *      The song-level values set by the tracks.
+ *
+ * \return
+ *      Returns true if the snapshot was written.
+ */
+
+bool
+songsnapshot::write
+(
+    performer & p,
+    const std::vector<midibyte> & mididata,
+    const snapshot_song & song
+)
+{
+    std::vector<seq::pointer> seqs;
+    for (int seqno = 0; seqno < p.sequence_high(); ++seqno)
+    {
+        seq::pointer s = p.get_sequence(seqno);
+        if (s && s->is_normal_seq())
+            seqs.push_back(s);
+    }
+
+    midibytes file;
+    snap_header h;
+    std::memset(&h, 0, sizeof h);
+    std::memcpy(h.magic, s_snapshot_magic, sizeof h.magic);
+    h.version = s_snapshot_version;
+    h.byte_order = s_byte_order;
+    h.midi_size = mididata.size();
+    h.midi_hash = songinfo::hash_data(mididata);
+    h.ppqn = song.ppqn;
+    h.default_ppqn = song.default_ppqn;
+    h.use_file_ppqn = song.use_file_ppqn;
+    h.sequence_count = std::int32_t(seqs.size());
+    h.us_per_quarter_note = song.us_per_quarter_note;
+    h.bpm = song.bpm;
+    h.seqspec_offset = song.seqspec_offset;
+    h.song_info_size = std::uint32_t(song.song_info.size());
+    write_padded(file, &h, sizeof h);
+    write_padded(file, song.song_info.data(), song.song_info.size());
+    for (const auto & s : seqs)
+    {
+        const eventlist & evl = s->events();
+        auto trigs = s->get_triggers();
+        const std::string & name = s->name();
+        snap_sequence ss;
+        std::memset(&ss, 0, sizeof ss);
+        ss.length = s->get_length();
+        ss.us_per_quarter_note = s->us_per_quarter_note();
+        ss.seq_number = s->seq_number();
+        ss.name_size = std::int32_t(name.size());
+        ss.event_count = evl.count();
+        ss.trigger_count = std::int32_t(trigs.size());
+        ss.beats_per_bar = s->get_beats_per_bar();
+        ss.beat_width = s->get_beat_width();
+        ss.clocks_per_metronome = s->clocks_per_metronome();
+        ss.thirtyseconds = s->get_32nds_per_quarter();
+        ss.color = s->color();
+        ss.loop_count_max = s->loop_count_max();
+        ss.background = seq::to_file(s->background_sequence());
+        ss.channel = s->seq_midi_channel();
+        ss.bus = s->seq_midi_bus();
+        ss.in_bus = s->seq_midi_in_bus();
+        ss.key = s->musical_key();
+        ss.scale = s->musical_scale();
+        ss.transposable = s->transposable() ? 1 : 0 ;
+
+        std::vector<snap_event> events;
+        std::vector<midibyte> sysex;
+        events.reserve(size_t(ss.event_count));
+        const event * base = ss.event_count > 0 ? &(*evl.cbegin()) : nullptr ;
+        for (auto ei = evl.cbegin(); ei != evl.cend(); ++ei)
+        {
+            const event & e = *ei;
+            snap_event se;
+            std::memset(&se, 0, sizeof se);
+            se.timestamp = e.m_timestamp;
+            se.link = (-1);
+            if (e.is_linked())
+            {
+                long index = long(&(*e.link()) - base);
+                if (index >= 0 && index < long(ss.event_count))
+                    se.link = std::int32_t(index);
+            }
+            se.sysex_size = std::uint32_t(e.m_sysex.size());
+            se.status = e.m_status;
+            se.channel = e.m_channel;
+            se.d0 = e.m_data[0];
+            se.d1 = e.m_data[1];
+            se.input_buss = e.m_input_buss;
+            events.push_back(se);
+            const midibytes & ex = e.m_sysex.bytes();
+            sysex.insert(sysex.end(), ex.begin(), ex.end());
+        }
+        ss.sysex_size = std::int32_t(sysex.size());
+        write_padded(file, &ss, sizeof ss);
+        write_padded(file, name.data(), name.size());
+        for (const auto & t : trigs)
+        {
+            snap_trigger st;
+            std::memset(&st, 0, sizeof st);
+            st.tick_start = t.tick_start();
+            st.tick_end = t.tick_end();
+            st.offset = t.offset();
+            st.transpose = t.transpose_byte();
+            write_padded(file, &st, sizeof st);
+        }
+        if (! events.empty())
+            write_padded(file, events.data(), events.size() * sizeof(snap_event));
+
+        write_padded(file, sysex.data(), sysex.size());
+    }
+    std::string errmsg;
+    return midifile::write_file_data(m_name, file, errmsg);
+}
+
+/**
+ *  Maps the snapshot file read-only, or reads it on platforms without
+ *  mmap().
+ */
+
+bool
+songsnapshot::map_file ()
+{
+    unmap_file();
+#if defined SEQ66_PLATFORM_POSIX_API
+    int fd = ::open(m_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size >= off_t(sizeof(snap_header)))
+    {
+        void * addr = ::mmap
+        (
+            nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0
+        );
+        if (addr != MAP_FAILED)
+        {
+            m_data = static_cast<const midibyte *>(addr);
+            m_size = size_t(st.st_size);
+        }
+    }
+    ::close(fd);                                /* the mapping stays valid  */
+#else
+    std::ifstream file(m_name, std::ios::in | std::ios::binary);
+    if (file.is_open())
+    {
+        m_buffer.assign
+        (
+            (std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>()
+        );
+        if (m_buffer.size() >= sizeof(snap_header))
+        {
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+    }
+#endif
+    m_pos = 0;
+    return not_nullptr(m_data);
+}
+
+void
+songsnapshot::unmap_file ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (not_nullptr(m_data))
+        (void) ::munmap(const_cast<midibyte *>(m_data), m_size);
+#else
+    m_buffer.clear();
+#endif
+    m_data = nullptr;
+    m_size = m_pos = 0;
+}
+
+/**
+ *  Returns a pointer to the next record or blob and skips past it and its
+ *  padding, or returns null if the file is too short.
+ */
+
+const midibyte *
+songsnapshot::take (size_t bytes)
+{
+    size_t left = m_size - m_pos;
+    if (bytes > left)                           /* also avoids overflow     */
+        return nullptr;
+
+    size_t sz = padded(bytes);
+    if (sz > left)
+        return nullptr;
+
+    const midibyte * result = m_data + m_pos;
+    m_pos += sz;
+    return result;
+}
+
+/**
+ *  Takes an array of records whose count was read from the file.  A
+ *  negative count, or one larger than the bytes left, means the file is
+ *  corrupt, and null is returned without skipping anything.
+ *
+ * \param count
+ *      The number of records, as read from the file.
+ *
+ * \param size
+ *      The size of one record, 1 for a string or byte blob.
+ */
+
+const midibyte *
+songsnapshot::take (std::int64_t count, size_t size)
+{
+    if (count < 0 || size == 0 || size_t(count) > (m_size - m_pos) / size)
+        return nullptr;
+
+    return take(size_t(count) * size);
+}
+
+/**
+ *  Loads the patterns from the snapshot, if it matches the MIDI file and
+ *  the current PPQN settings.
+ *
+ * \param p
+ *      The performer, already cleared, to receive the patterns.
+ *
+ * \param mididata
+ *      The bytes of the MIDI file.
+ *
+ * \param [inout] song
+ *      On input, holds the PPQN settings in force (ppqn, default_ppqn,
+ *      use_file_ppqn, and effective_ppqn).  On output, holds the rest of the
+ *      song values.
+ *
+ * \return
+ *      Returns true if all of the patterns were installed.  If false, and
+ *      any patterns might have been installed, the caller must clear them.
+ */
+
+bool
+songsnapshot::load
+(
+    performer & p,
+    const std::vector<midibyte> & mididata,
+    snapshot_song & song
+)
+{
+    if (! map_file())
+        return false;
+
+    const snap_header * h = reinterpret_cast<const snap_header *>
+    (
+        take(sizeof(snap_header))
+    );
+    bool result = not_nullptr(h) &&
+        std::memcmp(h->magic, s_snapshot_magic, sizeof h->magic) == 0 &&
+        h->version == s_snapshot_version && h->byte_order == s_byte_order &&
+        h->midi_size == mididata.size() && h->ppqn == song.ppqn &&
+        h->default_ppqn == song.default_ppqn &&
+        h->use_file_ppqn == song.use_file_ppqn &&
+        h->seqspec_offset <= mididata.size();
+
+    if (result)
+        result = h->midi_hash == songinfo::hash_data(mididata);
+
+    const midibyte * info = result ? take(h->song_info_size) : nullptr ;
+    if (is_nullptr(info))
+        return false;
+
+    song.us_per_quarter_note = long(h->us_per_quarter_note);
+    song.bpm = h->bpm;
+    song.seqspec_offset = size_t(h->seqspec_offset);
+    song.song_info.assign
+    (
+        reinterpret_cast<const char *>(info), size_t(h->song_info_size)
+    );
+    if (! song.song_info.empty())
+        p.song_info(song.song_info);            /* before track 0 exists    */
+
+    if (song.bpm > 0.0)
+    {
+        p.set_beats_per_minute(midibpm(song.bpm));
+        p.us_per_quarter_note(song.us_per_quarter_note);
+    }
+    for (int i = 0; i < h->sequence_count; ++i)
+    {
+        if (! read_sequence(p, song.effective_ppqn))
+            return false;
+    }
+    return true;
+}
+
+/**
+ *  Rebuilds one pattern from the snapshot and installs it, skipping the
+ *  sorting and linking.
+ */
+
+bool
+songsnapshot::read_sequence (performer & p, int ppqn)
+{
+    const snap_sequence * ss = reinterpret_cast<const snap_sequence *>
+    (
+        take(sizeof(snap_sequence))
+    );
+    if (is_nullptr(ss))
+        return false;
+
+    const midibyte * name = take(ss->name_size, 1);
+    if (is_nullptr(name))
+        return false;
+
+    const snap_trigger * trigs = reinterpret_cast<const snap_trigger *>
+    (
+        take(ss->trigger_count, sizeof(snap_trigger))
+    );
+    if (is_nullptr(trigs))
+        return false;
+
+    const snap_event * events = reinterpret_cast<const snap_event *>
+    (
+        take(ss->event_count, sizeof(snap_event))
+    );
+    if (is_nullptr(events))
+        return false;
+
+    const midibyte * sysex = take(ss->sysex_size, 1);
+    if (is_nullptr(sysex))
+        return false;
+
+    sequence * sp = new (std::nothrow) sequence(ppqn);
+    if (is_nullptr(sp))
+        return false;
+
+    sequence & s = *sp;
+    mastermidibus * masterbus = p.master_bus();
+    if (not_nullptr(masterbus))
+        s.set_master_midi_bus(masterbus);
+
+    s.set_name(std::string(reinterpret_cast<const char *>(name), ss->name_size));
+    s.set_length(midipulse(ss->length), false, false);
+    s.us_per_quarter_note(long(ss->us_per_quarter_note));
+    s.clocks_per_metronome(int(ss->clocks_per_metronome));
+    s.set_32nds_per_quarter(int(ss->thirtyseconds));
+    s.set_beats_per_bar(int(ss->beats_per_bar));
+    s.set_beat_width(int(ss->beat_width));
+    (void) s.set_midi_bus(ss->bus);
+    (void) s.set_midi_in_bus(ss->in_bus);
+    (void) s.set_midi_channel(ss->channel);
+    s.musical_key(int(ss->key));
+    s.musical_scale(int(ss->scale));
+    (void) s.background_sequence(seq::from_file(int(ss->background)));
+    s.set_transposable(ss->transposable != 0);
+    (void) s.set_color(int(ss->color));
+    (void) s.loop_count_max(int(ss->loop_count_max));
+    for (int t = 0; t < ss->trigger_count; ++t)
+    {
+        const snap_trigger & st = trigs[t];
+        (void) s.add_trigger
+        (
+            midipulse(st.tick_start), midipulse(st.tick_end - st.tick_start + 1),
+            midipulse(st.offset), midibyte(st.transpose), false
+        );
+    }
+
+    event::buffer evs(size_t(ss->event_count));
+    std::vector<int> links(size_t(ss->event_count));
+    size_t sxpos = 0;
+    bool result = true;
+    for (int i = 0; i < ss->event_count; ++i)
+    {
+        const snap_event & se = events[i];
+        event & e = evs[size_t(i)];
+        e.m_timestamp = midipulse(se.timestamp);
+        e.m_status = se.status;
+        e.m_channel = se.channel;
+        e.m_data[0] = se.d0;
+        e.m_data[1] = se.d1;
+        e.m_input_buss = se.input_buss;
+        if (se.sysex_size > 0)
+        {
+            if (size_t(se.sysex_size) > size_t(ss->sysex_size) - sxpos)
+            {
+                result = false;
+                break;
+            }
+            e.m_sysex.edit().assign
+            (
+                sysex + sxpos, sysex + sxpos + se.sysex_size
+            );
+            e.m_sysex.share();
+            sxpos += se.sysex_size;
+        }
+        links[size_t(i)] = se.link >= 0 && se.link < ss->event_count ?
+            int(se.link) : (-1) ;
+    }
+    if (result)
+    {
+        s.events().assign_linked(evs, links);
+
+        seq::number seqno = seq::number(ss->seq_number);
+        result = p.install_sequence(sp, seqno, true, true);
+    }
+    else
+        delete sp;
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * songsnapshot.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-06-04
- * \updates       2022-09-11
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the WRK format, see, for example:
@@ -80,6 +80,7 @@
 #include <cmath>                        /* for the pow() function           */
 
 #include "cfg/settings.hpp"             /* seq66::rc().show_midi() etc.     */
+#include "midi/songinfo.hpp"            /* seq66::songinfo                  */
 #include "midi/wrkfile.hpp"             /* seq66::wrkfile                   */
 #include "play/performer.hpp"           /* seq66::performer                 */
 #include "play/seq.hpp"                 /* seq66::sequence, seq66::seq      */
@@ -206,6 +207,7 @@ wrkfile::wrkfile
     midifile        (name, ppqn, true, playlistmode),
     m_wrk_data      (),
     m_performer     (nullptr),
+    m_song_info     (nullptr),
     m_screen_set    (seq::unassigned()),
     m_importing     (false),
     m_seq_number    (0),
@@ -491,6 +493,84 @@ wrkfile::parse (performer & p, int screenset, bool importing)
     return result;
 }
 
+/**
+ *  Parses the file as parse() does, but without a performer, for the deep
+ *  verification of a playlist (see songinfo::scan()).  Each track is read
+ *  into a detached sequence, measured, and deleted.  Safe to call from any
+ *  thread, as long as each thread uses its own wrkfile.
+ *
+ * \param [out] si
+ *      Receives the track count, the file PPQN, the length of the longest
+ *      track in file pulses, and the first tempo.  The caller sets the rest.
+ *
+ * \return
+ *      Returns true if the file parsed without error.  Otherwise the error
+ *      is in error_message().
+ */
+
+bool
+wrkfile::scan (songinfo & si)
+{
+    bool result = grab_input_stream(std::string("WRK"));
+    if (result)
+    {
+        std::string hdr = read_string(int(CakewalkHeader.length()));
+        result = hdr == CakewalkHeader;
+    }
+    if (result)
+    {
+        clear_errors();
+        m_performer = nullptr;
+        m_song_info = &si;
+        read_gap(1);                    /* bypasses a 0x1a [SUB] character  */
+        (void) read_byte();             /* minor WRK version number         */
+        (void) read_byte();             /* major WRK version number         */
+
+        int ck_id;
+        do
+        {
+            ck_id = read_chunk();
+        }
+        while (ck_id != WC_END_CHUNK && ! at_end());
+
+        if (! at_end())
+            result = set_error("Corrupted WRK file.");
+        else
+            EndChunk();
+
+        if (! error_message().empty())
+            result = false;             /* e.g. a read past the end         */
+
+        si.m_ppqn = file_ppqn();
+        if (! m_wrk_data.m_tempos.empty())
+            si.m_bpm = m_wrk_data.m_tempos.front().tempo;
+
+        delete m_current_seq;           /* a track left unfinished          */
+        m_current_seq = nullptr;
+        m_song_info = nullptr;
+    }
+    else
+        result = set_error("Invalid WRK file format.");
+
+    return result;
+}
+
+/**
+ *  Creates the sequence for the next track: in the performer when loading,
+ *  or detached when scanning.
+ */
+
+sequence *
+wrkfile::next_sequence ()
+{
+    if (not_nullptr(m_performer))
+        return create_sequence(*m_performer);
+
+    sequence * result = new (std::nothrow) sequence(ppqn());
+    m_track_time = 0;
+    return result;
+}
+
 /**
  *  An override of the midifile function.  All it does is set the m_track_time
  *  value to 0, so far.
@@ -668,7 +748,7 @@ wrkfile::next_track
          * Set up for the next sequence.  The previous one remains.
          */
 
-        m_current_seq = create_sequence(*m_performer);
+        m_current_seq = next_sequence();
         m_current_seq->set_midi_channel(channel); /* channel, whole trk */
         m_current_seq->set_name(trackname);
     }
@@ -676,13 +756,22 @@ wrkfile::next_track
 
 /**
  *  This override finalizes a WRK track, if the sequence doesn't already
- *  exist.
+ *  exist.  When scanning, the track is only measured, then deleted.
  */
 
 void
 wrkfile::finalize_track ()
 {
-    if (not_nullptr(m_current_seq))     /* a sequence currently exists  */
+    if (not_nullptr(m_current_seq) && not_nullptr(m_song_info))
+    {
+        if (m_track_time > m_song_info->m_length)
+            m_song_info->m_length = m_track_time;   /* in file pulses   */
+
+        ++m_song_info->m_track_count;
+        delete m_current_seq;
+        m_current_seq = nullptr;
+    }
+    else if (not_nullptr(m_current_seq))    /* a sequence currently exists  */
     {
         midipulse duration = m_track_time;
         if (scaled())
@@ -787,7 +876,9 @@ wrkfile::TimebaseChunk ()
     file_ppqn(int(timebase));                       /* original file PPQN   */
     if (usr().use_file_ppqn())
     {
-        m_performer->file_ppqn(file_ppqn());        /* let performer know   */
+        if (not_nullptr(m_performer))
+            m_performer->file_ppqn(file_ppqn());    /* let performer know   */
+
         ppqn(file_ppqn());                          /* PPQN == file PPQN    */
         scaled(false);                              /* do not scale time    */
     }
@@ -1342,7 +1433,7 @@ wrkfile::MeterChunk ()
         if (measure == 1)
         {
             if (is_nullptr(m_current_seq))
-                m_current_seq = create_sequence(*m_performer);
+                m_current_seq = next_sequence();
 
             m_current_seq->set_beats_per_bar(num);
             m_current_seq->set_beat_width(den);
@@ -1350,7 +1441,7 @@ wrkfile::MeterChunk ()
             // m_current_seq->clocks_per_metronome(cpm);
             // m_current_seq->set_32nds_per_quarter(tpq);
 
-            if (m_track_number == 0)
+            if (m_track_number == 0 && not_nullptr(m_performer))
             {
                 m_performer->set_beats_per_bar(num);
                 m_performer->set_beat_width(den);
@@ -1404,7 +1495,7 @@ wrkfile::MeterKeyChunk ()
         if (measure == 1)
         {
             if (is_nullptr(m_current_seq))
-                m_current_seq = create_sequence(*m_performer);
+                m_current_seq = next_sequence();
 
             m_current_seq->set_beats_per_bar(num);
             m_current_seq->set_beat_width(den);
@@ -1414,8 +1505,11 @@ wrkfile::MeterKeyChunk ()
 
             if (m_track_number == 0)
             {
-                m_performer->set_beats_per_bar(num);
-                m_performer->set_beat_width(den);
+                if (not_nullptr(m_performer))
+                {
+                    m_performer->set_beats_per_bar(num);
+                    m_performer->set_beat_width(den);
+                }
 
                 // m_performer->clocks_per_metronome(cpm);
                 // m_performer->set_32nds_per_quarter(tpq);
@@ -1525,14 +1619,17 @@ wrkfile::TempoChunk (int factor)
         }
 
         if (is_nullptr(m_current_seq))
-            m_current_seq = create_sequence(*m_performer);
+            m_current_seq = next_sequence();
 
         midibpm bpm = tempo / 100.0;
         midibpm tt = tempo_us_from_bpm(bpm);
         if (m_track_number == 0)
         {
-            m_performer->set_beats_per_minute(bpm);
-            m_performer->us_per_quarter_note(int(tt));
+            if (not_nullptr(m_performer))
+            {
+                m_performer->set_beats_per_minute(bpm);
+                m_performer->us_per_quarter_note(int(tt));
+            }
             m_current_seq->us_per_quarter_note(int(tt));
         }
 
@@ -0,0 +1,368 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          hotswap.cpp
+ *
+ *  This module defines the staging area for replacing patterns, control
+ *  maps, note maps, and mute-groups while playing.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of hotswap.hpp for the order of publication.
+ */
+
+#include "ctrl/keycontainer.hpp"        /* seq66::keycontainer              */
+#include "ctrl/midicontrolin.hpp"       /* seq66::midicontrolin             */
+#include "play/hotswap.hpp"             /* seq66::hotswap                   */
+#include "play/mutegroups.hpp"          /* seq66::mutegroups                */
+#include "play/notemapper.hpp"          /* seq66::notemapper                */
+#include "play/screenset.hpp"           /* seq66::playset                   */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+hotswap::hotswap () :
+    m_mutex             (),
+    m_pending           (false),
+    m_controls_due      (false),
+    m_last_bar          (-1),
+    m_play_set          (),
+    m_note_mapper       (),
+    m_midi_control_in   (),
+    m_key_controls      (),
+    m_mutes             (),
+    m_old_play_set      (),
+    m_old_note_mapper   (),
+    m_old_key_controls  (),
+    m_old_mutes         ()
+{
+    // no code
+}
+
+hotswap::~hotswap ()
+{
+    clear();
+}
+
+/**
+ *  Changes the ready play-set, first copying it from the live play-set if
+ *  none is staged yet.  Called by the loading thread, after installing a
+ *  pattern in the set-mapper.
+ *
+ * \param live
+ *      The play-set now used by the output thread.  It is only read.
+ *
+ * \param edit
+ *      The change to make, e.g. adding the new pattern.
+ *
+ * \return
+ *      Returns the result of the edit.
+ */
+
+bool
+hotswap::stage_play_set (const playset & live, const editor & edit)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    release_old();
+    if (! m_play_set)
+        m_play_set.reset(new (std::nothrow) playset(live));
+
+    bool result = bool(m_play_set);
+    if (result)
+    {
+        result = edit(*m_play_set);
+        update_pending(true);
+    }
+    return result;
+}
+
+/**
+ *  Applies a change made to the live play-set to the ready play-set as
+ *  well, if one is staged, so that it is not lost at the swap.
+ *
+ * \return
+ *      Returns true if a ready play-set was changed.
+ */
+
+bool
+hotswap::edit_play_set (const editor & edit)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    bool result = bool(m_play_set);
+    if (result)
+        result = edit(*m_play_set);
+
+    return result;
+}
+
+/**
+ *  Drops the ready play-set.  Used when the live play-set is refilled from
+ *  the set-mapper, which already holds the staged patterns.
+ */
+
+void
+hotswap::drop_play_set ()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_play_set.reset();
+    update_pending();
+}
+
+void
+hotswap::stage_note_mapper (std::shared_ptr<notemapper> nm)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    release_old();
+    m_note_mapper = nm;
+    update_pending(true);
+}
+
+/**
+ *  Stages copies of the MIDI and key controls.  A later call replaces
+ *  controls that have not been published yet.
+ */
+
+void
+hotswap::stage_controls (const midicontrolin & mci, const keycontainer & kc)
+{
+    std::unique_ptr<midicontrolin> mcip(new (std::nothrow) midicontrolin(mci));
+    std::shared_ptr<keycontainer> kcp = std::make_shared<keycontainer>(kc);
+    if (mcip && kcp)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        release_old();
+        m_midi_control_in = std::move(mcip);
+        m_key_controls = kcp;
+        update_pending(true);
+    }
+}
+
+void
+hotswap::stage_mutes (const mutegroups & mg)
+{
+    std::shared_ptr<mutegroups> mgp = std::make_shared<mutegroups>(mg);
+    if (mgp)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        release_old();
+        m_mutes = mgp;
+        update_pending(true);
+    }
+}
+
+/**
+ *  Discards everything staged and retired.  The staged patterns stay in
+ *  the set-mapper.
+ */
+
+void
+hotswap::clear ()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    release_old();
+    m_play_set.reset();
+    m_note_mapper.reset();
+    m_midi_control_in.reset();
+    m_key_controls.reset();
+    m_mutes.reset();
+    update_pending();
+}
+
+/**
+ *  Called by the output thread.  The first call after staging notes the
+ *  current bar; later calls return true once the play tick has moved into
+ *  another bar.
+ *
+ * \param tick
+ *      The current play tick.
+ *
+ * \param barlength
+ *      The length of a bar in pulses.  If not positive, true is returned.
+ *
+ * \return
+ *      Returns true if the staged objects can be published now.
+ */
+
+bool
+hotswap::bar_crossed (midipulse tick, midipulse barlength)
+{
+    bool result = barlength <= 0;
+    if (! result)
+    {
+        long bar = long(tick / barlength);
+        long last = m_last_bar;
+        if (last < 0)
+            m_last_bar = bar;
+        else
+            result = bar != last;
+    }
+    return result;
+}
+
+/**
+ *  Called by the output thread at a bar boundary (or by the input thread
+ *  while not playing).  Swaps the ready play-set with the live one, and the
+ *  staged note-mapper with the live one.  The old ones are retired, not
+ *  freed.  If controls or mute-groups are staged, they are marked as due
+ *  for the input thread.  Does not wait for the lock.
+ *
+ * \param live
+ *      The live play-set.  The caller holds the lock that the output thread
+ *      holds while playing it.
+ *
+ * \param livenm
+ *      The live note-mapper, exchanged atomically.
+ *
+ * \param [out] nmchanged
+ *      Set to true if the note-mapper was replaced.
+ *
+ * \return
+ *      Returns true if the play-set was replaced.  Returns false if nothing
+ *      was staged, or if the lock was busy.
+ */
+
+bool
+hotswap::publish_patterns
+(
+    playset & live,
+    std::shared_ptr<notemapper> & livenm,
+    bool & nmchanged
+)
+{
+    bool result = false;
+    std::unique_lock<std::mutex> lk(m_mutex, std::try_to_lock);
+    if (lk.owns_lock())
+    {
+        if (m_play_set && ! m_old_play_set)     /* nothing to free here     */
+        {
+            live.swap(*m_play_set);
+            m_old_play_set = std::move(m_play_set);
+            result = true;
+        }
+        nmchanged = bool(m_note_mapper) && ! m_old_note_mapper;
+        if (nmchanged)
+        {
+            m_old_note_mapper = std::atomic_exchange(&livenm, m_note_mapper);
+            m_note_mapper.reset();              /* livenm still holds it    */
+        }
+        if (m_midi_control_in || m_key_controls || m_mutes)
+            m_controls_due = true;
+
+        update_pending();
+    }
+    return result;
+}
+
+/**
+ *  Called by the input thread once controls_due() is true, or at any time
+ *  while not playing.  Moves the staged MIDI controls into the live ones
+ *  (the input thread is their only reader), and exchanges the key controls
+ *  and mute-groups atomically, retiring the old ones.  Does not wait for
+ *  the lock.
+ *
+ * \param [out] mgchanged
+ *      Set to true if the mute-groups were replaced.
+ *
+ * \return
+ *      Returns false if the lock was busy, in which case nothing is taken.
+ */
+
+bool
+hotswap::publish_controls
+(
+    midicontrolin & livemci,
+    std::shared_ptr<keycontainer> & livekc,
+    std::shared_ptr<mutegroups> & livemg,
+    bool & mgchanged
+)
+{
+    std::unique_lock<std::mutex> lk(m_mutex, std::try_to_lock);
+    bool result = lk.owns_lock();
+    if (result)
+    {
+        if (m_midi_control_in)
+        {
+            livemci = std::move(*m_midi_control_in);
+            m_midi_control_in.reset();
+        }
+        if (m_key_controls && ! m_old_key_controls)
+        {
+            m_old_key_controls = std::atomic_exchange(&livekc, m_key_controls);
+            m_key_controls.reset();
+        }
+        mgchanged = bool(m_mutes) && ! m_old_mutes;
+        if (mgchanged)
+        {
+            m_old_mutes = std::atomic_exchange(&livemg, m_mutes);
+            m_mutes.reset();
+        }
+        m_controls_due = false;
+        update_pending();
+    }
+    return result;
+}
+
+/**
+ *  Frees the objects retired at the last publication.  The caller holds the
+ *  lock, and is the loading thread.
+ */
+
+void
+hotswap::release_old ()
+{
+    m_old_play_set.reset();
+    m_old_note_mapper.reset();
+    m_old_key_controls.reset();
+    m_old_mutes.reset();
+}
+
+/**
+ *  Recalculates the pending flag.  The caller must hold the lock.
+ *
+ * \param restage
+ *      If true, something was just staged, so the wait for a bar boundary
+ *      starts again.
+ */
+
+void
+hotswap::update_pending (bool restage)
+{
+    if (restage)
+        m_last_bar = -1;
+
+    m_pending = bool(m_play_set) || bool(m_note_mapper) ||
+        bool(m_midi_control_in) || bool(m_key_controls) || bool(m_mutes);
+}
+
+}           // namespace seq66
+
+/*
+ * hotswap.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom and others
  * \date          2018-11-12
- * \updates       2024-08-18
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Also read the comments in the Seq64 version of this module, perform.
@@ -239,11 +239,12 @@
  *      modify() function.
  */
 
-#include <algorithm>                    /* std::find() for std::vector      */
+#include <algorithm>                    /* std::find(), std::sort()         */
 #include <cmath>                        /* std::round()                     */
 #include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
 
+#include "cfg/midicontrolfile.hpp"      /* seq66::read_midi_control_file()  */
 #include "cfg/mutegroupsfile.hpp"       /* seq66::mutegroupsfile            */
 #include "cfg/notemapfile.hpp"          /* seq66::notemapfile               */
 #include "cfg/playlistfile.hpp"         /* seq66::playlistfile              */
@@ -319,10 +320,16 @@ performer::performer (int ppqn, int rows, int columns) :
     m_clocks                (),                 /* vector wrapper class     */
     m_inputs                (),                 /* vector wrapper class     */
     m_port_map_error        (false),
-    m_key_controls          ("Key controls"),
+    m_key_controls
+    (
+        std::make_shared<keycontainer>("Key controls")
+    ),
     m_midi_control_in       ("Performer ctrl in"),
     m_midi_control_out      ("Performer ctrl out"),
-    m_mute_groups           ("Mute groups", rows, columns),     /* mutes()  */
+    m_mute_groups                                               /* mutes()  */
+    (
+        std::make_shared<mutegroups>("Mute groups", rows, columns)
+    ),
     m_operations            ("Performer operations"),
     m_set_master            (rows, columns),    /* 32 row x column sets     */
     m_set_mapper                                /* access via set_mapper()  */
@@ -333,6 +340,16 @@ performer::performer (int ppqn, int rows, int columns) :
     m_out_thread            (),
     m_in_thread             (),
     m_out_thread_launched   (false),
+    m_play_pool             (),
+    m_shared_status         (),
+    m_hot_swap              (),
+    m_stage_patterns        (false),
+    m_thru_routes           (),
+    m_record_routes         (),
+    m_batch_mutex           (),
+    m_batch_depth           (0),
+    m_batch_owner           (),
+    m_batch_pending         (),
     m_in_thread_launched    (false),
     m_io_active             (false),            /* !done(), set in launch() */
     m_is_running            (false),
@@ -345,6 +362,12 @@ performer::performer (int ppqn, int rows, int columns) :
     m_record_snap_length    (0),
     m_alter_recording       (alteration::none),
     m_resume_note_ons       (usr().resume_note_ons()),
+    m_resume_controls       (usr().resume_controls()),
+    m_chase_pending         (false),
+    m_ahead_invalid         (false),
+    m_ahead_tick            (0),
+    m_ahead_pulse_us        (0.0),
+    m_ahead_buffer          (),
     m_ppqn                  (choose_ppqn(ppqn)),
     m_file_ppqn             (0),
     m_bpm                   (usr().midi_beats_per_minute()),
@@ -355,6 +378,8 @@ performer::performer (int ppqn, int rows, int columns) :
     m_last_time_ms          (0),
     m_beats_per_bar         (usr().midi_beats_per_bar()),
     m_beat_width            (usr().midi_beat_width()),
+    m_meter_map             (),
+    m_meter_map_valid       (false),
     m_clocks_per_metronome  (24),
     m_32nds_per_quarter     (0),
     m_us_per_quarter_note   (0),
@@ -611,6 +636,120 @@ performer::unmodify ()
     set_mapper().unmodify_all_sequences();
 }
 
+/**
+ *  Releases the unused memory of all patterns.  Called before the song is
+ *  saved.
+ */
+
+void
+performer::compact_patterns ()
+{
+    set_mapper().exec_set_function
+    (
+        [] (seq::pointer sp, seq::number /*sn*/)
+        {
+            if (sp)
+                sp->compact(true);
+
+            return true;                        /* empty slots are fine     */
+        }
+    );
+}
+
+/**
+ *  Returns the load and saturation of the output busses shaped by the 'rc'
+ *  file's [midi-bandwidth] section.  Empty if there are none.
+ */
+
+std::string
+performer::bandwidth_report ()
+{
+    return m_master_bus ? m_master_bus->bandwidth_report() : std::string() ;
+}
+
+/**
+ *  Lists the patterns using the most memory, largest first, followed by
+ *  the totals for all patterns.  Used by the "-o memory" option of
+ *  seq66cli.
+ *
+ * \param count
+ *      The number of patterns to list.  If 0 or less, all are listed.
+ *
+ * \return
+ *      Returns the report as lines of text.
+ */
+
+std::string
+performer::memory_report (int count)
+{
+    struct usage
+    {
+        seq::number seqno;
+        std::string name;
+        sequence::memory mem;
+    };
+    std::vector<usage> usages;
+    sequence::memory totals { 0, 0, 0, 0 };
+    set_mapper().exec_set_function
+    (
+        [&usages, &totals] (seq::pointer sp, seq::number sn)
+        {
+            if (sp)
+            {
+                sequence::memory m = sp->memory_use();
+                totals.events += m.events;
+                totals.sysex += m.sysex;
+                totals.undo += m.undo;
+                totals.triggers += m.triggers;
+                usages.push_back(usage{ sn, sp->name(), m });
+            }
+            return true;
+        }
+    );
+    std::stable_sort
+    (
+        usages.begin(), usages.end(),
+        [] (const usage & a, const usage & b)
+        {
+            return a.mem.total() > b.mem.total();
+        }
+    );
+
+    std::size_t shown = usages.size();
+    if (count > 0 && std::size_t(count) < shown)
+        shown = std::size_t(count);
+
+    std::ostringstream os;
+    char temp[128];
+    os << "Pattern memory in bytes, " << shown << " largest of "
+        << usages.size() << " patterns:\n";
+    snprintf
+    (
+        temp, sizeof temp, "%5s %10s %10s %10s %10s %11s  %s\n",
+        "Seq", "Events", "SysEx", "Undo", "Triggers", "Total", "Name"
+    );
+    os << temp;
+    for (std::size_t i = 0; i < shown; ++i)
+    {
+        const usage & u = usages[i];
+        snprintf
+        (
+            temp, sizeof temp, "%5d %10zu %10zu %10zu %10zu %11zu  ",
+            int(u.seqno), u.mem.events, u.mem.sysex, u.mem.undo,
+            u.mem.triggers, u.mem.total()
+        );
+        os << temp << u.name << "\n";
+    }
+    snprintf
+    (
+        temp, sizeof temp, "%5s %10zu %10zu %10zu %10zu %11zu\n",
+        "All", totals.events, totals.sysex, totals.undo,
+        totals.triggers, totals.total()
+    );
+    os << temp;
+    return os.str();
+}
+
 /**
  *  This improved version checks all of the sequences. This allow the user to
  *  unmodify a sequence without using performer::modify(). First usage of
@@ -671,6 +810,7 @@ void
 performer::notify_sequence_change (seq::number seqno, change mod)
 {
     bool redo = mod == change::recreate;
+    invalidate_meter_map();                     /* time-sigs may change     */
     if (mod == change::yes || redo)
         modify();
 
@@ -807,7 +947,7 @@ performer::get_settings (const rcsettings & rcs, const usrsettings & usrs)
     int moacount = rcs.midi_control_out().action_count();
     int momcount = rcs.midi_control_out().macro_count();
     if (kcount > 0)
-        m_key_controls = rcs.key_controls();
+        key_controls() = rcs.key_controls();
 
     msgprintf
     (
@@ -825,7 +965,7 @@ performer::get_settings (const rcsettings & rcs, const usrsettings & usrs)
 
     m_midi_control_in = rcs.midi_control_in();
     if (micount == 0 && kcount > 0)
-        m_midi_control_in.add_blank_controls(m_key_controls);
+        m_midi_control_in.add_blank_controls(key_controls());
 
     m_midi_control_out = rcs.midi_control_out();
     if (rc().mute_group_file_active())
@@ -839,6 +979,7 @@ performer::get_settings (const rcsettings & rcs, const usrsettings & usrs)
     record_by_buss(rcs.record_by_buss());
     record_by_channel(rcs.record_by_channel());
     m_resume_note_ons = usrs.resume_note_ons();
+    m_resume_controls = usrs.resume_controls();
     return result;
 }
 
@@ -881,7 +1022,7 @@ performer::put_settings (rcsettings & rcs, usrsettings & usrs)
         rcs.clocks() = m_clocks;
         rcs.inputs() = m_inputs;
     }
-    rcs.key_controls() = m_key_controls;
+    rcs.key_controls() = key_controls();
     rcs.midi_control_in() = m_midi_control_in;
     rcs.midi_control_out() = m_midi_control_out;
     if (mutes().is_modified() && rc().mute_group_file_active())
@@ -902,6 +1043,7 @@ performer::put_settings (rcsettings & rcs, usrsettings & usrs)
     rcs.record_by_buss(m_record_by_buss);       /* ca 2024-08-18    */
     rcs.record_by_channel(m_record_by_channel);
     usrs.resume_note_ons(m_resume_note_ons);
+    usrs.resume_controls(m_resume_controls);
 
     /*
      * We also need to update the playlist file-name in case the user loaded
@@ -926,7 +1068,7 @@ std::string
 performer::automation_key (automation::slot s)
 {
     int index = slot_to_int_cast(s);
-    return m_key_controls.automation_key(index);
+    return key_controls().automation_key(index);
 }
 
 /**
@@ -965,10 +1107,16 @@ bool
 performer::reload_mute_groups (std::string & errmessage)
 {
     const std::string filename = rc().mute_group_filespec();
-    bool result = open_mutegroups(filename);
+    bool running = is_running();
+    bool result = running ?
+        stage_mute_groups(filename) : open_mutegroups(filename) ;
+
     if (result)
     {
-        result = get_settings(rc(), usr());
+        if (running)
+            stage_controls(rc());                   /* published at a bar   */
+        else
+            result = get_settings(rc(), usr());
     }
     else
     {
@@ -1619,11 +1767,40 @@ performer::main_window_title (const std::string & filename) const
     return result;
 }
 
+/**
+ *  Returns the song's meter map, rebuilding it first if the song has
+ *  changed.  The time-signatures come from the first pattern that has any,
+ *  normally the first track of an SMF 1 file.  Without them, the map holds
+ *  just the song's beats/bar and beat width.  Meant for the user-interface
+ *  thread.
+ */
+
+const metermap &
+performer::meter_map () const
+{
+    if (! m_meter_map_valid)
+    {
+        m_meter_map_valid = true;               /* changes after this count */
+        m_meter_map.reset(ppqn(), get_beats_per_bar(), get_beat_width());
+        int high = int(sequence_high());
+        for (int s = 0; s < high; ++s)
+        {
+            const seq::pointer sp = get_sequence(seq::number(s));
+            if (sp && sp->fill_meter_map(m_meter_map))
+                break;
+        }
+    }
+    return m_meter_map;
+}
+
+/**
+ *  Formats the tick as B:B:T, honoring time-signature changes in the song.
+ */
+
 std::string
 performer::pulses_to_measure_string (midipulse tick) const
 {
-    midi_timing mt(bpm(), get_beats_per_bar(), get_beat_width(), ppqn());
-    return seq66::pulses_to_measurestring(tick, mt);
+    return meter_map().to_string(tick);
 }
 
 std::string
@@ -1677,17 +1854,45 @@ performer::client_id_string () const
  * \param fileload
  *      If true (the default is false), the modify flag will not be set.
  *
+ * \param presorted
+ *      If true (the default is false), the events are already sorted and
+ *      linked, as when restored from a songsnapshot.
+ *
  * \return
  *      Returns true if the sequence was successfully added.
  */
 
 bool
-performer::install_sequence (sequence * s, seq::number & seqno, bool fileload)
+performer::install_sequence
+(
+    sequence * s, seq::number & seqno, bool fileload, bool presorted
+)
+{
+    bool result = not_nullptr(s);
+    if (result)
+    {
+        if (m_stage_patterns && is_running())       /* see hotswap module   */
+            result = stage_sequence(s, seqno, fileload, presorted);
+        else
+            result = install_sequence_now(s, seqno, fileload, presorted);
+    }
+    return result;
+}
+
+/**
+ *  The body of install_sequence() when not staging.
+ */
+
+bool
+performer::install_sequence_now
+(
+    sequence * s, seq::number & seqno, bool fileload, bool presorted
+)
 {
     bool result = set_mapper().install_sequence(s, seqno);
     if (result)
     {
-        s->set_parent(this);                    /* also sets a lot of stuff */
+        s->set_parent(this, presorted);         /* also sets a lot of stuff */
         if (rc().is_setsmode_clear())           /* i.e. normal or auto-arm  */
         {
             /*
@@ -1723,23 +1928,80 @@ performer::install_sequence (sequence * s, seq::number & seqno, bool fileload)
     return result;
 }
 
+/**
+ *  Installs a pattern in the set-mapper while playing, on the loading
+ *  thread, as install_sequence_now() does, but adds it to a ready copy of
+ *  the play-set instead of the live one.  The output thread swaps that copy
+ *  in at the next bar boundary; see publish_patterns().
+ */
+
+bool
+performer::stage_sequence
+(
+    sequence * s, seq::number & seqno, bool fileload, bool presorted
+)
+{
+    bool result = set_mapper().install_sequence(s, seqno);
+    if (result)
+    {
+        s->set_parent(this, presorted);
+        if (rc().is_setsmode_clear() || rc().is_setsmode_allsets())
+        {
+            result = m_hot_swap.stage_play_set
+            (
+                play_set(), [this, s] (playset & ps)
+                {
+                    bool ok = set_mapper().add_to_play_set(ps, s);
+                    if (ok)
+                        record_by_buss(sequence_inbus_setup(ps));
+
+                    return ok;
+                }
+            );
+        }
+        if (! fileload)
+            modify();
+    }
+    return result;
+}
+
+/**
+ *  Adds a pattern to the live play-set, and to the ready play-set, if one
+ *  is staged, so that the next swap does not drop it.
+ */
+
 bool
 performer::add_to_play_set (sequence * s)
 {
     bool result = set_mapper().add_to_play_set(play_set(), s);
     if (result)
+    {
+        (void) m_hot_swap.edit_play_set
+        (
+            [this, s] (playset & ps)
+            {
+                return set_mapper().add_to_play_set(ps, s);
+            }
+        );
         record_by_buss(sequence_inbus_setup());
-
+    }
     return result;
 }
 
+/**
+ *  Refills the live play-set from the set-mapper, which already holds any
+ *  staged patterns, so the ready play-set is dropped.
+ */
+
 bool
 performer::fill_play_set (bool clearit)
 {
     bool result = set_mapper().fill_play_set(play_set(), clearit);
     if (result)
+    {
+        m_hot_swap.drop_play_set();
         record_by_buss(sequence_inbus_setup());
-
+    }
     return result;
 }
 
@@ -2347,6 +2609,7 @@ performer::set_ppqn (int p)
         {
             m_ppqn = p;
             m_one_measure = m_fast_ticks = 0;
+            invalidate_meter_map();
             (void) jack_set_ppqn(p);
             m_master_bus->set_ppqn(p);
             notify_resolution_change                    /* ca 2023-10-30    */
@@ -2934,25 +3197,30 @@ screenset::number
 performer::set_playing_screenset (screenset::number setno)
 {
     bool ok = ! done();
-    if (ok)
-        ok = set_mapper().set_playing_screenset(setno);
-
     if (ok)
     {
-        bool clearit = rc().is_setsmode_clear();    /* remove all patterns? */
-        announce_exit(false);                       /* blank the device     */
-        unset_queued_replace();                     /* clear queueing       */
-        (void) fill_play_set(clearit);
-        if (rc().is_setsmode_autoarm())
-        {
-            set_song_mute(mutegroups::action::off); /* unmute them all      */
-        }
-        else if (rc().is_setsmode_allsets())
+        batch b(*this, false);                      /* announced below      */
+        ok = set_mapper().set_playing_screenset(setno);
+        if (ok)
         {
-            /*
-             * Nothing to do?
-             */
+            bool clearit = rc().is_setsmode_clear();
+            announce_exit(false);                   /* blank the device     */
+            unset_queued_replace();                 /* clear queueing       */
+            (void) fill_play_set(clearit);          /* remove all patterns? */
+            if (rc().is_setsmode_autoarm())
+            {
+                set_song_mute(mutegroups::action::off); /* unmute them all  */
+            }
+            else if (rc().is_setsmode_allsets())
+            {
+                /*
+                 * Nothing to do?
+                 */
+            }
         }
+    }
+    if (ok)
+    {
 
         /*
          * Now done in fill_play_set().
@@ -2975,12 +3243,14 @@ performer::set_playing_screenset (screenset::number setno)
 void
 performer::reset_playset ()
 {
-    announce_exit(false);                           /* blank the device     */
-    unset_queued_replace();                         /* clear queueing       */
-    (void) fill_play_set();                         /* true: clear it first */
-    if (rc().is_setsmode_autoarm())
-        set_song_mute(mutegroups::action::off);     /* unmute them all      */
-
+    {
+        batch b(*this, false);                      /* announced below      */
+        announce_exit(false);                       /* blank the device     */
+        unset_queued_replace();                     /* clear queueing       */
+        (void) fill_play_set();                     /* true: clear it first */
+        if (rc().is_setsmode_autoarm())
+            set_song_mute(mutegroups::action::off); /* unmute them all      */
+    }
     announce_playscreen();                          /* inform control-out   */
 }
 
@@ -3090,6 +3360,7 @@ performer::clear_all (bool /* clearplaylist */ )
     bool result = clear_song();
     usr().clear_global_seq_features();
     m_song_info.clear();
+    invalidate_meter_map();
     if (result)
     {
         play_set().clear();                     /* dump active patterns     */
@@ -3171,6 +3442,35 @@ performer::reset_sequences (bool p)
      */
 }
 
+/**
+ *  Sends the state of each armed pattern in the play-set at the given
+ *  position:  the sounding notes if "note-resume" is set, and the latest
+ *  controller values if "control-resume" is set.  Each sequence uses its
+ *  chase index, so this is cheap even for long patterns.  Called when
+ *  starting in Live mode, and by the output thread after a reposition or a
+ *  loop back to the L marker.
+ *
+ * \param tick
+ *      The new position, in pulses.
+ */
+
+void
+performer::chase_sequences (midipulse tick)
+{
+    bool notes = resume_note_ons();
+    bool controls = resume_controls();
+    m_chase_pending = false;
+    if (notes || controls)
+    {
+        for (auto seqi : play_set().seq_container())
+        {
+            if (seqi && seqi->armed())
+                seqi->chase(tick, notes, controls);
+        }
+        m_master_bus->flush();
+    }
+}
+
 /**
  *  What about the GM channel?
  */
@@ -3178,10 +3478,11 @@ performer::reset_sequences (bool p)
 void
 performer::repitch (event & ev) const
 {
-    if (notemap_exists() && ev.is_note())
+    std::shared_ptr<notemapper> nm = std::atomic_load(&m_note_mapper);
+    if (nm && ev.is_note())
     {
         midibyte incoming = ev.d0();
-        midibyte outgoing = m_note_mapper->fast_convert(incoming);
+        midibyte outgoing = nm->fast_convert(incoming);
         if (rc().investigate())
             printf("Note %d in --> %d out\n", incoming, outgoing);
 
@@ -3194,7 +3495,10 @@ performer::repitch_all (const std::string & nmapfile, seq::ref s)
 {
     bool result = open_note_mapper(nmapfile);
     if (result)
-        result = s.repitch(*m_note_mapper, true);
+    {
+        std::shared_ptr<notemapper> nm = std::atomic_load(&m_note_mapper);
+        result = s.repitch(*nm, true);
+    }
 
     if (result)
         modify();
@@ -3207,7 +3511,10 @@ performer::repitch_selected (const std::string & nmapfile, seq::ref s)
 {
     bool result = open_note_mapper(nmapfile);
     if (result)
-        result = s.repitch(*m_note_mapper);
+    {
+        std::shared_ptr<notemapper> nm = std::atomic_load(&m_note_mapper);
+        result = s.repitch(*nm);
+    }
 
     if (result)
         modify();
@@ -3236,6 +3543,7 @@ performer::repitch_selected (const std::string & nmapfile, seq::ref s)
 void
 performer::set_song_mute (mutegroups::action op)
 {
+    batch b(*this);
     switch (op)
     {
     case mutegroups::action::on:
@@ -3309,6 +3617,9 @@ performer::create_master_bus ()
                 mmb->record_by_buss(m_record_by_buss);
                 mmb->record_by_channel(m_record_by_channel);
                 mmb->set_port_statuses(m_clocks, m_inputs);
+                if (! rc().bandwidths().empty())
+                    mmb->set_bandwidths(rc().bandwidths());
+
                 midi_control_out().set_master_bus(mmb);
                 result = true;
             }
@@ -3468,6 +3779,17 @@ performer::launch (int ppqn)
 
 bool
 performer::sequence_inbus_setup ()
+{
+    return sequence_inbus_setup(play_set());
+}
+
+/**
+ *  The body of sequence_inbus_setup(), for a given play-set.  Used with the
+ *  ready play-set staged while playing.
+ */
+
+bool
+performer::sequence_inbus_setup (const playset & ps)
 {
     bool result = false;
     if (rc().sequence_lookup_support())
@@ -3482,7 +3804,7 @@ performer::sequence_inbus_setup ()
          */
 
         m_buss_patterns.clear();
-        for (auto seqi : play_set().seq_container())
+        for (auto seqi : ps.seq_container())
         {
             if (seqi->has_in_bus())
             {
@@ -3525,28 +3847,18 @@ performer::sequence_inbus_clear ()
 
 /**
  *  Looks for the first matching input-buss in the list of patterns that
- *  have an input bus set.
+ *  have an input bus set.  This is now a lookup in the recording targets,
+ *  so it is valid only in the input thread, when recording by buss.
  */
 
 sequence *
 performer::sequence_inbus_lookup (const event & ev)
 {
     sequence * result = nullptr;
-#if defined USE_OLD_CODE
-    size_t b = size_t(ev.input_bus());
-    if (b < m_buss_patterns.size())
-        result = m_buss_patterns[b];
-#else
-    bussbyte b = ev.input_bus();
-    for (auto seqi : m_buss_patterns)
-    {
-        if (b == seqi->true_in_bus())
-        {
-            result = seqi;
-            break;
-        }
-    }
-#endif
+    const recordroutes::targets * t = m_record_routes.lookup(ev);
+    if (not_nullptr(t) && record_by_buss())
+        result = t->front();
+
     return result;
 }
 
@@ -3662,13 +3974,34 @@ performer::announce_mutes ()
 
 bool
 performer::announce_sequence (seq::pointer s, seq::number sn)
+{
+    midicontrolout::seqaction what = sequence_action(s);
+    if (what != midicontrolout::seqaction::max)         /* else pretend ok  */
+        send_seq_event(sn, what);
+
+    return true;
+}
+
+/**
+ *  Determines the control-out status of a pattern.
+ *
+ * \param s
+ *      Provides the pointer to the sequence, which can be null.
+ *
+ * \return
+ *      Returns the status to announce, or seqaction::max if the pattern is
+ *      not a normal pattern and is not to be announced.
+ */
+
+midicontrolout::seqaction
+performer::sequence_action (seq::pointer s) const
 {
     bool ok = not_nullptr(s);
     midicontrolout::seqaction what;
     if (ok)
     {
         if (! s->is_normal_seq())
-            return true;                                /* pretend success  */
+            return midicontrolout::seqaction::max;
 
         if (s->armed())
         {
@@ -3687,13 +4020,24 @@ performer::announce_sequence (seq::pointer s, seq::number sn)
     else
         what = midicontrolout::seqaction::removed;
 
-    send_seq_event(sn, what);
-    return true;
+    return what;
 }
 
+/**
+ *  Announces the status of a pattern to control-out.  If the calling thread
+ *  has a batch open, the announcement is deferred to batch_commit(), so that
+ *  a pattern changed several times in the batch is announced only once.
+ */
+
 bool
 performer::announce_pattern (seq::number seqno)
 {
+    if (m_batch_owner.load() == std::this_thread::get_id())
+    {
+        (void) m_batch_pending.insert(seqno);
+        return true;
+    }
+
     seq::pointer s = get_sequence(seqno);
     bool result = bool(s);
     if (result)
@@ -3702,6 +4046,64 @@ performer::announce_pattern (seq::number seqno)
     return result;
 }
 
+/**
+ *  Opens a batch of arm, queue, and mute changes.  The batch mutex is held
+ *  until the matching batch_commit(), which keeps the output thread from
+ *  playing the patterns in the middle of the changes.  Prefer the
+ *  performer::batch class, which cannot forget the commit.
+ */
+
+void
+performer::batch_begin ()
+{
+    m_batch_mutex.lock();
+    if (m_batch_depth++ == 0)
+        m_batch_owner.store(std::this_thread::get_id());
+}
+
+/**
+ *  Closes a batch.  When the outermost batch is closed, the output thread
+ *  is released, and each pattern changed in the batch is announced to
+ *  control-out once, followed by a single flush.
+ *
+ * \param announce
+ *      If false, the deferred announcements are dropped, because the caller
+ *      announces the whole play-screen itself (see set_playing_screenset()).
+ *
+ * \return
+ *      Returns true if the outermost batch was committed.
+ */
+
+bool
+performer::batch_commit (bool announce)
+{
+    bool result = m_batch_depth > 0;
+    if (result)
+    {
+        std::set<seq::number> pending;
+        result = --m_batch_depth == 0;
+        if (result)
+        {
+            m_batch_owner.store(std::thread::id());
+            pending.swap(m_batch_pending);
+        }
+        m_batch_mutex.unlock();
+        if (announce && ! pending.empty() && midi_control_out().is_enabled())
+        {
+            for (auto seqno : pending)
+            {
+                seq::pointer s = get_sequence(seqno);
+                seq::number sn = s ? set_mapper().seq_to_offset(*s) : seqno ;
+                midicontrolout::seqaction what = sequence_action(s);
+                if (what != midicontrolout::seqaction::max)
+                    midi_control_out().send_seq_event(sn, what, false);
+            }
+            m_master_bus->flush();
+        }
+    }
+    return result;
+}
+
 /**
  *  Sets the beats per measure and measures for all existing patterns.
  *  Compare this to set_beats_per_bar(), which merely sets a performer
@@ -3805,6 +4207,21 @@ performer::launch_output_thread ()
     }
     if (! m_out_thread_launched)
     {
+        if (rc().play_workers() > 0)
+        {
+            m_play_pool.reset(new (std::nothrow) playpool(*this));
+            if (m_play_pool)
+                (void) m_play_pool->start(rc().play_workers());
+        }
+        if (rc().render_ahead() > 0 && m_master_bus)
+            (void) m_master_bus->start_render_ahead(rc().render_ahead());
+
+        if (! rc().status_shm().empty())
+        {
+            m_shared_status.reset(new (std::nothrow) sharedstatus());
+            if (m_shared_status && ! m_shared_status->open(rc().status_shm()))
+                m_shared_status.reset();
+        }
         m_out_thread = std::thread(&performer::output_func, this);
         m_out_thread_launched = true;
         debug_message("Output thread launched");
@@ -3910,11 +4327,20 @@ performer::finish ()
             m_out_thread.join();
             m_out_thread_launched = false;
         }
+        if (m_play_pool)
+        {
+            m_play_pool->stop();
+            m_play_pool.reset();
+        }
+        if (m_master_bus)
+            m_master_bus->stop_render_ahead();
+
         if (m_in_thread_launched && m_in_thread.joinable())
         {
             m_in_thread.join();
             m_in_thread_launched = false;
         }
+        m_shared_status.reset();                    /* unlinks the object   */
         result = deinit_jack_transport();
 
         /*
@@ -3997,6 +4423,11 @@ performer::move_tick (midipulse ticks, bool dontreset)
         position_jack(true, curtick);
     else
         set_reposition();                               /* ditto!           */
+
+    if (chasing())
+        m_chase_pending = true;                         /* output thread    */
+
+    m_ahead_invalid = true;                             /* ditto            */
 }
 
 /**
@@ -4477,6 +4908,10 @@ performer::jack_reposition (midipulse tick, midipulse stoptick)
         set_reposition(true);
         set_start_tick(tick);
         jack_stop_tick(tick);
+        if (chasing())
+            m_chase_pending = true;                     /* output thread    */
+
+        m_ahead_invalid = true;                         /* ditto            */
     }
 }
 
@@ -4598,6 +5033,8 @@ performer::output_func ()
 
         pad().set_current_tick(startpoint);
         set_last_ticks(startpoint);
+        m_ahead_tick = startpoint;
+        m_ahead_invalid = false;
 
         /*
          * We still need to make sure the BPM and PPQN changes are airtight!
@@ -4610,6 +5047,7 @@ performer::output_func ()
         int bpm_times_ppqn = bpmfactor * ppqn;
         double dct = double_ticks_from_ppqn(ppqn);
         double pus = pulse_length_us(bpmfactor, ppqn);
+        m_ahead_pulse_us = pus;
         long current;                           /* current time             */
         long elapsed_us, delta_us;              /* current - last           */
         long last = microtime();                /* beginning time           */
@@ -4624,6 +5062,8 @@ performer::output_func ()
                 bpm_times_ppqn = bpmfactor * ppqn;
                 dct = double_ticks_from_ppqn(ppqn);
                 pus = pulse_length_us(bpmfactor, ppqn);
+                m_ahead_pulse_us = pus;
+                m_ahead_invalid = true;         /* re-render at new tempo   */
                 m_resolution_change = false;
             }
 
@@ -4652,6 +5092,7 @@ performer::output_func ()
                 }
             }
 
+            (void) jack_apply_transport();      /* JACK thread's news   */
             bool jackrunning = jack_output(pad());
             if (jackrunning)
             {
@@ -4698,7 +5139,10 @@ performer::output_func ()
 
                         midipulse ltick = get_left_tick();
                         set_last_ticks(ltick);
+                        m_ahead_tick = ltick;
                         pad().js_current_tick = double(ltick) + leftover_tick;
+                        if (chasing())
+                            chase_sequences(ltick);
                     }
                     else
                         jack_position_once = false;
@@ -4711,6 +5155,9 @@ performer::output_func ()
 
                 if (jack_transport_not_starting())
                 {
+                    if (m_chase_pending)
+                        chase_sequences(midipulse(pad().js_current_tick));
+
                     play(midipulse(pad().js_current_tick));
                 }
 
@@ -4723,6 +5170,21 @@ performer::output_func ()
                 m_master_bus->emit_clock(midipulse(pad().js_clock_tick));
             }
 
+            m_master_bus->drain_bandwidth();        /* shaped output queues */
+            if (m_shared_status)
+                m_shared_status->publish(*this);    /* throttled, try-lock  */
+
+            if (m_hot_swap.pending() && ! m_hot_swap.controls_due())
+            {
+                midipulse bar = measures_to_ticks
+                (
+                    get_beats_per_bar(), ppqn, get_beat_width()
+                );
+                midipulse tick = midipulse(pad().js_current_tick);
+                if (m_hot_swap.bar_crossed(tick, bar))
+                    publish_patterns();             /* see hotswap module   */
+            }
+
             /*
              *  See "microsleep() call" in banner.  Code is similar to line
              *  3096 above.
@@ -4760,6 +5222,8 @@ performer::output_func ()
                 }
 #endif
                 m_delta_us = delta_us;
+                if (m_shared_status && delta_us < 0)
+                    m_shared_status->note_underrun(-delta_us);
             }
             if (pad().js_jack_stopped)
                 inner_stop();
@@ -4787,8 +5251,11 @@ performer::output_func ()
          * if m_usemidiclock == true.
          */
 
+        m_master_bus->release_ahead();      /* Note Offs rendered ahead     */
         m_master_bus->flush();
         m_master_bus->stop();
+        if (m_shared_status)
+            m_shared_status->publish(*this, true);  /* show the stop        */
     }
     (void) set_timer_services(false);
 }
@@ -4847,6 +5314,27 @@ performer::input_func ()
         {
             if (! poll_cycle())
                 break;
+
+            if (! is_running())
+                (void) jack_apply_transport();      /* output thread idle   */
+
+            if (m_thru_routes.take_dirty())
+            {
+                build_thru_routes();                /* e.g. to release keys */
+                build_record_routes();
+            }
+
+            if (m_hot_swap.pending())
+            {
+                if (! is_running())
+                    publish_patterns();             /* output thread idle   */
+
+                if (m_hot_swap.controls_due() || ! is_running())
+                    publish_controls();
+            }
+
+            if (m_shared_status && ! is_running())
+                m_shared_status->publish(*this);    /* output thread idle   */
         }
         set_timer_services(false);
     }
@@ -4886,6 +5374,12 @@ performer::poll_cycle ()
 
                 if (ev.below_sysex())                       /* below 0xF0   */
                 {
+                    if (m_thru_routes.take_dirty())
+                    {
+                        build_thru_routes();
+                        build_record_routes();
+                    }
+
                     if (m_master_bus->is_dumping())         /* see banner   */
                     {
                         if (midi_control_event(ev, true))   /* quick check  */
@@ -4894,32 +5388,25 @@ performer::poll_cycle ()
                         }
                         else
                         {
-                            ev.set_timestamp(get_tick());
-                            if (record_by_buss())
+                            midipulse tick = get_tick();
+                            (void) m_thru_routes.route_event
+                            (
+                                ev, *m_master_bus, tick     /* echo first   */
+                            );
+                            ev.set_timestamp(tick);
+                            if (record_by_buss() || record_by_channel())
                             {
-                                sequence * sp = sequence_inbus_lookup(ev);
-
                                 /*
                                  * mastermidibase::m_seq is not ever set here.
-                                 *
-                                 * if (is_nullptr(sp))
-                                 *    sp = m_master_bus->get_sequence();
+                                 * The targets replace sequence_inbus_lookup()
+                                 * and mastermidibase::dump_midi_input().
                                  */
 
-                                if (not_nullptr(sp))
-                                    sp->stream_event(ev);
-#if defined SEQ66_PLATFORM_DEBUG
-                                else
-                                    warn_message("no buss-recording pattern");
-#endif
-                            }
-                            else if (record_by_channel())
-                            {
 #if defined SEQ66_PLATFORM_DEBUG
-                                if (! m_master_bus->dump_midi_input(ev))
-                                    warn_message("no matching channel");
+                                if (! m_record_routes.route_event(ev))
+                                    warn_message("no recording pattern");
 #else
-                                (void)m_master_bus->dump_midi_input(ev);
+                                (void) m_record_routes.route_event(ev);
 #endif
                             }
                             else
@@ -5290,11 +5777,8 @@ performer::start_playing ()
         if (is_jack_master() && ! m_dont_reset_ticks)
             position_jack(false, 0);
 
-        if (resume_note_ons())
-        {
-            for (auto seqi : play_set().seq_container())
-                seqi->resume_note_ons(get_tick());
-        }
+        if (chasing())
+            chase_sequences(get_tick());
     }
     if (m_play_list->auto_arm())
         set_song_mute(mutegroups::action::off);
@@ -5575,20 +6059,145 @@ performer::play (midipulse tick)
         }
         else
         {
+            std::lock_guard<std::recursive_mutex> lk(m_batch_mutex);
             bool songmode = song_mode();
             set_tick(tick);
-            for (auto seqi : play_set().seq_container())
+            if (use_render_ahead())
             {
-                if (seqi)
-                    seqi->play_queue(tick, songmode, resume_note_ons());
+                render_ahead(tick, songmode);           /* queue flushes    */
+            }
+            else
+            {
+                if (use_play_pool())
+                {
+                    m_play_pool->play
+                    (
+                        play_set().seq_container(), tick,
+                        songmode, chasing()
+                    );
+                }
                 else
-                    append_error_message("play on null sequence");
+                {
+                    for (auto seqi : play_set().seq_container())
+                    {
+                        if (seqi)
+                        {
+                            seqi->play_queue
+                            (
+                                tick, songmode, chasing()
+                            );
+                        }
+                        else
+                            append_error_message("play on null sequence");
+                    }
+                }
+                m_master_bus->flush();                  /* flush MIDI buss  */
+            }
+        }
+    }
+}
+
+/**
+ *  Set on the output thread while it renders ahead, so that the changes the
+ *  patterns make to themselves while playing do not trigger a re-render.
+ */
+
+static thread_local bool s_rendering_ahead = false;
+
+/**
+ *  Used when render-ahead is active (see the renderahead module).  Renders
+ *  the play-set from the last rendered pulse up to the look-ahead pulse,
+ *  and schedules each event on the master buss with a delay calculated from
+ *  its pulse.  In loop mode, rendering stops at the R marker; the output
+ *  thread handles the wrap-around.
+ *
+ *  The delay of each event comes from its rendered stamp, which is the
+ *  absolute pulse (see sequence::play()), not the offset stamp used to find
+ *  the events in the pattern's frame.
+ *
+ *  If a change was signalled by invalidate_ahead() (or by a reposition or
+ *  tempo change), the scheduled events are dropped first (except the Note
+ *  Offs, which are replaced by the re-rendered ones, see
+ *  renderahead::schedule()) and the patterns are rewound to the current
+ *  pulse.  Tempo events
+ *  are applied when rendered, up to a look-ahead period early.  The
+ *  play-set is rendered serially, even if "play-workers" is set.
+ *
+ * \param tick
+ *      The current pulse.
+ *
+ * \param songmode
+ *      The song-mode flag passed to sequence::play_queue().
+ */
+
+void
+performer::render_ahead (midipulse tick, bool songmode)
+{
+    if (m_ahead_pulse_us <= 0.0)
+        return;
+
+    if (m_ahead_invalid.exchange(false))
+    {
+        (void) m_master_bus->invalidate_ahead();
+        set_last_ticks(tick);
+        m_ahead_tick = tick;
+    }
+
+    double aheadus = double(m_master_bus->render_ahead_ms()) * 1000.0;
+    midipulse target = tick + midipulse(aheadus / m_ahead_pulse_us);
+    if (looping())
+    {
+        midipulse rtick = get_right_tick();
+        if (target >= rtick)
+            target = rtick - 1;
+    }
+    if (target > m_ahead_tick)
+    {
+        s_rendering_ahead = true;
+        m_ahead_buffer.clear();
+        for (auto seqi : play_set().seq_container())
+        {
+            if (seqi)
+            {
+                seqi->render_to(&m_ahead_buffer);
+                seqi->play_queue(target, songmode, chasing());
+                seqi->render_to(nullptr);
             }
-            m_master_bus->flush();                      /* flush MIDI buss  */
         }
+        std::sort(m_ahead_buffer.begin(), m_ahead_buffer.end());
+        for (auto & ri : m_ahead_buffer)
+        {
+            if (ri.ev.is_tempo())
+            {
+                (void) set_beats_per_minute(ri.ev.tempo());
+            }
+            else
+            {
+                midipulse pulses = ri.stamp - tick;     /* absolute pulse   */
+                long delay = long(double(pulses) * m_ahead_pulse_us);
+                m_master_bus->schedule(ri.bus, ri.ev, ri.channel, delay);
+            }
+        }
+        s_rendering_ahead = false;
+        m_ahead_tick = target;
     }
 }
 
+/**
+ *  Signals the output thread that the events rendered ahead are out of
+ *  date.  Called when a pattern is changed, muted, or queued (see
+ *  sequence::set_dirty_mp()).  Changes made by the patterns themselves
+ *  while being rendered are ignored.  Only a flag is set, so this is cheap
+ *  when render-ahead is not active.
+ */
+
+void
+performer::invalidate_ahead ()
+{
+    if (! s_rendering_ahead)
+        m_ahead_invalid = true;
+}
+
 void
 performer::play_all_sets (midipulse tick)
 {
@@ -5596,7 +6205,7 @@ performer::play_all_sets (midipulse tick)
     {
         set_tick(tick);
         sequence::playback songmode = song_start_mode();
-        set_mapper().play_all_sets(tick, songmode, resume_note_ons());
+        set_mapper().play_all_sets(tick, songmode, chasing());
         m_master_bus->flush();                          /* flush MIDI buss  */
     }
 }
@@ -6990,7 +7599,10 @@ performer::sequence_playing_toggle (seq::number seqno)
                 unset_queued_replace();
                 off_sequences();
             }
-            s->toggle_playing(get_tick(), resume_note_ons());   /* kepler34 */
+            s->toggle_playing                       /* kepler34     */
+            (
+                get_tick(), resume_note_ons(), resume_controls()
+            );
         }
 
         /*
@@ -7097,7 +7709,10 @@ performer::replace_for_solo (seq::number seqno, bool queued)
                 automation::action::on, cs
             );
             if (s->muted())
-                s->toggle_playing(get_tick(), resume_note_ons());
+                s->toggle_playing
+                (
+                    get_tick(), resume_note_ons(), resume_controls()
+                );
 
             /*
              * TODO: how can we wait until queuing is complete?
@@ -7336,7 +7951,7 @@ performer::midi_control_keystroke (const keystroke & k)
     {
         if (kkey.is_press())
         {
-            if (m_key_controls.use_auto_shift())
+            if (key_controls().use_auto_shift())
                 kkey.shift_lock();      /* employ the auto-shift feature    */
         }
         else
@@ -7344,7 +7959,7 @@ performer::midi_control_keystroke (const keystroke & k)
     }
     if (result)
     {
-        const keycontrol & kc = m_key_controls.control(kkey.key());
+        const keycontrol & kc = key_controls().control(kkey.key());
         result = kc.is_usable();
         if (result)
         {
@@ -7760,7 +8375,11 @@ bool
 performer::apply_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
-    bool result = set_mapper().apply_mutes(group);
+    bool result;
+    {
+        batch b(*this);
+        result = set_mapper().apply_mutes(group);
+    }
     if (result)
     {
         send_mutes_events(group, oldgroup);
@@ -7772,7 +8391,11 @@ performer::apply_mutes (mutegroup::number group)
 bool
 performer::unapply_mutes (mutegroup::number group)
 {
-    bool result = set_mapper().unapply_mutes(group);
+    bool result;
+    {
+        batch b(*this);
+        result = set_mapper().unapply_mutes(group);
+    }
     if (result)
     {
         midi_control_out().send_mutes_event(group, midicontrolout::action_off);
@@ -7789,7 +8412,10 @@ performer::unapply_mutes (mutegroup::number group)
 void
 performer::select_and_mute_group (mutegroup::number mg)
 {
-    set_mapper().select_and_mute_group(mg);
+    {
+        batch b(*this);
+        set_mapper().select_and_mute_group(mg);
+    }
     notify_mutes_change(mg, change::no);       /* ca 2023-11-06 */
 }
 
@@ -7797,7 +8423,11 @@ bool
 performer::toggle_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
-    bool result = set_mapper().toggle_mutes(group);
+    bool result;
+    {
+        batch b(*this);
+        result = set_mapper().toggle_mutes(group);
+    }
     if (result)
     {
         mutegroup::number newgroup = mutes().group_selected();
@@ -7811,7 +8441,11 @@ bool
 performer::toggle_active_mutes (mutegroup::number group)
 {
     mutegroup::number oldgroup = mutes().group_selected();
-    bool result = set_mapper().toggle_active_mutes(group);
+    bool result;
+    {
+        batch b(*this);
+        result = set_mapper().toggle_active_mutes(group);
+    }
     if (result)
     {
         mutegroup::number newgroup = mutes().group_selected();
@@ -8095,13 +8729,13 @@ performer::mute_group_control
              * different thread, causing a crash. However, if all works,
              * the MIDI controller will display the new mutegroup.
              *
-             * keystroke k = m_key_controls.mute_keystroke(gn);
+             * keystroke k = key_controls().mute_keystroke(gn);
              * group_learn_complete(k, result);
              */
 
             std::string statusmsg = result ? "Succeeded" : "Failed" ;
             std::string msg = "Learning of mute-group key ";
-            msg += m_key_controls.mute_key(gn);
+            msg += key_controls().mute_key(gn);
             session_message(statusmsg, msg);
             group_learn(false);
             announce_mutes();
@@ -8971,10 +9605,42 @@ performer::read_midi_file
 
 bool
 performer::open_note_mapper (const std::string & notefile)
+{
+    std::shared_ptr<notemapper> nm;
+    bool result = read_note_mapper(notefile, nm);
+    if (nm)
+    {
+        std::atomic_store(&m_note_mapper, nm);
+        thru_changed();
+    }
+    return result;
+}
+
+/**
+ *  Creates a new note-mapper and reads the note-map file into it.  The
+ *  mapper is created even if the file cannot be read.
+ *
+ * \param notefile
+ *      The full path to the note-map file.
+ *
+ * \param [out] nm
+ *      Receives the new note-mapper, or a null pointer if it could not be
+ *      created.
+ *
+ * \return
+ *      Returns true if the file was read.
+ */
+
+bool
+performer::read_note_mapper
+(
+    const std::string & notefile,
+    std::shared_ptr<notemapper> & nm
+)
 {
     bool result = false;
-    m_note_mapper.reset(new (std::nothrow) notemapper());
-    if (m_note_mapper)
+    nm.reset(new (std::nothrow) notemapper());
+    if (nm)
     {
         if (notefile.empty() || ! rc().notemap_active())
         {
@@ -8984,7 +9650,7 @@ performer::open_note_mapper (const std::string & notefile)
         {
             if (file_readable(notefile))
             {
-                notemapfile nmf(*m_note_mapper, notefile, rc());
+                notemapfile nmf(*nm, notefile, rc());
                 result = nmf.parse();
                 if (! result)
                     append_error_message(nmf.get_error_message());
@@ -8999,10 +9665,218 @@ performer::open_note_mapper (const std::string & notefile)
     return result;
 }
 
+/**
+ *  Reads a note-map file into a new note-mapper.  While playing, the new
+ *  mapper is published at the next bar boundary; otherwise it is used at
+ *  once.
+ */
+
+bool
+performer::stage_note_mapper (const std::string & notefile)
+{
+    std::shared_ptr<notemapper> nm;
+    bool result = read_note_mapper(notefile, nm);
+    if (result)
+    {
+        if (is_running())
+        {
+            m_hot_swap.stage_note_mapper(nm);
+        }
+        else
+        {
+            std::atomic_store(&m_note_mapper, nm);
+            thru_changed();
+        }
+    }
+    return result;
+}
+
+/**
+ *  Reads a 'ctrl' file into a copy of the 'rc' settings, and stages the
+ *  MIDI and key controls it contains.  They are swapped in by the input
+ *  thread, at the next bar boundary if playing.  The live controls are not
+ *  touched while the file is read.
+ */
+
+bool
+performer::stage_control_file (const std::string & ctrlfile)
+{
+    bool result = file_readable(ctrlfile);
+    if (result)
+    {
+        rcsettings rcs(rc());
+        result = read_midi_control_file(ctrlfile, rcs);
+        if (result)
+            stage_controls(rcs);
+        else
+            append_error_message("Cannot parse: " + ctrlfile);
+    }
+    else
+        append_error_message("Cannot read: " + ctrlfile);
+
+    return result;
+}
+
+/**
+ *  Stages copies of the MIDI and key controls of the given settings,
+ *  prepared as get_settings() and launch() prepare them.
+ */
+
+void
+performer::stage_controls (const rcsettings & rcs)
+{
+    keycontainer kc = rcs.key_controls().count() > 0 ?
+        rcs.key_controls() : key_controls() ;
+
+    midicontrolin mci = rcs.midi_control_in();
+    if (mci.count() == 0 && rcs.key_controls().count() > 0)
+        mci.add_blank_controls(kc);
+
+    if (mci.is_enabled())
+        mci.true_buss(true_input_bus(mci.nominal_buss()));
+
+    m_hot_swap.stage_controls(mci, kc);
+}
+
+/**
+ *  Reads a mute-groups file into a copy of the current mute-groups, and
+ *  stages it.  It is swapped in by the input thread, at the next bar
+ *  boundary if playing.
+ */
+
+bool
+performer::stage_mute_groups (const std::string & mfg)
+{
+    bool result = false;
+    std::string mgfname = mfg.empty() ? rc().mute_group_filespec() : mfg ;
+    if (mgfname.empty())
+    {
+        append_error_message("no mute-group filename");
+    }
+    else
+    {
+        mutegroups mg(mutes());
+        result = seq66::open_mutegroups(mgfname, mg);
+        if (result)
+        {
+            mg.group_save(rc().mute_group_save());
+            m_hot_swap.stage_mutes(mg);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Called by the output thread at a bar boundary, or by the input thread
+ *  while not playing.  The staged patterns are already installed in the
+ *  set-mapper, and in the ready play-set; this function only swaps that
+ *  play-set and the staged note-mapper in, so it allocates, frees, and
+ *  notifies nothing.  Any staged controls are then due for the input
+ *  thread; see publish_controls().
+ */
+
+void
+performer::publish_patterns ()
+{
+    bool nmchanged = false;
+    bool pschanged = false;
+    {
+        std::lock_guard<std::recursive_mutex> lk(m_batch_mutex);
+        pschanged = m_hot_swap.publish_patterns
+        (
+            play_set(), m_note_mapper, nmchanged
+        );
+    }
+    if (pschanged || nmchanged)
+        thru_changed();
+}
+
+/**
+ *  Called by the input thread, which is the thread that reads the MIDI
+ *  controls, once the output thread has reached the bar boundary (or at
+ *  any time while not playing).  Swaps in the staged controls, and
+ *  publishes the key controls and mute-groups by atomic pointer exchange,
+ *  as the user-interface reads them without a lock.
+ */
+
+void
+performer::publish_controls ()
+{
+    bool mgchanged = false;
+    bool ok = m_hot_swap.publish_controls
+    (
+        m_midi_control_in, m_key_controls, m_mute_groups, mgchanged
+    );
+    if (ok && mgchanged)
+        notify_mutes_change(mutegroup::unassigned(), change::no);
+}
+
+/**
+ *  Called by the input thread after thru_changed().  Rebuilds the MIDI Thru
+ *  routes in the same order that poll_cycle() looks for the pattern to
+ *  record into.  If no routes are left, the notes still sounding through
+ *  the old routes are turned off.
+ */
+
+void
+performer::build_thru_routes ()
+{
+    m_thru_routes.clear();
+    if (m_master_bus->is_dumping())
+    {
+        std::shared_ptr<notemapper> nm = std::atomic_load(&m_note_mapper);
+        if (record_by_buss())
+        {
+            for (auto sp : m_buss_patterns)
+                m_thru_routes.add(*sp, nm.get(), sp->true_in_bus(), true);
+        }
+        else if (record_by_channel())
+        {
+            for (auto sp : m_master_bus->input_sequences())
+            {
+                if (not_nullptr(sp))
+                    m_thru_routes.add(*sp, nm.get(), null_buss(), false);
+            }
+        }
+        else
+        {
+            sequence * sp = m_master_bus->get_sequence();
+            if (not_nullptr(sp))
+                m_thru_routes.add(*sp, nm.get(), null_buss(), true);
+        }
+    }
+    if (m_thru_routes.empty())
+        m_thru_routes.release(*m_master_bus, get_tick());
+}
+
+/**
+ *  Called by the input thread after thru_changed(), right after
+ *  build_thru_routes().  Rebuilds the table of recording targets, so that
+ *  each incoming event is recorded with a single lookup.  The single input
+ *  pattern (neither by buss nor by channel) needs no table.
+ */
+
+void
+performer::build_record_routes ()
+{
+    if (m_master_bus->is_dumping())
+    {
+        if (record_by_buss())
+            m_record_routes.build_by_buss(m_buss_patterns);
+        else if (record_by_channel())
+            m_record_routes.build_by_channel(m_master_bus->input_sequences());
+        else
+            m_record_routes.clear();
+    }
+    else
+        m_record_routes.clear();
+}
+
 bool
 performer::save_note_mapper (const std::string & notefile)
 {
-    bool result = bool(m_note_mapper);
+    std::shared_ptr<notemapper> nm = std::atomic_load(&m_note_mapper);
+    bool result = bool(nm);
     if (result)
     {
         std::string nfname = rc().notemap_filespec();
@@ -9015,7 +9889,7 @@ performer::save_note_mapper (const std::string & notefile)
         }
         else
         {
-            notemapfile nmf(*m_note_mapper, nfname, rc());
+            notemapfile nmf(*nm, nfname, rc());
             result = nmf.write();
             if (! result)
                 append_error_message(nmf.get_error_message());
@@ -25,18 +25,22 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2023-10-31
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  See the playlistfile class for information on the file format.
  */
 
+#include <algorithm>                    /* std::sort(), std::unique()       */
+#include <atomic>                       /* std::atomic<>                    */
 #include <cctype>                       /* std::toupper() function          */
 #include <iostream>                     /* std::cout                        */
+#include <thread>                       /* std::thread                      */
 #include <utility>                      /* std::make_pair()                 */
 #include <string.h>                     /* memset()                         */
 
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
+#include "cfg/songcachefile.hpp"        /* seq66::songcachefile class       */
 #include "midi/wrkfile.hpp"             /* seq66::midifile & seq66::wrkfile */
 #include "play/playlist.hpp"            /* seq66::playlist support class    */
 #include "play/performer.hpp"           /* seq66::performer anchor class    */
@@ -84,6 +88,7 @@ playlist::playlist
     m_play_lists            (),
     m_loaded                (false),                /* playlist loaded      */
     m_deep_verify           (false),
+    m_song_cache            (),
     m_current_list          (m_play_lists.end()),
     m_current_song          (sm_dummy.end()),       /* song-list iterator   */
     m_auto_arm              (false),
@@ -339,10 +344,9 @@ playlist::open_select_song_by_midi (int ctrl, bool opensong)
  *  files are accessible.
  *
  * \param strong
- *      If true, also make sure the MIDI files open without error as well.
- *      The code is similar to read_midi_file() in the midifile module, but it
- *      does not make configuration settings.  Setting this option to true can
- *      slow startup way down if there are a lot of big files in the playlist.
+ *      If true, also make sure the MIDI files are sound, using
+ *      verify_songs().  The songs are not loaded into the performer, so
+ *      the current song is not affected.
  *
  * \return
  *      Returns true if all of the MIDI files are verifiable.  A blank
@@ -369,6 +373,7 @@ playlist::verify (bool strong)
     }
     if (result)
     {
+        std::vector<std::string> fnames;
         for (const auto & plpair : m_play_lists)
         {
             const song_list & sl = plpair.second.ls_song_list;
@@ -383,26 +388,7 @@ playlist::verify (bool strong)
                 }
                 if (file_exists(fname))
                 {
-                    if (strong)
-                    {
-                        /*
-                         * The file is parsed.  If the result is false, then
-                         * the play-list mode ends up false.  Let the caller
-                         * do the reporting on errors.
-                         */
-
-                        result = open_song(fname, true);
-                        if (result)
-                        {
-                            if (rc().verbose())
-                                file_message("Verified", fname);
-                        }
-                        else
-                        {
-                            set_file_error_message("song '%s' missing", fname);
-                            break;
-                        }
-                    }
+                    fnames.push_back(fname);
                 }
                 else
                 {
@@ -415,6 +401,14 @@ playlist::verify (bool strong)
             if (! result)
                 break;
         }
+        if (result)
+        {
+            if (m_song_cache.empty())
+                (void) load_song_cache();
+
+            if (strong)
+                result = verify_songs(fnames);
+        }
     }
     else
     {
@@ -426,6 +420,153 @@ playlist::verify (bool strong)
     return result;
 }
 
+/**
+ *  Makes sure that each song file can be parsed, without loading it into
+ *  the performer.  Songs whose summary in the song cache is still current
+ *  (same size and modification time) are not scanned again.  The rest are
+ *  scanned by a group of threads, each one using a detached songinfo
+ *  object.  If anything changed, the song cache is rewritten.
+ *
+ * \param fnames
+ *      The full paths to the songs, in playlist order.  Each file is known
+ *      to exist.
+ *
+ * \return
+ *      Returns true if every song scanned without error.  Otherwise the
+ *      first error is reported.
+ */
+
+bool
+playlist::verify_songs (const std::vector<std::string> & fnames)
+{
+    std::vector<std::string> pending;
+    for (const auto & fname : fnames)
+    {
+        auto sci = m_song_cache.find(fname);
+        if (sci == m_song_cache.end() || ! sci->second.current(fname))
+            pending.push_back(fname);
+    }
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+    if (! pending.empty())
+    {
+        std::vector<songinfo> infos(pending.size());
+        std::atomic<size_t> next(0);
+        auto worker = [&pending, &infos, &next] ()
+        {
+            for (;;)
+            {
+                size_t i = next++;
+                if (i >= pending.size())
+                    break;
+
+                (void) infos[i].scan(pending[i]);
+            }
+        };
+        size_t count = size_t(std::thread::hardware_concurrency());
+        if (count == 0)
+            count = 2;
+
+        if (count > pending.size())
+            count = pending.size();
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < count; ++t)
+            threads.emplace_back(worker);
+
+        worker();                               /* this thread helps out    */
+        for (auto & t : threads)
+            t.join();
+
+        for (size_t i = 0; i < pending.size(); ++i)
+            m_song_cache[pending[i]] = infos[i];
+    }
+
+    bool result = true;
+    songinfo_map listed;                        /* drops songs not listed   */
+    for (const auto & fname : fnames)
+    {
+        const songinfo & si = m_song_cache[fname];
+        listed[fname] = si;
+        if (! result)
+            continue;
+
+        if (si.valid())
+        {
+            if (rc().verbose())
+                file_message("Verified", fname);
+        }
+        else
+        {
+            std::string msg = "song '" + fname + "': " + si.error();
+            set_error_message(msg);
+            result = false;
+        }
+    }
+    bool changed = ! pending.empty() || listed.size() != m_song_cache.size();
+    m_song_cache.swap(listed);
+    if (changed)
+        (void) save_song_cache();
+
+    return result;
+}
+
+/**
+ *  The song cache has the same path and base name as the playlist file,
+ *  with the extension ".songcache".
+ */
+
+std::string
+playlist::song_cache_filename () const
+{
+    return file_extension_set(file_name(), ".songcache");
+}
+
+bool
+playlist::load_song_cache ()
+{
+    bool result = ! file_name().empty();
+    if (result)
+    {
+        std::string fname = song_cache_filename();
+        result = file_exists(fname);
+        if (result)
+        {
+            songcachefile scf(fname, m_song_cache, rc());
+            result = scf.parse();
+        }
+    }
+    return result;
+}
+
+bool
+playlist::save_song_cache ()
+{
+    bool result = ! file_name().empty();
+    if (result)
+    {
+        songcachefile scf(song_cache_filename(), m_song_cache, rc());
+        result = scf.write();
+    }
+    return result;
+}
+
+/**
+ *  Returns the cached summary of the current song, or an empty string if
+ *  the song has not been verified.
+ */
+
+std::string
+playlist::song_summary () const
+{
+    std::string result;
+    auto sci = m_song_cache.find(song_filepath());
+    if (sci != m_song_cache.end())
+        result = sci->second.summary();
+
+    return result;
+}
+
 /**
  *  This function copies all of the MIDI files in all of the play-lists to a
  *  new root directory.
@@ -0,0 +1,282 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playpool.cpp
+ *
+ *  This module defines the parallel pattern-evaluation pool.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of playpool.hpp.
+ */
+
+#include <algorithm>                    /* std::sort()                      */
+
+#include "midi/mastermidibus.hpp"       /* seq66::mastermidibus             */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/playpool.hpp"            /* seq66::playpool                  */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "util/basic_macros.hpp"        /* seq66::infoprintf(), not_nullptr */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The maximum number of workers.  More than this is unlikely to help, since
+ *  the merge and output are still serial.
+ */
+
+static const int c_max_play_workers = 16;
+
+playpool::playpool (performer & p) :
+    m_parent        (p),
+    m_threads       (),
+    m_jobs          (),
+    m_serial        (),
+    m_buffers       (),
+    m_merged        (),
+    m_mutex         (),
+    m_start_cv      (),
+    m_done_cv       (),
+    m_generation    (0),
+    m_pending       (0),
+    m_exit          (false),
+    m_tick          (0),
+    m_song_mode     (false),
+    m_resume        (false)
+{
+    // no code
+}
+
+playpool::~playpool ()
+{
+    stop();
+}
+
+/**
+ *  Creates the worker threads.  There is one job list and one render
+ *  buffer per worker, plus a render buffer for the output thread.
+ *
+ * \param workers
+ *      The number of worker threads, clamped to c_max_play_workers.
+ *
+ * \return
+ *      Returns true if the workers were started.
+ */
+
+bool
+playpool::start (int workers)
+{
+    bool result = workers > 0 && ! active();
+    if (result)
+    {
+        if (workers > c_max_play_workers)
+            workers = c_max_play_workers;
+
+        m_exit = false;
+        m_pending = 0;
+        m_jobs.resize(std::size_t(workers));
+        m_buffers.resize(std::size_t(workers + 1));
+        for (int w = 0; w < workers; ++w)
+            m_threads.emplace_back(&playpool::worker_func, this, w);
+
+        infoprintf("%d pattern-evaluation workers started", workers);
+    }
+    return result;
+}
+
+void
+playpool::stop ()
+{
+    if (active())
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_exit = true;
+        }
+        m_start_cv.notify_all();
+        for (auto & t : m_threads)
+        {
+            if (t.joinable())
+                t.join();
+        }
+        m_threads.clear();
+        m_jobs.clear();
+        m_buffers.clear();
+    }
+}
+
+/**
+ *  Indicates if a sequence can be played on a worker thread.  The
+ *  metronome, song-recording, and queued or one-shot patterns call back
+ *  into the performer (count-in, trigger notification, control status),
+ *  so they are kept on the output thread.  So are all patterns in song
+ *  mode, and armed patterns that are song-muted, because the triggers can
+ *  arm or disarm a pattern, and sequence::set_armed() announces the
+ *  pattern, sets it dirty, and sends its Note Offs.
+ *
+ * \param s
+ *      The sequence to check.
+ *
+ * \param songmode
+ *      The song-mode flag passed to sequence::play_queue().
+ */
+
+bool
+playpool::parallel_safe (const sequence & s, bool songmode)
+{
+    return ! songmode && ! s.is_metro_seq() && ! s.song_recording() &&
+        ! s.get_queued() && ! s.one_shot() &&
+        ! (s.get_song_mute() && s.armed());
+}
+
+/**
+ *  Plays one cycle of the given sequences.  The parallel-safe sequences are
+ *  dealt round-robin to the workers; the rest are played here while the
+ *  workers run.  Then the render buffers are merged and sent.  The caller
+ *  (performer::play()) flushes the master buss.
+ */
+
+void
+playpool::play
+(
+    const seqlist & seqs, midipulse tick,
+    bool songmode, bool resumenoteons
+)
+{
+    int workers = this->workers();
+    if (workers == 0)
+        return;
+
+    for (auto & j : m_jobs)
+        j.clear();
+
+    m_serial.clear();
+    int next = 0;
+    for (const auto & sp : seqs)
+    {
+        sequence * s = sp.get();
+        if (is_nullptr(s))
+            continue;
+
+        if (parallel_safe(*s, songmode))
+        {
+            m_jobs[std::size_t(next)].push_back(s);
+            if (++next == workers)
+                next = 0;
+        }
+        else
+            m_serial.push_back(s);
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_tick = tick;
+        m_song_mode = songmode;
+        m_resume = resumenoteons;
+        m_pending = workers;
+        ++m_generation;
+    }
+    m_start_cv.notify_all();
+    play_jobs(m_serial, m_buffers.back());
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_done_cv.wait(lk, [this] { return m_pending == 0; });
+    }
+
+    mastermidibase * mmb = m_parent.master_bus();
+    if (not_nullptr(mmb))
+        merge(*mmb);
+}
+
+/**
+ *  Plays a list of sequences, each rendering into the given buffer.
+ */
+
+void
+playpool::play_jobs (std::vector<sequence *> & jobs, renderbuffer & rb)
+{
+    rb.clear();
+    for (auto s : jobs)
+    {
+        s->render_to(&rb);
+        s->play_queue(m_tick, m_song_mode, m_resume);
+        s->render_to(nullptr);
+    }
+}
+
+void
+playpool::worker_func (int index)
+{
+    unsigned seen = 0;
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (;;)
+    {
+        m_start_cv.wait(lk, [&] { return m_exit || m_generation != seen; });
+        if (m_exit)
+            break;
+
+        seen = m_generation;
+        lk.unlock();
+        play_jobs(m_jobs[std::size_t(index)], m_buffers[std::size_t(index)]);
+        lk.lock();
+        if (--m_pending == 0)
+            m_done_cv.notify_one();
+    }
+}
+
+/**
+ *  Gathers all of the render buffers, sorts them by time-stamp (the
+ *  absolute pulse, see sequence::play()), sequence number, and generation
+ *  order, and sends the events.  Tempo events are
+ *  applied to the performer here, on the output thread.
+ */
+
+void
+playpool::merge (mastermidibase & mmb)
+{
+    m_merged.clear();
+    for (auto & rb : m_buffers)
+        m_merged.insert(m_merged.end(), rb.begin(), rb.end());
+
+    std::sort(m_merged.begin(), m_merged.end());
+    for (auto & ri : m_merged)
+    {
+        if (ri.ev.is_tempo())
+            (void) m_parent.set_beats_per_minute(ri.ev.tempo());
+        else
+            mmb.play(ri.bus, &ri.ev, ri.channel);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * playpool.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
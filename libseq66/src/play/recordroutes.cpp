@@ -0,0 +1,183 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          recordroutes.cpp
+ *
+ *  This module defines the precompiled table of recording targets.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of recordroutes.hpp.
+ */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "play/recordroutes.hpp"        /* seq66::recordroutes              */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "util/basic_macros.hpp"        /* not_nullptr() macro              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+recordroutes::recordroutes () :
+    m_by_buss   (false),
+    m_table     ()
+{
+    // no code
+}
+
+/**
+ *  Builds the table for recording by buss.
+ *
+ * \param patterns
+ *      The patterns that have an input buss, in the order of the old
+ *      search.  The first one found for a buss claims it.
+ */
+
+void
+recordroutes::build_by_buss (const std::vector<sequence *> & patterns)
+{
+    m_by_buss = true;
+    m_table.clear();
+    for (auto sp : patterns)
+    {
+        if (is_nullptr(sp))
+            continue;
+
+        bussbyte b = sp->true_in_bus();
+        if (is_null_buss(b))
+            continue;
+
+        size_t first = size_t(b) * c_midichannel_max;
+        if (m_table.size() < first + c_midichannel_max)
+            m_table.resize(first + c_midichannel_max);
+
+        if (m_table[first].empty())                 /* not claimed yet      */
+        {
+            for (int ch = 0; ch < c_midichannel_max; ++ch)
+                m_table[first + ch].push_back(sp);
+        }
+    }
+}
+
+/**
+ *  Builds the table for recording by channel.
+ *
+ * \param patterns
+ *      The recording patterns, in the order of the old search (see
+ *      mastermidibase::input_sequences()).
+ */
+
+void
+recordroutes::build_by_channel (const std::vector<sequence *> & patterns)
+{
+    m_by_buss = false;
+    m_table.clear();
+    m_table.resize(c_midichannel_max);
+    for (int ch = 0; ch < c_midichannel_max; ++ch)
+    {
+        for (auto sp : patterns)
+        {
+            if (is_nullptr(sp))
+                continue;
+
+            if (sp->channel_match())
+            {
+                if (sp->seq_midi_channel() == midibyte(ch))
+                {
+                    m_table[ch].push_back(sp);
+                    break;                          /* it ends the search   */
+                }
+            }
+            else
+                m_table[ch].push_back(sp);          /* takes every channel  */
+        }
+    }
+}
+
+/**
+ * \return
+ *      Returns the recording targets for the buss and channel, or a null
+ *      pointer if there are none.
+ */
+
+const recordroutes::targets *
+recordroutes::lookup (bussbyte buss, midibyte channel) const
+{
+    size_t row = m_by_buss ? size_t(buss) : 0 ;
+    size_t index = row * c_midichannel_max + size_t(channel & 0x0F);
+    if (index < m_table.size())
+    {
+        const targets & t = m_table[index];
+        if (! t.empty())
+            return &t;
+    }
+    return nullptr;
+}
+
+const recordroutes::targets *
+recordroutes::lookup (const event & ev) const
+{
+    midibyte channel = event::mask_channel(ev.get_status());
+    return lookup(ev.input_bus(), channel);
+}
+
+/**
+ *  Records an incoming event into its targets.  As in the old search, the
+ *  same copy of the event is passed along, so a later target sees the
+ *  timestamp as adjusted by an earlier one.
+ *
+ * \param ev
+ *      The event, with the current tick as its timestamp, passed as a copy.
+ *
+ * \return
+ *      Returns true if a pattern took the event.
+ */
+
+bool
+recordroutes::route_event (event ev) const
+{
+    bool result = false;
+    const targets * t = lookup(ev);
+    if (not_nullptr(t))
+    {
+        for (auto sp : *t)
+        {
+            if (sp->stream_event(ev))
+                result = true;
+        }
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * recordroutes.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -34,7 +34,7 @@
  *  interface.
  */
 
-#include <algorithm>                    /* std::find_if()                   */
+#include <algorithm>                    /* std::find_if(), upper_bound()    */
 #include <iomanip>                      /* std::setw() manipulator          */
 #include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
@@ -77,6 +77,7 @@ screenset::screenset (screenset::number setnum, int rows, int columns) :
     m_swap_coordinates  (usr().swap_coordinates()),
     m_set_size          (rows * columns),
     m_container         (),
+    m_play_view         (),
     m_set_number        (setnum),
     m_set_offset        (m_set_number * m_set_size),
     m_set_maximum       (m_set_offset + m_set_size),
@@ -116,6 +117,7 @@ screenset::clear ()
 {
     seq emptyseq;
     m_container.clear();
+    m_play_view.clear();
     for (int s = 0; s < m_set_size; ++s)
         m_container.push_back(emptyseq);
 }
@@ -134,7 +136,9 @@ screenset::initialize (int rows, int columns)
 
 /**
  *  Adds a sequence (and its seq maintenance object) to the container.  Recall
- *  that the container is a vector of constant size greater than 0.
+ *  that the container is a vector of constant size greater than 0.  The
+ *  sequence is also added, in slot order, to the play view.  Reserved
+ *  numbers (see sequence::is_reserved()) are skipped.
  *
  * \param s
  *      Provides the sequencer pointer, assumed to be valid.
@@ -155,9 +159,12 @@ screenset::add (sequence * s, seq::number & seqno)
     bool result = false;
     if (not_nullptr(s))
     {
-        for (seq::number i = seqno - offset(); i < m_set_maximum; ++i)
+        for (seq::number i = clamp(seqno); i < m_set_size; ++i)
         {
-            seq sseq = seqinfo(i);              /* get seq info in the set  */
+            if (sequence::is_reserved(i + offset()))
+                continue;
+
+            seq sseq = m_container.at(i);       /* get seq info in the set  */
             if (! sseq.active())                /* no seq already in slot?  */
             {
                 seqno = i + offset();           /* change to unused seqno   */
@@ -165,6 +172,15 @@ screenset::add (sequence * s, seq::number & seqno)
                 if (result)
                 {
                     m_container[i] = sseq;
+                    auto pos = std::upper_bound
+                    (
+                        m_play_view.begin(), m_play_view.end(), seqno,
+                        [] (seq::number n, const seq::pointer & sp)
+                        {
+                            return n < sp->seq_number();
+                        }
+                    );
+                    (void) m_play_view.insert(pos, sseq.loop());
                     break;
                 }
             }
@@ -196,6 +212,10 @@ screenset::remove (seq::number seqno)
         seq newseq;                         /* non-functional pattern       */
         sp->set_armed(false);               /* turns off all notes as well  */
         m_container[seqno - offset()] = newseq;
+        auto viewit = std::find(m_play_view.begin(), m_play_view.end(), sp);
+        if (viewit != m_play_view.end())
+            (void) m_play_view.erase(viewit);
+
         result = true;
     }
     return result;
@@ -212,12 +232,7 @@ screenset::remove (seq::number seqno)
 bool
 screenset::active () const
 {
-    for (auto & s : m_container)
-    {
-        if (s.active())
-            return true;
-    }
-    return false;
+    return ! m_play_view.empty();
 }
 
 /**
@@ -228,19 +243,10 @@ screenset::active () const
 int
 screenset::active_count () const
 {
-    int result = 0;
-    seq::number seqno = m_set_offset;
-    m_sequence_high = 0;                        /* a mutable member         */
-    for (auto & s : m_container)
-    {
-        if (s.active())
-        {
-            ++result;
-            if (seqno > m_sequence_high)
-                m_sequence_high = seqno;
-        }
-        ++seqno;
-    }
+    int result = int(m_play_view.size());
+    m_sequence_high = result > 0 ?              /* a mutable member         */
+        m_play_view.back()->seq_number() : 0 ;
+
     ++m_sequence_high;                          /* one more than high index */
     return result;
 }
@@ -255,16 +261,8 @@ screenset::active_count () const
 seq::number
 screenset::first_seq () const
 {
-    seq::number result = seq::unassigned();
-    for (auto & s : m_container)
-    {
-        if (s.active())
-        {
-            result = s.seq_number();
-            break;
-        }
-    }
-    return result;
+    return m_play_view.empty() ?
+        seq::unassigned() : m_play_view.front()->seq_number() ;
 }
 
 seq::number
@@ -1464,14 +1462,12 @@ playset::fill (const screenset & sset, bool clearit)
     auto r = m_screen_sets.insert(p);
     if (r.second)
     {
-        for (auto & s : sset.seq_container())
-        {
-            if (s.active())
-            {
-                m_sequence_array.push_back(s.loop());
-                result = true;
-            }
-        }
+        const screenset::playview & view = sset.play_view();
+        result = ! view.empty();
+        m_sequence_array.insert
+        (
+            m_sequence_array.end(), view.begin(), view.end()
+        );
     }
     return result;
 }
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-08-20
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The functionality of this class also includes handling some of the
@@ -153,6 +153,8 @@ sequence::sequence (int ppqn) :
     m_events                    (),
     m_triggers                  (*this),
     m_time_signatures           (),
+    m_meter_map                 (),
+    m_chase_index               (),
     m_events_undo_hold          (),
     m_have_undo                 (false),
     m_have_redo                 (false),
@@ -170,6 +172,8 @@ sequence::sequence (int ppqn) :
     m_notes_on                  (0),
     m_master_bus                (nullptr),
     m_playing_notes             (),
+    m_render                    (nullptr),
+    m_render_order              (0),
     m_armed                     (false),
     m_recording                 (false),
     m_draw_locked               (false),
@@ -182,6 +186,7 @@ sequence::sequence (int ppqn) :
     m_one_shot_tick             (0),
     m_step_count                (0),
     m_loop_count_max            (0),
+    m_cc_reducer                (),
     m_off_from_snap             (false),
     m_song_playback_block       (false),
     m_song_recording            (false),
@@ -230,6 +235,13 @@ sequence::sequence (int ppqn) :
     m_triggers.set_length(m_length);
     for (auto & p : m_playing_notes)            /* no notes playing now     */
         p = 0;
+
+    m_cc_reducer.configure
+    (
+        ccreducer::method_from_name(usr().new_pattern_reduction()),
+        usr().new_pattern_reduction_value(),
+        midipulse(usr().new_pattern_reduction_pulses()), int(m_ppqn)
+    );
 }
 
 /**
@@ -303,6 +315,7 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
         m_parent                    = rhs.m_parent;         /* a pointer    */
         m_events                    = rhs.m_events;         /* container!   */
         m_triggers                  = rhs.m_triggers;       /* 2021-07-27   */
+        (void) m_events.compact();                          /* old capacity */
 
         /*
          *  The triggers class has a parent that cannot be reassigned.
@@ -386,6 +399,11 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
         m_musical_key               = rhs.m_musical_key;
         m_musical_scale             = rhs.m_musical_scale;
         m_background_sequence       = rhs.m_background_sequence;
+        m_cc_reducer.configure
+        (
+            rhs.m_cc_reducer.get_method(), rhs.m_cc_reducer.value(),
+            rhs.m_cc_reducer.pulses(), int(m_ppqn)
+        );
         for (auto & p : m_playing_notes)            /* no notes playing now */
             p = 0;
 
@@ -396,6 +414,61 @@ sequence::partial_assign (const sequence & rhs, bool toclipboard)
     }
 }
 
+/**
+ *  Copies what midi_vector_base::fill() writes to a MIDI file, for a
+ *  background save (see midifile::snapshot()).  Unlike partial_assign(),
+ *  the events are not relinked, the undo lists are not copied, and nothing
+ *  is marked as modified, so the copy is cheap; the SysEx data of the events
+ *  is shared, not copied.  The copy has no parent or master buss, and is
+ *  meant only to be written.
+ *
+ * 	hreadsafe
+ *      The source is locked while it is copied.
+ *
+ * \param rhs
+ *      Provides the pattern to copy.
+ */
+
+void
+sequence::copy_for_save (const sequence & rhs)
+{
+    if (this != &rhs)
+    {
+        automutex rlocker(rhs.m_mutex);
+        automutex locker(m_mutex);
+        m_events                    = rhs.m_events;
+        m_triggers.m_triggers       = rhs.m_triggers.m_triggers;
+        m_triggers.m_ppqn           = rhs.m_triggers.m_ppqn;
+        m_triggers.m_length         = rhs.m_triggers.m_length;
+        m_seq_number                = rhs.m_seq_number;
+        m_name                      = rhs.m_name;
+        m_ppqn                      = rhs.m_ppqn;
+        m_length                    = rhs.m_length;
+        m_channel_match             = rhs.m_channel_match;
+        m_midi_channel              = rhs.m_midi_channel;
+        m_free_channel              = rhs.m_free_channel;
+        m_nominal_bus               = rhs.m_nominal_bus;
+        m_nominal_in_bus            = rhs.m_nominal_in_bus;
+        m_transposable              = rhs.m_transposable;
+        m_loop_count_max            = rhs.m_loop_count_max;
+        m_seq_color                 = rhs.m_seq_color;
+        m_seq_edit_mode             = rhs.m_seq_edit_mode;
+        m_time_beats_per_measure    = rhs.m_time_beats_per_measure;
+        m_time_beat_width           = rhs.m_time_beat_width;
+        m_clocks_per_metronome      = rhs.m_clocks_per_metronome;
+        m_32nds_per_quarter         = rhs.m_32nds_per_quarter;
+        m_us_per_quarter_note       = rhs.m_us_per_quarter_note;
+        m_musical_key               = rhs.m_musical_key;
+        m_musical_scale             = rhs.m_musical_scale;
+        m_background_sequence       = rhs.m_background_sequence;
+        m_cc_reducer.configure
+        (
+            rhs.m_cc_reducer.get_method(), rhs.m_cc_reducer.value(),
+            rhs.m_cc_reducer.pulses(), int(m_ppqn)
+        );
+    }
+}
+
 /*
  *  These two functions are an attempt to remove a seqfault that can occur
  *  in qseqdata, qseqroll, qloopbutton, etc. when processing multiple
@@ -462,7 +535,7 @@ sequence::background_sequence (int bs, bool user_change)
         result = bs != m_background_sequence;
         if (result)
         {
-            m_background_sequence = short(bs);
+            m_background_sequence = bs;
             if (user_change)
                 modify();
         }
@@ -523,6 +596,60 @@ sequence::loop_count_max (int m, bool user_change)
     return result;
 }
 
+/**
+ *  Sets the reduction of recorded controller data for this pattern.  See
+ *  the ccreducer module.
+ *
+ * \param m
+ *      The method:  none, delta, or curve.
+ *
+ * \param value
+ *      The value threshold (delta) or tolerance (curve), in 7-bit units.
+ *
+ * \param pulses
+ *      The smallest (delta) or largest (curve) distance between the events
+ *      kept, or 0.
+ *
+ * \param user_change
+ *      If true, the pattern (and the MIDI file) is marked as modified.
+ *
+ * \return
+ *      Returns true if a setting changed.
+ */
+
+bool
+sequence::cc_reduction
+(
+    ccreducer::method m, int value, midipulse pulses, bool user_change
+)
+{
+    automutex locker(m_mutex);
+    bool result =
+        m != m_cc_reducer.get_method() || value != m_cc_reducer.value() ||
+        pulses != m_cc_reducer.pulses();
+
+    if (result)
+    {
+        add_reduced_events(m_cc_reducer.flush());   /* keep the held events */
+        m_cc_reducer.configure(m, value, pulses, int(m_ppqn));
+        if (user_change)
+            modify();
+    }
+    return result;
+}
+
+/**
+ *  Adds the events released by the controller reduction.  The caller
+ *  locks the mutex.
+ */
+
+void
+sequence::add_reduced_events (const std::vector<event> & evs)
+{
+    for (const auto & e : evs)
+        (void) add_event(e);                        /* locks and sorts      */
+}
+
 /**
  *  If empty, sets the color to classic Sequencer64 yellow.  Called by
  *  performer when installing a sequence.
@@ -707,6 +834,48 @@ sequence::analyze_time_signatures ()
             t.sig_measures = measures();
             t.sig_end_tick = get_length();
         }
+
+        const timesig & t0 = m_time_signatures[0];
+        m_meter_map.reset(get_ppqn(), t0.sig_beats_per_bar, t0.sig_beat_width);
+        for (size_t i = 1; i < sz; ++i)
+        {
+            const timesig & t = m_time_signatures[i];
+            (void) m_meter_map.add
+            (
+                t.sig_start_tick, t.sig_beats_per_bar, t.sig_beat_width
+            );
+        }
+    }
+    return result;
+}
+
+/**
+ *  Adds the time-signature events of this pattern to a meter map.  Used by
+ *  the performer to build the song's meter map from the first pattern that
+ *  has any time-signatures.
+ *
+ * \param [out] mm
+ *      The meter map to which the time-signatures are added.  The caller
+ *      resets it first.
+ *
+ * \return
+ *      Returns true if a time-signature event was found.
+ */
+
+bool
+sequence::fill_meter_map (metermap & mm) const
+{
+    automutex locker(m_mutex);
+    bool result = false;
+    for (auto cev = m_events.cbegin(); cev != m_events.cend(); ++cev)
+    {
+        if (cev->is_time_signature() && cev->sysex_size() >= 2)
+        {
+            int beats = int(cev->get_sysex(0));
+            int width = beat_power_of_2(int(cev->get_sysex(1)));
+            if (mm.add(cev->timestamp(), beats, width))
+                result = true;
+        }
     }
     return result;
 }
@@ -748,7 +917,7 @@ sequence::get_time_signature (size_t index) const
 
 /**
  *  Do we want to call analyze_time_signatures() here? Probably better to
- *  let the caller do it.
+ *  let the caller do it.  The meter map makes this a binary search.
  *
  * \param p
  *      Provides the current time in ticks (pulses).
@@ -771,29 +940,17 @@ sequence::current_time_signature
     midipulse p, int & beats, int & beatwidth
 ) const
 {
-    bool result = false;
-    int count = time_signature_count();
-    if (count > 0)
+    bool result = true;
+    if (time_signature_count() > 0)
     {
-        for (int i = 1; i < count; ++i)
-        {
-            const timesig & current = get_time_signature(i);
-            midipulse p0 = current.sig_start_tick;
-            midipulse p1 = current.sig_end_tick;
-            if (p >= p0 && p < p1)
-            {
-                beats = current.sig_beats_per_bar;
-                beatwidth = current.sig_beat_width;
-                result = true;
-                break;
-            }
-        }
+        const metermap::meter & m = m_meter_map.at(p);
+        beats = m.beats_per_bar;
+        beatwidth = m.beat_width;
     }
     else
     {
         beats = get_beats_per_bar();
         beatwidth = get_beat_width();
-        result = true;
     }
     return result;
 }
@@ -807,57 +964,22 @@ sequence::current_time_signature
  *  This function is meant to be used in the time-lines of the pattern or song
  *  editors.
  *
- *  If the tick is past the start of the last time-signature (there is always
- *  one, the default time signature), then we get the duration since that start,
- *  convert it to a measure value, then add it to the firts measure of the last
- *  time-signature.
- *
- *  Note: for speed, we should use the old method, just incrementing the measure.
+ *  The meter map holds the starting bar of each time-signature, so this is
+ *  a binary search for the time-signature in force, plus a division. It is
+ *  called for every bar line drawn.
  *
  * \param p
  *      Provides the tick for which we want to get the measure it it in.
  *
  * \return
- *      Returns the rounded up integer version of the measure.
+ *      Returns the 1-based number of the measure.
  */
 
 int
 sequence::measure_number (midipulse p) const
 {
-    int result = 0;
-    int count = time_signature_count();
-    if (count > 0)
-    {
-        for (int i = 0; i < count; ++i)
-        {
-            const timesig & t = get_time_signature(i);
-            midipulse p0 = t.sig_start_tick;
-            if (p >= p0)
-            {
-                midipulse p1 = t.sig_end_tick;
-                midipulse duration = p - p0;
-                double mnew = t.sig_start_measure;
-                double m = pulses_to_measures
-                (
-                    duration, get_ppqn(),
-                    t.sig_beats_per_bar, t.sig_beat_width
-                );
-                result += int(mnew + m + 0.5);      /* round up for now */
-                if (p >= p1)
-                {
-                    /*
-                     * We're past the last time-signature event. See banner.
-                     */
-
-                    break;
-                }
-            }
-        }
-    }
-    else
-        result = measures();
-
-    return result;
+    return time_signature_count() > 0 ?
+        m_meter_map.bar_number(p) : measures() ;
 }
 
 /**
@@ -867,20 +989,8 @@ sequence::measure_number (midipulse p) const
  *
  *  -   We have a string such as "4:l:000".
  *      -   Fill a midi_measures structure from that string.
- *          -   Extract the 4 (measures).
- *          -   Extract the 1 (beat).
- *          -   Extract the ticks.
- *      -   Iterate the time-signatures to get to the one where
- *          measure >= t.sig_start_measure and if not at the end
- *          where measure < t+1.sig_start_measure.
- *          -   Set pulses = t.sig_start_tick.
- *          -   Get the measure size, 
- *          -   Get the percentage of the measure size:
- *              percent = beat/t.sig_beats_per_bar as doubles;
- *          -   pulsesbeat = percent * (t.sig_end_tick - t.sig_start_tick);
- *          -   pulses += pulsebeat
- *          -   pulses += ticks.
- *      -   If after the last time-signature change:
+ *      -   Look up the time-signature in force at that measure in the meter
+ *          map, and add the measures, beats, and ticks past its start.
  *
  *  After completion, a re-analysis will be required.
  */
@@ -889,37 +999,10 @@ midipulse
 sequence::time_signature_pulses (const std::string & s) const
 {
     midipulse result = 0;
-    midi_measures mm = string_to_measures(s);   /* measures, beats, ticks   */
-    int count = time_signature_count();
-    if (count > 0)
+    if (time_signature_count() > 0)
     {
-        double mtarget = double(mm.measures());
-        bool got_it = false;
-        for (int i = 0; i < count; ++i)
-        {
-            const timesig & t0 = get_time_signature(i);
-            double m0 = t0.sig_start_measure;
-            double m1;
-            if (i < (count - 1))
-            {
-                const timesig & t1 = get_time_signature(i + 1);
-                m1 = t1.sig_start_measure;
-                if (mtarget >= m0 && mtarget < m1)
-                    got_it = true;
-            }
-            else    /* target measure is after last time-signature change.  */
-                got_it = true;
-
-            if (got_it)
-            {
-                double mcount = double(mm.measures()) - m0; /* integral?    */
-                double tpb = double(t0.sig_ticks_per_beat);
-                double bpb = double(t0.sig_beats_per_bar);
-                midipulse added = midipulse(tpb * bpb * mcount);
-                result = t0.sig_start_tick + added + mm.divisions();
-                break;
-            }
-        }
+        midi_measures mm = string_to_measures(s);   /* measures, beats, ticks   */
+        result = m_meter_map.to_pulses(mm);
     }
     else
     {
@@ -996,8 +1079,9 @@ sequence::pop_undo ()
     if (! m_events_undo.empty())
     {
         m_events_redo.push(m_events);
-        m_events = m_events_undo.top();
+        m_events = m_events_undo.top();     /* keeps the old capacity       */
         m_events_undo.pop();
+        (void) m_events.compact();
         verify_and_link();
         unselect();
     }
@@ -1021,8 +1105,9 @@ sequence::pop_redo ()
     if (! m_events_redo.empty())                // move to triggers module?
     {
         m_events_undo.push(m_events);
-        m_events = m_events_redo.top();
+        m_events = m_events_redo.top();     /* keeps the old capacity       */
         m_events_redo.pop();
+        (void) m_events.compact();
         verify_and_link();
         unselect();
     }
@@ -1371,7 +1456,10 @@ sequence::sequence_playing_toggle ()
 bool
 sequence::toggle_playing ()
 {
-    return toggle_playing(perf()->get_tick(), perf()->resume_note_ons());
+    return toggle_playing
+    (
+        perf()->get_tick(), perf()->resume_note_ons(), perf()->resume_controls()
+    );
 }
 
 /**
@@ -1386,14 +1474,29 @@ sequence::toggle_playing ()
  * \param resumenoteons
  *      A song-recording option.  (This option, "note-resume", is stored in
  *      the "usr" file.
+ *
+ * \param resumecontrols
+ *      The "control-resume" option, which resends the chased controller
+ *      state.  It works with or without "note-resume".
+ *
+ *  The chased events are flushed here, since a toggle usually comes from
+ *  the GUI or a MIDI control, and put_event_on_bus() leaves the flush to
+ *  the output cycle.
  */
 
 bool
-sequence::toggle_playing (midipulse tick, bool resumenoteons)
+sequence::toggle_playing
+(
+    midipulse tick, bool resumenoteons, bool resumecontrols
+)
 {
     set_armed(! armed());
-    if (armed() && resumenoteons)
-        resume_note_ons(tick);
+    if (armed() && (resumenoteons || resumecontrols))
+    {
+        chase(tick, resumenoteons, resumecontrols);
+        if (not_nullptr(master_bus()))
+            master_bus()->flush();
+    }
 
     off_from_snap(false);
     return armed();
@@ -1600,27 +1703,31 @@ sequence::play
             midipulse stamp = ts + offset_base;
             if (stamp >= start_tick_offset && stamp <= end_tick_offset)
             {
+                midipulse pulse = stamp - offset;   /* absolute, for render */
                 if (transpose != 0 && er.is_note()) /* includes Aftertouch  */
                 {
                     event trans_event = er;         /* assign ALL members   */
                     trans_event.transpose_note(transpose);
-                    put_event_on_bus(trans_event);
+                    put_event_on_bus(trans_event, pulse);
                 }
                 else
                 {
                     if (er.is_tempo())
                     {
-                        perf()->set_beats_per_minute(er.tempo());
+                        if (not_nullptr(m_render))  /* see playpool module  */
+                            render_event(er, pulse, 0);
+                        else
+                            perf()->set_beats_per_minute(er.tempo());
                     }
                     else
                     {
                         if (er.is_ex_data())
                         {
                             if (er.is_sysex())          /* EXPERIMENTAL     */
-                                put_event_on_bus(er);   /* ca 2024-05-22    */
+                                put_event_on_bus(er, pulse);
                         }
                         else
-                            put_event_on_bus(er);   /* frame still going    */
+                            put_event_on_bus(er, pulse);    /* frame going  */
                     }
                 }
             }
@@ -1751,6 +1858,7 @@ sequence::verify_and_link (bool wrap)
 {
     automutex locker(m_mutex);
     m_events.verify_and_link(get_length(), wrap);
+    m_chase_index.invalidate();
 }
 
 /**
@@ -1881,7 +1989,61 @@ sequence::remove_all ()
     int count = m_events.count();
     m_events.clear();
     if (count > 0)
+    {
+        (void) m_events.compact();      /* frees a big pattern's memory     */
         modify();                       /* issue #90 */
+    }
+}
+
+/**
+ *  Estimates the heap memory used by this pattern.  The undo-hold list is
+ *  counted with the undo lists.
+ *
+ * \threadsafe
+ */
+
+sequence::memory
+sequence::memory_use () const
+{
+    automutex locker(m_mutex);
+    memory result;
+    result.events = m_events.memory_events();
+    result.sysex = m_events.memory_sysex();
+    result.undo = m_events_undo_hold.memory_events() +
+        m_events_undo_hold.memory_sysex();
+
+    for (const auto & el : m_events_undo.items())
+        result.undo += el.memory_events() + el.memory_sysex();
+
+    for (const auto & el : m_events_redo.items())
+        result.undo += el.memory_events() + el.memory_sysex();
+
+    result.triggers = m_triggers.memory_size();
+    return result;
+}
+
+/**
+ *  Releases unused memory in the events and triggers.  Called after bulk
+ *  deletes (unforced) and before saving (forced).  The content of the
+ *  pattern does not change, so it is not marked as modified.
+ *
+ * \threadsafe
+ *
+ * \param force
+ *      If true, compact even if little would be released.  See
+ *      eventlist::compact().
+ */
+
+void
+sequence::compact (bool force)
+{
+    automutex locker(m_mutex);
+    if (m_events.compact(force))
+        m_chase_index.invalidate();
+
+    (void) m_events_undo_hold.compact(force);
+    if (force)
+        m_triggers.compact();
 }
 
 /**
@@ -1907,8 +2069,10 @@ sequence::remove_marked ()
 
     bool result = m_events.remove_marked();
     if (result)
+    {
+        (void) m_events.compact();
         modify();
-
+    }
     return result;
 }
 
@@ -1945,8 +2109,10 @@ sequence::remove_selected ()
 
     bool result = m_events.remove_selected();
     if (result)
+    {
+        (void) m_events.compact();
         modify();
-
+    }
     return result;
 }
 
@@ -3913,6 +4079,9 @@ sequence::add_event (const event & er)
  *  channel parameter, if the event has a channel.  This reveals that in
  *  midifile and wrkfile, we update the channel setting too many times.
  *
+ *  SysEx and Meta payloads are shared with identical ones already loaded,
+ *  so that a dump repeated in many patterns is stored only once.
+ *
  * \param er
  *      Provide a reference to the event to be added; the event is copied into
  *      the events container.
@@ -3925,9 +4094,22 @@ bool
 sequence::append_event (const event & er)
 {
     automutex locker(m_mutex);
+    if (er.is_ex_data())
+    {
+        event e(er);                    /* cheap, the payload is shared     */
+        e.share_sysex();                /* dedupe repeated SysEx/Meta data  */
+        return m_events.append(e);
+    }
     return m_events.append(er);     /* does *not* sort, too time-consuming  */
 }
 
+void
+sequence::reserve_events (int count)
+{
+    automutex locker(m_mutex);
+    m_events.reserve(count);
+}
+
 void
 sequence::sort_events ()
 {
@@ -4135,6 +4317,7 @@ sequence::stream_event (event & ev)
             if (overwriting())
             {
                 loop_reset(false);
+                m_cc_reducer.reset();               /* drop the held events */
                 remove_all();                       /* vs m_events.clear()  */
                 set_dirty();
             }
@@ -4187,7 +4370,10 @@ sequence::stream_event (event & ev)
                     if (notemapping())
                         perf()->repitch(ev);
                 }
-                add_event(ev);                          /* locks and sorts  */
+                if (m_cc_reducer.active() && ccreducer::reducible(ev))
+                    add_reduced_events(m_cc_reducer.process(ev));
+                else
+                    add_event(ev);                      /* locks and sorts  */
             }
             else
             {
@@ -4256,10 +4442,10 @@ sequence::stream_event (event & ev)
                 }
             }
         }
-        if (m_thru)
-            put_event_on_bus(ev);
-
         /*
+         * MIDI Thru is now done by performer::poll_cycle() before this
+         * function is called.  See the thruroutes module.
+         *
          * We don't need to link note events until a note-off comes in.
          */
 
@@ -4278,6 +4464,9 @@ sequence::stream_event (event & ev)
  *  false in is_dirty_main(); m_dirty_perf is set to false in
  *  is_dirty_perf().
  *
+ *  Since these flags are raised by mutes, queuing, and edits, this is also
+ *  where the performer is told that events rendered ahead may be stale.
+ *
  * \threadunsafe
  */
 
@@ -4285,11 +4474,14 @@ void
 sequence::set_dirty_mp ()
 {
     m_dirty_names = m_dirty_main = m_dirty_perf = true;
+    if (not_nullptr(perf()))
+        perf()->invalidate_ahead();             /* see renderahead module   */
 }
 
 /**
  *  Call set_dirty_mp() and then sets the dirty flag for editing. Note that it
- *  does not call performer::modify().
+ *  does not call performer::modify().  Since the events may have changed,
+ *  the chase index is marked for rebuilding.
  */
 
 void
@@ -4297,6 +4489,7 @@ sequence::set_dirty ()
 {
     set_dirty_mp();
     m_dirty_edit = true;
+    m_chase_index.invalidate();
 }
 
 /**
@@ -4686,17 +4879,28 @@ sequence::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
 }
 
 /**
- *  This grows a trigger continuously.
+ *  This grows a trigger continuously, during song recording.  The trigger
+ *  is extended in place (see triggers::grow_recording()), and the pattern
+ *  is marked only if the trigger actually changed.
+ *
+ * \return
+ *      Returns true if the trigger changed, so that the caller can notify.
  */
 
 bool
 sequence::grow_trigger (midipulse tickfrom, midipulse tickto)
 {
     automutex locker(m_mutex);
-    m_triggers.grow_trigger(tickfrom, tickto, c_song_record_incr);
-    modify(false);                      /* issue #90 flag change w/o notify */
-    set_dirty_mp();                     /* force redraw                     */
-    return true;
+    bool result = m_triggers.grow_recording
+    (
+        tickfrom, tickto, c_song_record_incr
+    );
+    if (result)
+    {
+        modify(false);                  /* issue #90 flag change w/o notify */
+        set_dirty_mp();                 /* force redraw                     */
+    }
+    return result;
 }
 
 const trigger &
@@ -5146,7 +5350,11 @@ sequence::stop (bool songmode)
     off_playing_notes();
     zero_markers();                         /* sets the "last-tick" value   */
     if (recording())                        /* ca 2023-04-25                */
+    {
+        automutex locker(m_mutex);
+        add_reduced_events(m_cc_reducer.flush());
         verify_and_link();
+    }
 
     set_armed(songmode ? false : state);
 }
@@ -5716,6 +5924,7 @@ sequence::set_midi_bus (bussbyte nominalbus, bool user_change)
             if (user_change)
                 modify();                       /* no easy way to undo this */
 
+            perf()->thru_changed();
             notify_change(user_change);         /* better than set_dirty()  */
             set_dirty();                        /* for display updating     */
         }
@@ -5749,6 +5958,7 @@ sequence::set_midi_in_bus (bussbyte nominalbus, bool user_change)
             if (user_change)
                 modify();                       /* no easy way to undo this     */
 
+            perf()->thru_changed();
             notify_change(user_change);         /* more reliable than set dirty */
             set_dirty();                        /* this is for display updating */
         }
@@ -6115,8 +6325,12 @@ sequence::set_recording (toggler flag)
                 channel_match(true);
         }
         else
+        {
             m_alter_recording = alteration::none;
+            add_reduced_events(m_cc_reducer.flush());
+        }
 
+        perf()->thru_changed();
         set_dirty();
         notify_trigger();
     }
@@ -6159,6 +6373,7 @@ sequence::set_recording (alteration q, toggler flag)
          *      result = set_recording(toggler::off);
          */
 
+        perf()->thru_changed();                 /* note-mapping is off      */
         set_dirty();
         notify_trigger();
     }
@@ -6229,7 +6444,11 @@ sequence::set_thru (bool thruon, bool toggle)
             result = master_bus()->set_sequence_input(thruon, this);
 
         if (result)
+        {
             m_thru = thruon;
+            if (not_nullptr(perf()))
+                perf()->thru_changed();
+        }
     }
     return result;
 }
@@ -6355,6 +6574,9 @@ sequence::set_midi_channel (midibyte ch, bool user_change)
         off_playing_notes();
         m_free_channel = is_null_channel(ch);
         m_midi_channel = ch;                /* if (! m_free_channel)        */
+        if (not_nullptr(perf()))
+            perf()->thru_changed();
+
         if (user_change)
             modify();                       /* no easy way to undo this     */
 
@@ -6444,6 +6666,33 @@ sequence::to_string () const
 
 void
 sequence::put_event_on_bus (const event & ev)
+{
+    put_event_on_bus(ev, m_last_tick);
+}
+
+/**
+ *  The working version of put_event_on_bus().  If the sequence is being
+ *  played by a playpool worker, the event is rendered into the worker's
+ *  buffer instead of being sent.
+ *
+ *  The event is played, not flushed; the caller (e.g. performer::play())
+ *  flushes the master buss once per output cycle, so that the busses that
+ *  batch their output (PortMidi) can write the whole cycle at once.  A
+ *  caller outside of the output cycle must flush the buss itself; see
+ *  toggle_playing() and performer::chase_sequences().  The
+ *  time-stamp of the event sent is its own pulse, not the current pulse,
+ *  so that those busses can space the events of a cycle properly.
+ *
+ * \param ev
+ *      The event to put on the buss.
+ *
+ * \param stamp
+ *      The absolute time-stamp of the event (the pulse at which it plays,
+ *      not the offset stamp used in sequence::play()).
+ */
+
+void
+sequence::put_event_on_bus (const event & ev, midipulse stamp)
 {
     midibyte note = ev.get_note();
     bool skip = false;
@@ -6461,11 +6710,40 @@ sequence::put_event_on_bus (const event & ev)
     if (! skip)
     {
         event evout;
-        evout.prep_for_send(perf()->get_tick(), ev);      /* issue #100   */
-        master_bus()->play_and_flush(m_true_bus, &evout, midi_channel(ev));
+        evout.prep_for_send(stamp, ev);                 /* issue #100       */
+        if (not_nullptr(m_render))
+            render_event(evout, stamp, midi_channel(ev));
+        else
+            master_bus()->play(m_true_bus, &evout, midi_channel(ev));
     }
 }
 
+/**
+ *  Appends an event to the playpool buffer set by render_to().
+ *
+ * \param ev
+ *      The event, already prepared for sending.
+ *
+ * \param stamp
+ *      The absolute time-stamp used for ordering the merge.
+ *
+ * \param channel
+ *      The output channel.
+ */
+
+void
+sequence::render_event (const event & ev, midipulse stamp, midibyte channel)
+{
+    renderitem ri;
+    ri.stamp = stamp;
+    ri.seqno = seq_number();
+    ri.order = m_render_order++;
+    ri.bus = m_true_bus;
+    ri.channel = channel;
+    ri.ev = ev;
+    m_render->push_back(ri);
+}
+
 /**
  *  Sends a note-off event for all active notes.  This function does not
  *  bother checking if m_master_bus is a null pointer.
@@ -6484,11 +6762,15 @@ sequence::off_playing_notes ()
         while (m_playing_notes[x] > 0)
         {
             e.set_data(x);
-            master_bus()->play(m_true_bus, &e, channel);
+            if (not_nullptr(m_render))
+                render_event(e, m_last_tick, channel);
+            else
+                master_bus()->play(m_true_bus, &e, channel);
+
             --m_playing_notes[x];
         }
     }
-    if (not_nullptr(master_bus()))
+    if (is_nullptr(m_render) && not_nullptr(master_bus()))
         master_bus()->flush();
 }
 
@@ -6888,10 +7170,14 @@ sequence::copy_events (const eventlist & newevents)
  *
  * \param p
  *      A pointer to the parent, assigned only if not already assigned.
+ *
+ * \param presorted
+ *      If true, the events were restored already sorted and linked (see
+ *      songsnapshot), and the sort and verify_and_link() are skipped.
  */
 
 void
-sequence::set_parent (performer * p)
+sequence::set_parent (performer * p, bool presorted)
 {
     if (not_nullptr(p))
     {
@@ -6908,8 +7194,15 @@ sequence::set_parent (performer * p)
         bussbyte buss_override = usr().midi_buss_override();
         m_parent = p;                           /* perf() is the accessor   */
         set_master_midi_bus(p->master_bus());
-        sort_events();                      /* sort the events now          */
-        set_length();                       /* final verify_and_link()      */
+        if (presorted)
+        {
+            set_length(0, true, false);     /* events are already linked    */
+        }
+        else
+        {
+            sort_events();                  /* sort the events now          */
+            set_length();                   /* final verify_and_link()      */
+        }
         empty_coloring();                   /* yellow color if no events    */
         if (get_length() < barlength)       /* pad sequence to a measure    */
             set_length(barlength, false);
@@ -6938,7 +7231,8 @@ sequence::set_parent (performer * p)
  *      If true, we are in Song mode.  Otherwise, Live mode.
  *
  * \param resumenoteons
- *      Indicates if we are to resume Note Ons.  Used by performer::play().
+ *      Indicates if we are to resume Note Ons or controller state (see
+ *      performer::chasing()).  Used by performer::play().
  */
 
 void
@@ -6947,7 +7241,11 @@ sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
     if (check_queued_tick(tick))
     {
         play(get_queued_tick() - 1, playbackmode, resumenoteons);
-        (void) toggle_playing(tick, resumenoteons);
+        (void) toggle_playing
+        (
+            tick, resumenoteons && perf()->resume_note_ons(),
+            resumenoteons && perf()->resume_controls()
+        );
         if (! perf()->is_solo())
         {
             automation::action a = automation::action::off;
@@ -6958,7 +7256,11 @@ sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
     if (check_one_shot_tick(tick))
     {
         play(one_shot_tick() - 1, playbackmode, resumenoteons);
-        (void) toggle_playing(tick, resumenoteons);
+        (void) toggle_playing
+        (
+            tick, resumenoteons && perf()->resume_note_ons(),
+            resumenoteons && perf()->resume_controls()
+        );
         (void) toggle_queued(); /* queue it to mute it again after one play */
         (void) perf()->set_ctrl_status
         (
@@ -7068,6 +7370,11 @@ sequence::song_recording_start (midipulse tick, bool snap)
  *  However, for issue #44, we'd like to have the trigger stop at the snap
  *  point for the actual tick at which muting turns on.
  *
+ *  The trigger grown in place during recording is merged here, once, with
+ *  the full trigger-add logic.  See triggers::finish_recording().  The
+ *  pattern is marked, and the listeners notified, only if that changed the
+ *  trigger.
+ *
  *  In Kepler34, these were the grow_trigger() call parameters:
  *
  *      -   Song-recording start tick.
@@ -7088,12 +7395,23 @@ sequence::song_recording_start (midipulse tick, bool snap)
 void
 sequence::song_recording_stop (midipulse tick)
 {
-    (void) perf()->calculate_snap(tick);      /* issue #44 redux  */
-    grow_trigger(song_record_tick(), tick, 1);
-    if (song_recording_snap())
-        off_from_snap(true);
+    bool changed;
+    {
+        automutex locker(m_mutex);
+        (void) perf()->calculate_snap(tick);  /* issue #44 redux  */
+        changed = m_triggers.finish_recording(song_record_tick(), tick, 1);
+        if (changed)
+        {
+            modify(false);              /* issue #90 flag change w/o notify */
+            set_dirty_mp();             /* force redraw                     */
+        }
+        if (song_recording_snap())
+            off_from_snap(true);
 
-    m_song_playback_block = m_song_recording = false;
+        m_song_playback_block = m_song_recording = false;
+    }
+    if (changed)
+        notify_trigger();               /* outside of the pattern lock      */
 }
 
 /**
@@ -7143,6 +7461,13 @@ sequence::song_recording_stop (midipulse tick)
  *  One question is where is best to do the locking of put_event_on_bus().  In
  *  retrospect, probably better to do it just once, instead of for each event.
  *
+ *  The linear scan of all events has been replaced by a lookup in the chase
+ *  index (see chaseindex.hpp), which is rebuilt here if the events have
+ *  changed since the last chase.  If the "control-resume" option is on, the
+ *  latest controller, program, pressure, and pitch-bend values are sent
+ *  first, so that the resumed notes sound with the proper patch and
+ *  expression.
+ *
  * \param tick
  *      The current tick-time, in MIDI pulses.
  */
@@ -7150,20 +7475,43 @@ sequence::song_recording_stop (midipulse tick)
 void
 sequence::resume_note_ons (midipulse tick)
 {
-    automutex locker(m_mutex);                          /* better here?     */
-    if (get_length() > 0)
+    chase(tick, perf()->resume_note_ons(), perf()->resume_controls());
+}
+
+/**
+ *  Sends the state of the pattern at the given position:  the latest
+ *  controller, program, pressure, and pitch-bend values (if requested), then
+ *  the Note Ons that would be sounding.  Used by resume_note_ons() and by
+ *  performer::chase_sequences() after a reposition.
+ *
+ * \param tick
+ *      The current tick-time, in MIDI pulses.
+ *
+ * \param notes
+ *      If true, resume the sounding notes.
+ *
+ * \param controls
+ *      If true, send the chased controller state.
+ */
+
+void
+sequence::chase (midipulse tick, bool notes, bool controls)
+{
+    automutex locker(m_mutex);
+    if (get_length() > 0 && (notes || controls))
     {
-        for (auto & ei : m_events)
-        {
-            if (ei.is_note_on_linked())                 /* note on linked   */
-            {
-                midipulse on = ei.timestamp();          /* see banner notes */
-                midipulse off = ei.link()->timestamp();
-                midipulse rem = tick % get_length();
-                if (on < rem && (off > rem || on > off))
-                    put_event_on_bus(ei);
-            }
-        }
+        if (! m_chase_index.valid() || m_chase_index.length() != get_length())
+            m_chase_index.build(m_events.events(), get_length());
+
+        event::buffer chased;
+        if (controls)
+            (void) m_chase_index.chase_states(tick, chased);
+
+        if (notes)
+            (void) m_chase_index.chase_notes(tick, chased);
+
+        for (auto & ev : chased)
+            put_event_on_bus(ev);
     }
 }
 
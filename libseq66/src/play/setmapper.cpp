@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-02-12
- * \updates       2023-11-14
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Implements three classes:  seq, screenset, and setmapper, which replace a
@@ -93,7 +93,8 @@ namespace seq66
  *  After creation, screenset 0 is created and set as the play-screen.
  *
  * \param mgs
- *      Provides the existing mutegroup to be managed.
+ *      Provides the pointer to the existing mutegroup to be managed.  It is
+ *      held by reference, so that a replacement is seen here.
  *
  * \param sets
  *      Provides the maximum number of sets to be supported and managed.
@@ -110,7 +111,7 @@ namespace seq66
 setmapper::setmapper
 (
     setmaster & mc,
-    mutegroups & mgs,
+    std::shared_ptr<mutegroups> & mgs,
     int rows,
     int columns
 ) :
@@ -118,10 +119,7 @@ setmapper::setmapper
     m_set_size              (rows * columns),
     m_set_master            (mc),                   /* master() accessor    */
     m_sequence_count        (0),
-    m_sequence_max
-    (
-        m_set_size * seq::limit() / m_set_size
-    ),
+    m_sequence_max          (seq::maximum()),
     m_sequence_high         (seq::unassigned()),
     m_edit_sequence         (seq::unassigned()),
     m_set_clipboard         (seq::unassigned(), rows, columns),
@@ -182,7 +180,7 @@ bool
 setmapper::add_to_play_set (playset & p, sequence * s)
 {
     seq::number seqno = s->seq_number();
-    screenset & sset = screen(seqno);                   /* tricky !!!   */
+    screenset & sset = screen(seqno);
     bool result = sset.usable();
     if (result)
         result = sset.add_to_play_set(p, seqno);
@@ -212,7 +210,7 @@ bool
 setmapper::copy_screenset (screenset::number srcset, screenset::number destset)
 {
     const screenset & src = master().screen(srcset);
-    screenset & dest = master().screen(destset);
+    screenset & dest = master().make_screen(destset);
     bool result = src.usable() && dest.usable();
     if (result)
     {
@@ -248,7 +246,7 @@ setmapper::paste_screenset (screenset::number destset)
     bool result = src.usable();
     if (result)
     {
-        screenset & dest = master().screen(destset);
+        screenset & dest = master().make_screen(destset);
         result = dest.copy_patterns(src);
         if (result)
             recount_sequences();
@@ -289,11 +287,24 @@ setmapper::screen (seq::number seqno) const
 
 /**
  *  Look up the screen to be used, given the sequence number.  If the screen
- *  doesn't exist, and is a legal screenset number, then create it.
+ *  doesn't exist, the dummy (unusable) screenset is returned.  Lookups never
+ *  create a screenset; only adding a sequence (or naming, copying, or
+ *  selecting a set) does that.  See make_screen().
  */
 
 screenset &
 setmapper::screen (seq::number seqno)
+{
+    return master().screen(seq_set(seqno));
+}
+
+/**
+ *  Look up the screen to be used, given the sequence number.  If the screen
+ *  doesn't exist, and is a legal screenset number, then create it.
+ */
+
+screenset &
+setmapper::make_screen (seq::number seqno)
 {
     screenset::number setno = seq_set(seqno);
     screenset & desired_screen = master().screen(setno);
@@ -303,7 +314,7 @@ setmapper::screen (seq::number seqno)
     }
     else if (master().is_screenset_valid(setno))
     {
-        if (seqno < seq::limit())
+        if (seqno < m_sequence_max)
         {
             auto newset = add_set(setno);
             return newset->second;
@@ -345,7 +356,7 @@ setmapper::add_sequence (sequence * s, seq::number & seqno)
     bool result = false;
     if (not_nullptr(s))
     {
-        screenset & sset = screen(seqno);                   /* tricky !!!   */
+        screenset & sset = make_screen(seqno);              /* tricky !!!   */
         while (! result)
         {
             result = sset.usable();
@@ -355,8 +366,8 @@ setmapper::add_sequence (sequence * s, seq::number & seqno)
             if (! result)
             {
                 ++seqno;
-                if (seqno == m_sequence_max)
-                    break;
+                if (seqno >= m_sequence_max || (seqno % m_set_size) == 0)
+                    break;                          /* left the set; full   */
             }
         }
         if (result)
@@ -878,11 +889,11 @@ setmapper::copy_triggers
  *  a segfault... bad set?
  *
  * \param setno
- *      Provides the desired set number.  This ranges from 0 to 2047, though
- *      generally the number of sets is 32 or lower.  There is a screenset
- *      #2048 that always exists in order to provide an inactive/dummy
- *      screenset.  We decided to go by the setmaster's limit rather than
- *      screenset::limit() [2048].
+ *      Provides the desired set number.  This ranges from 0 to
+ *      screenset_max() - 1, though generally the number of sets is 32 or
+ *      lower.  There is a screenset #32768, screenset::limit(), that always
+ *      exists in order to provide an inactive/dummy screenset.  We decided
+ *      to go by the setmaster's limit rather than screenset::limit().
  *
  * \return
  *      Returns true if the play-screen was able to be set.
@@ -1254,7 +1265,7 @@ bool
 setmapper::clear_mutes ()
 {
     bool result = false;
-    if (m_mute_groups.clear())
+    if (mutes().clear())
         result = true;
 
     return result;
@@ -1274,10 +1285,22 @@ setmapper::name (screenset::number setno) const
     return result;
 }
 
+/**
+ *  Sets the name of a screenset.  A set that does not exist yet is created
+ *  only if the name is not empty and is not the default set name, so that
+ *  reading the set names from a file does not create unused sets.
+ */
+
 bool
 setmapper::name (screenset::number setno, const std::string & nm)
 {
     bool result = sets().find(setno) != sets().end();
+    if (! result && master().is_screenset_valid(setno))
+    {
+        result = ! nm.empty() && nm != dummy_screenset().name();
+        if (result)
+            result = add_set(setno) != sets().end();
+    }
     if (result)
     {
         auto & s = sets().at(setno);
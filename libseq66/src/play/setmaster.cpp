@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-08-10
- * \updates       2023-11-13
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Implements setmaster.  The difference between the setmaster and setmapper
@@ -52,7 +52,10 @@ namespace seq66
  *  provides access to the container of sets and to the currently-selected set,
  *  called the "play-screen".
  *
- *  After creation, screenset 0 is created and set as the play-screen.
+ *  After creation, screenset 0 is created and set as the play-screen.  The
+ *  other sets are created only when they are first used (see
+ *  make_screen()), so that the storage and the set loops are proportional
+ *  to the sets in use, not to the maximum number of sets.
  */
 
 setmaster::setmaster (int setrows, int setcolumns) :
@@ -61,7 +64,7 @@ setmaster::setmaster (int setrows, int setcolumns) :
     m_rows                  (c_rows),                   /* constant         */
     m_columns               (c_columns),                /* constant         */
     m_swap_coordinates      (usr().swap_coordinates()),
-    m_set_count             (m_rows * m_columns),
+    m_set_count             (seq::maximum() / (setrows * setcolumns)),
     m_highest_set           (-1),
     m_container             ()                          /* #, screenset map */
 {
@@ -71,24 +74,19 @@ setmaster::setmaster (int setrows, int setcolumns) :
 
 /**
  *  Resets back to the constructor set.  This means we have one set, the empty
- *  play-screen, plus a "dummy" set.
+ *  play-screen, plus a "dummy" set.  Other sets are created on demand.
  */
 
 bool
 setmaster::reset ()
 {
-    bool result = false;
     clear();
-    for (int i = 0; i < Size(); ++i)
-    {
-        auto setp = add_set(screenset::number(i));
-        result = setp != m_container.end();
-        if (! result)
-            break;
-    }
+
+    auto setp = add_set(screenset::number(0));
+    bool result = setp != m_container.end();
     if (result)
     {
-        auto setp = add_set(screenset::limit());    /* create the dummy set */
+        setp = add_set(screenset::limit());         /* create the dummy set */
         result = setp != m_container.end();
     }
     return result;
@@ -129,7 +127,7 @@ setmaster::reset ()
  *
  * \return
  *      Returns the calculated set number, which will range from 0 to
- *      (m_rows * m_columns) - 1 = m_set_count.  If out of range,
+ *      (m_rows * m_columns) - 1 = Size() - 1.  If out of range,
  *      set 0 is returned.
  */
 
@@ -262,6 +260,24 @@ setmaster::screen (screenset::number setno) const
     return sp != m_container.end() ? sp->second : dummy_screenset();
 }
 
+/**
+ *  Returns a reference to a screen, creating it if it does not exist yet and
+ *  the set number is valid.  Otherwise, a reference to the unusable dummy is
+ *  returned.
+ */
+
+screenset &
+setmaster::make_screen (screenset::number setno)
+{
+    auto sp = m_container.find(setno);
+    if (sp != m_container.end())
+        return sp->second;
+    else if (is_screenset_valid(setno))
+        return add_set(setno)->second;
+    else
+        return dummy_screenset();
+}
+
 int
 setmaster::screenset_active_count () const
 {
@@ -434,8 +450,8 @@ setmaster::swap_sets (screenset::number set0, screenset::number set1)
 bool
 setmaster::swap_sets (screenset::number set0, screenset::number set1)
 {
-    screenset & copy0 = screen(set0);
-    screenset & copy1 = screen(set1);
+    screenset & copy0 = make_screen(set0);
+    screenset & copy1 = make_screen(set1);
     bool result = copy0.usable() && copy1.usable();
     if (result)
     {
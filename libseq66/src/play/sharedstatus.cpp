@@ -0,0 +1,279 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sharedstatus.cpp
+ *
+ *  This module defines the shared-memory status surface.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of sharedstatus.hpp for the reader's protocol.
+ */
+
+#include <cstring>                      /* std::memset()                    */
+#include <new>                          /* placement new                    */
+
+#include "os/timing.hpp"                /* seq66::microtime()               */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sharedstatus.hpp"        /* seq66::sharedstatus              */
+#include "util/basic_macros.hpp"        /* seq66::infoprintf(), etc.        */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <fcntl.h>                      /* O_CREAT, O_RDWR                  */
+#include <sys/mman.h>                   /* shm_open(), mmap()               */
+#include <unistd.h>                     /* ftruncate(), getpid()            */
+#endif
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The shortest time between two updates, in microseconds.  Readers that
+ *  poll faster see the same data.
+ */
+
+static const long c_status_period_us = 20000;
+
+sharedstatus::sharedstatus () :
+    m_name              (),
+    m_fd                (-1),
+    m_surface           (nullptr),
+    m_write_mutex       (),
+    m_last_update_us    (0),
+    m_underrun_count    (0),
+    m_last_underrun_us  (0),
+    m_lit_slots         ()
+{
+    m_lit_slots.reserve(size_t(c_status_slots));
+}
+
+sharedstatus::~sharedstatus ()
+{
+    close();
+}
+
+/**
+ *  Creates (or re-uses) the shared-memory object and maps the surface.
+ *
+ * \param name
+ *      The name of the object.  A leading slash is added if missing.
+ *
+ * \return
+ *      Returns true if the surface is ready.
+ */
+
+bool
+sharedstatus::open (const std::string & name)
+{
+    bool result = false;
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (! active() && ! name.empty())
+    {
+        m_name = name[0] == '/' ? name : "/" + name ;
+        m_fd = shm_open(m_name.c_str(), O_CREAT | O_RDWR, 0644);
+        if (m_fd >= 0)
+        {
+            size_t sz = sizeof(status_surface);
+            if (ftruncate(m_fd, off_t(sz)) == 0)
+            {
+                void * addr = mmap
+                (
+                    nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0
+                );
+                if (addr != MAP_FAILED)
+                {
+                    std::memset(addr, 0, sz);
+                    m_surface = new (addr) status_surface;
+                    m_surface->seqlock.store(0);
+                    m_surface->version = c_status_version;
+                    m_surface->size = std::uint32_t(sz);
+                    m_surface->slot_count = std::uint32_t(c_status_slots);
+                    m_surface->pid = std::int32_t(getpid());
+                    m_surface->mute_group = (-1);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    m_surface->magic = c_status_magic;      /* written last */
+                    result = true;
+                    infoprintf("Status surface %s created", m_name.c_str());
+                }
+            }
+            if (! result)
+                close();
+        }
+        if (! result)
+            errprintf("Status surface %s not created", m_name.c_str());
+    }
+#else
+    if (! name.empty())
+        warn_message("Status surface not supported", name);
+#endif
+    return result;
+}
+
+/**
+ *  Unmaps the surface and removes the shared-memory object.
+ */
+
+void
+sharedstatus::close ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    std::lock_guard<std::mutex> lk(m_write_mutex);
+    if (not_nullptr(m_surface))
+    {
+        m_surface->magic = 0;
+        m_surface->~status_surface();
+        (void) munmap(m_surface, sizeof(status_surface));
+        m_surface = nullptr;
+    }
+    if (m_fd >= 0)
+    {
+        (void) ::close(m_fd);
+        (void) shm_unlink(m_name.c_str());
+        m_fd = (-1);
+    }
+#endif
+}
+
+/**
+ *  Called by the output thread when an output cycle runs late.
+ */
+
+void
+sharedstatus::note_underrun (long late_us)
+{
+    ++m_underrun_count;
+    m_last_underrun_us = late_us;
+}
+
+/**
+ *  Updates the surface, unless the last update was too recent or another
+ *  thread is updating it.
+ *
+ * \param p
+ *      The performer whose state is published.
+ *
+ * \param force
+ *      If true, update even if the last update was recent.  Used when
+ *      playback stops.
+ */
+
+void
+sharedstatus::publish (performer & p, bool force)
+{
+    std::unique_lock<std::mutex> lk(m_write_mutex, std::try_to_lock);
+    if (! lk.owns_lock() || is_nullptr(m_surface))
+        return;
+
+    long now = microtime();
+    if (! force && (now - m_last_update_us) < c_status_period_us)
+        return;
+
+    m_last_update_us = now;
+
+    status_surface & s = *m_surface;
+    std::uint32_t lock = s.seqlock.load(std::memory_order_relaxed);
+    s.seqlock.store(lock + 1, std::memory_order_relaxed);   /* odd: busy    */
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::uint32_t flags = 0;
+    if (p.is_running())
+        flags |= status_running;
+
+    if (p.song_mode())
+        flags |= status_song_mode;
+
+    if (p.looping())
+        flags |= status_looping;
+
+    if (p.song_recording())
+        flags |= status_song_record;
+
+    if (p.is_jack_running())
+        flags |= status_jack;
+
+    s.flags = flags;
+    ++s.update_count;
+    s.update_us = now;
+    s.ppqn = p.ppqn();
+    s.tick = p.get_tick();
+    s.bpm = p.get_beats_per_minute();
+    s.beats_per_bar = p.get_beats_per_bar();
+    s.beat_width = p.get_beat_width();
+    s.playscreen = p.playscreen_number();
+    s.mute_group = p.group_selected();
+    s.last_underrun_us = std::int32_t(m_last_underrun_us.load());
+    s.underrun_count = m_underrun_count.load();
+
+    int high = int(p.sequence_high());
+    if (high > c_status_slots)
+        high = c_status_slots;
+
+    s.sequence_high = high;
+    for (int seqno : m_lit_slots)
+        s.slots[seqno] = 0;
+
+    /*
+     * Only the play-set is walked, not every slot.  The caller is the
+     * thread that swaps the play-set (see the hotswap module): the output
+     * thread while playing, the input thread while stopped.
+     */
+
+    m_lit_slots.clear();
+    for (const auto & sp : p.play_set().seq_container())
+    {
+        int seqno = sp ? sp->seq_number() : (-1) ;
+        if (seqno >= 0 && seqno < c_status_slots && sp->is_normal_seq())
+        {
+            std::uint8_t bits = slot_present;
+            if (sp->armed())
+                bits |= slot_armed;
+
+            if (sp->get_queued())
+                bits |= slot_queued;
+
+            if (sp->one_shot())
+                bits |= slot_one_shot;
+
+            if (sp->recording())
+                bits |= slot_recording;
+
+            s.slots[seqno] = bits;
+            if (m_lit_slots.size() < m_lit_slots.capacity())
+                m_lit_slots.push_back(seqno);
+        }
+    }
+    s.seqlock.store(lock + 2, std::memory_order_release);   /* even: done   */
+}
+
+}           // namespace seq66
+
+/*
+ * sharedstatus.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
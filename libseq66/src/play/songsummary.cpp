@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2021-01-22
- * \updates       2023-09-17
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  */
@@ -80,7 +80,7 @@ s_tag_names_container
     { c_seq_color,      "Color" },
     { c_seq_edit_mode,  "Normal/drum edit mode, not saved/used" },
     { c_seq_loopcount,  "N-repeat for pattern" },
-    { c_reserved_3,     "Reserved 3" },
+    { c_seq_reduction,  "Recorded controller reduction" },
     { c_reserved_4,     "Reserved 4" },
     { c_trig_transpose, "Transposable trigger" }
 };
@@ -341,7 +341,7 @@ songsummary::write_set_names
     const performer & p
 )
 {
-    int setcount = p.screenset_count();
+    int setcount = p.highest_set() + 1;         /* sets are sparse now  */
     file << "Screen-set Notes:" << "\n";
     write_prop_header(file, c_notes, setcount);
     for (int s = 0; s < setcount; ++s)
@@ -390,7 +390,10 @@ songsummary::write_global_bg (std::ofstream & file)
     file << "Global key, scale, and background sequence:" << "\n";
     write_prop_header(file, c_musickey, usr().seqedit_key());
     write_prop_header(file, c_musicscale, usr().seqedit_scale());
-    write_prop_header(file, c_backsequence, usr().seqedit_bgsequence());
+    write_prop_header
+    (
+        file, c_backsequence, seq::to_file(usr().seqedit_bgsequence())
+    );
 }
 
 void
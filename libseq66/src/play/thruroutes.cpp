@@ -0,0 +1,260 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          thruroutes.cpp
+ *
+ *  This module defines the precompiled table of MIDI Thru routes.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of thruroutes.hpp.
+ */
+
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "midi/mastermidibase.hpp"      /* seq66::mastermidibase            */
+#include "play/notemapper.hpp"          /* seq66::notemapper                */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "play/thruroutes.hpp"          /* seq66::thruroutes                */
+#include "util/basic_macros.hpp"        /* not_nullptr() macro              */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+/**
+ *  The routes start out dirty, so that the first input event builds them.
+ */
+
+thruroutes::thruroutes () :
+    m_dirty     (true),
+    m_routes    (),
+    m_held      ()
+{
+    m_held.reserve(c_notes_count);
+}
+
+/**
+ *  Adds the routes for one pattern that takes input.
+ *
+ * \param s
+ *      The pattern.  If it has channel-matching on, only events on its
+ *      channel match its route.
+ *
+ * \param nm
+ *      The note-mapper, used if the pattern records with note-mapping.  Can
+ *      be null.
+ *
+ * \param inbuss
+ *      The input buss that the pattern takes, or the null buss for any buss.
+ *
+ * \param claim
+ *      If true, the pattern takes every event from its input buss (or every
+ *      event, for the null buss), even one on another channel, so that no
+ *      further routes are checked.  This is the case for recording by buss
+ *      and for the single input pattern.  When recording by channel, it is
+ *      false, and only a channel-matching pattern stops the search.
+ */
+
+void
+thruroutes::add
+(
+    const sequence & s,
+    const notemapper * nm,
+    bussbyte inbuss,
+    bool claim
+)
+{
+    bool matching = s.channel_match();
+    midibyte channel = s.seq_midi_channel();
+    if (! (matching && is_null_channel(channel)))   /* else it takes none   */
+    {
+        route r;
+        r.in_buss = inbuss;
+        r.in_channel = matching ? channel : null_channel() ;
+        r.send = s.thru();
+        r.stop = matching || claim;
+        r.out_buss = s.true_bus();
+        r.out_channel = s.free_channel() ? null_channel() : channel ;
+        bool mapping = not_nullptr(nm) && s.notemapping();
+        for (int n = 0; n < c_notes_count; ++n)
+        {
+            midibyte note = midibyte(n);
+            r.notes[n] = mapping ? nm->fast_convert(note) : note ;
+        }
+        if (r.send || r.stop)
+            m_routes.push_back(r);
+    }
+    if (claim && matching)
+    {
+        route r = route();                      /* takes the other channels */
+        r.in_buss = inbuss;
+        r.in_channel = null_channel();
+        r.send = false;
+        r.stop = true;
+        r.out_buss = null_buss();
+        r.out_channel = null_channel();
+        m_routes.push_back(r);
+    }
+}
+
+/**
+ *  Echoes an incoming event along the matching routes.  A Note Off is not
+ *  looked up; it is sent wherever its Note On went, if anywhere.
+ *
+ * \param ev
+ *      The incoming event.  It is not modified.
+ *
+ * \param mmb
+ *      The master buss to send the echo to.
+ *
+ * \param tick
+ *      The current tick, used as the timestamp of the echo.
+ *
+ * \return
+ *      Returns true if the event was echoed.
+ */
+
+bool
+thruroutes::route_event
+(
+    const event & ev,
+    mastermidibase & mmb,
+    midipulse tick
+)
+{
+    bool result = false;
+    bussbyte inbuss = ev.input_bus();
+    midibyte inchannel = event::mask_channel(ev.get_status());
+    midibyte innote = ev.get_note();
+    bool noteon = ev.is_note_on() && ev.note_velocity() > 0;
+    bool noteoff = ev.is_note_off() || (ev.is_note_on() && ! noteon);
+    if (noteoff)
+    {
+        for (auto h = m_held.begin(); h != m_held.end(); /* inside */)
+        {
+            if
+            (
+                h->in_buss == inbuss && h->in_channel == inchannel &&
+                h->in_note == innote
+            )
+            {
+                send(mmb, ev, tick, h->out_buss, h->out_channel, h->out_note);
+                h = m_held.erase(h);
+                result = true;
+            }
+            else
+                ++h;
+        }
+    }
+    else
+    {
+        bool isnote = ev.is_note();
+        for (const auto & r : m_routes)
+        {
+            bool match =
+                (is_null_buss(r.in_buss) || r.in_buss == inbuss) &&
+                (is_null_channel(r.in_channel) || r.in_channel == inchannel);
+
+            if (match)
+            {
+                if (r.send)
+                {
+                    midibyte channel = is_null_channel(r.out_channel) ?
+                        ev.channel() : r.out_channel ;
+
+                    midibyte note = isnote ? r.notes[innote] : innote ;
+                    send(mmb, ev, tick, r.out_buss, channel, note);
+                    if (noteon)
+                    {
+                        m_held.push_back
+                        (
+                            held
+                            {
+                                inbuss, inchannel, innote,
+                                r.out_buss, channel, note
+                            }
+                        );
+                    }
+                    result = true;
+                }
+                if (r.stop)
+                    break;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  Sends a Note Off for each note still sounding through a route.  Called
+ *  when the rebuilt routes are empty, since the Note Offs will then not be
+ *  routed.
+ */
+
+void
+thruroutes::release (mastermidibase & mmb, midipulse tick)
+{
+    for (const auto & h : m_held)
+    {
+        event e(tick, EVENT_NOTE_OFF, h.out_channel, h.out_note, 0);
+        mmb.play(h.out_buss, &e, h.out_channel);
+    }
+    if (! m_held.empty())
+    {
+        m_held.clear();
+        mmb.flush();
+    }
+}
+
+/**
+ *  Sends one echo, at once, without waiting for the master buss lock that
+ *  the output thread holds while playing (see
+ *  mastermidibase::play_direct()).
+ */
+
+void
+thruroutes::send
+(
+    mastermidibase & mmb, const event & ev, midipulse tick,
+    bussbyte buss, midibyte channel, midibyte note
+)
+{
+    event evout;
+    evout.prep_for_send(tick, ev);
+    if (ev.is_note())
+        evout.set_note(note);
+
+    mmb.play_direct(buss, &evout, channel);
+}
+
+}           // namespace seq66
+
+/*
+ * thruroutes.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2022-10-03
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Man, we need to learn a lot more about triggers.  One important thing to
@@ -164,7 +164,8 @@ triggers::triggers (sequence & parent) :
     m_trigger_copied            (false),
     m_paste_tick                (c_no_paste_trigger),   // stazed
     m_ppqn                      (0),
-    m_length                    (0)
+    m_length                    (0),
+    m_record_index              (-1)
 {
     // Empty body
 }
@@ -198,10 +199,49 @@ triggers::operator = (const triggers & rhs)
         m_trigger_copied = rhs.m_trigger_copied;
         m_ppqn = rhs.m_ppqn;
         m_length = rhs.m_length;
+        m_record_index = (-1);                  /* not recording the copy   */
     }
     return *this;
 }
 
+/**
+ *  Estimates the heap memory used by the triggers, including the undo and
+ *  redo lists.  Capacity, not size, is counted, since that is what is
+ *  allocated.
+ *
+ * \return
+ *      Returns the estimate in bytes.
+ */
+
+std::size_t
+triggers::memory_size () const
+{
+    std::size_t result = m_triggers.capacity() * sizeof(trigger);
+    for (const auto & tc : m_undo_stack.items())
+        result += tc.capacity() * sizeof(trigger);
+
+    for (const auto & tc : m_redo_stack.items())
+        result += tc.capacity() * sizeof(trigger);
+
+    return result;
+}
+
+/**
+ *  Releases the unused capacity of the trigger list.  The draw iterator is
+ *  invalidated, so it is reset.  The undo and redo lists are copies, which
+ *  have no unused capacity.
+ */
+
+void
+triggers::compact ()
+{
+    if (m_triggers.capacity() > m_triggers.size())
+    {
+        m_triggers.shrink_to_fit();
+        m_draw_iterator = m_triggers.end();
+    }
+}
+
 bool
 triggers::rescale (int newppqn, int oldppqn)
 {
@@ -643,6 +683,110 @@ triggers::grow_trigger (midipulse tickfrom, midipulse tickto, midipulse len)
     return result;
 }
 
+/**
+ *  Grows the trigger being song-recorded.  This is called every output
+ *  cycle for each pattern being song-recorded, so the common case is done
+ *  in place: the trigger found on the previous call is checked, and its end
+ *  is moved, without a search, an add(), or a sort.  This keeps the trigger
+ *  list sorted and without overlaps, so it is used only if the trigger
+ *  still contains tickfrom, starts before tickto, and would not reach the
+ *  next trigger.  Otherwise grow_trigger() does the work, cutting the next
+ *  trigger as needed, and the trigger is looked up again.
+ *
+ * \param tickfrom
+ *      The tick at which recording started.
+ *
+ * \param tickto
+ *      The current tick.
+ *
+ * \param len
+ *      The additional length to append to tickto.
+ *
+ * \return
+ *      Returns true if the trigger changed.
+ */
+
+bool
+triggers::grow_recording (midipulse tickfrom, midipulse tickto, midipulse len)
+{
+    bool result = false;
+    bool done = false;
+    int count = int(m_triggers.size());
+    if (m_record_index >= 0 && m_record_index < count)
+    {
+        trigger & t = m_triggers[m_record_index];
+        if (t.covers(tickfrom) && tickto >= t.tick_start())
+        {
+            midipulse calcend = tickto + len - 1;
+            if (calcend <= t.tick_end())
+            {
+                done = true;                        /* nothing to grow      */
+            }
+            else
+            {
+                int next = m_record_index + 1;
+                if (next == count || calcend < m_triggers[next].tick_start())
+                {
+                    t.tick_end(calcend);
+                    result = done = true;
+                }
+            }
+        }
+    }
+    if (! done)
+    {
+        result = grow_trigger(tickfrom, tickto, len);
+        m_record_index = result ? index_of(tickfrom) : (-1) ;
+    }
+    return result;
+}
+
+/**
+ *  Ends song recording: the trigger is grown a last time, using the full
+ *  grow_trigger(), which merges it with the triggers it overlaps.  If the
+ *  recorded trigger already covers the final span, nothing is done.
+ *
+ * \return
+ *      Returns true if the trigger changed.
+ */
+
+bool
+triggers::finish_recording (midipulse tickfrom, midipulse tickto, midipulse len)
+{
+    bool result = false;
+    int index = index_of(tickfrom);
+    m_record_index = (-1);
+    if (index >= 0)
+    {
+        const trigger & t = m_triggers[index];
+        result = tickto < t.tick_start() || tickto + len - 1 > t.tick_end();
+        if (result)
+            result = grow_trigger(tickfrom, tickto, len);
+    }
+    return result;
+}
+
+/**
+ *  Finds the index of the trigger that contains the given tick.
+ *
+ * \return
+ *      Returns the index, or -1 if no trigger contains the tick.
+ */
+
+int
+triggers::index_of (midipulse tick) const
+{
+    int index = 0;
+    for (const auto & t : m_triggers)
+    {
+        if (t.tick_start() <= tick && tick <= t.tick_end())
+            return index;
+
+        ++index;
+    }
+    return (-1);
+}
+
 /**
  *  Deletes the first trigger that brackets the given tick from the
  *  trigger-list.
@@ -25,7 +25,7 @@
  * \library       clinsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-08-31
- * \updates       2023-08-29
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This object also works if there is no session manager in the build.  It
@@ -318,6 +318,7 @@ clinsmanager::run ()
 {
     bool result = false;
     session_setup();
+    show_memory_report();
     while (! session_close())
     {
         result = true;
@@ -330,11 +331,48 @@ clinsmanager::run ()
                 file_error(msg, "CLI");
             }
         }
+        (void) autosave();
         millisleep(m_poll_period_ms);
     }
+    show_memory_report();
+    show_bandwidth_report();
     return true;
 }
 
+/**
+ *  Shows the load of the output ports limited in the 'rc' file's
+ *  [midi-bandwidth] section, so that the user can tell if a DIN port was
+ *  saturated during the session.
+ */
+
+void
+clinsmanager::show_bandwidth_report ()
+{
+    if (not_nullptr(perf()))
+    {
+        std::string report = perf()->bandwidth_report();
+        if (! report.empty())
+            printf("%s", report.c_str());
+    }
+}
+
+/**
+ *  Shows the memory used by the largest patterns, if requested by the
+ *  "-o memory" option.  Meant for finding the patterns that use the most
+ *  memory in a large song.
+ */
+
+void
+clinsmanager::show_memory_report ()
+{
+    int count = usr().option_memory_report();
+    if (count > 0 && not_nullptr(perf()))
+    {
+        std::string report = perf()->memory_report(count);
+        printf("%s", report.c_str());
+    }
+}
+
 /**
  *  Creates a session path specified by the Non Session Manager.  This
  *  function is meant to be called after receiving the /nsm/client/open
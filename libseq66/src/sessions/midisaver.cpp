@@ -0,0 +1,243 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midisaver.cpp
+ *
+ *  This module defines the thread that writes saved MIDI files.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-17
+ * \updates       2026-10-17
+ * \license       GNU GPLv2 or above
+ *
+ *  See the banner of midisaver.hpp.
+ */
+
+#include "midi/midifile.hpp"            /* seq66::midifile::write_file_data */
+#include "sessions/midisaver.hpp"       /* seq66::midisaver                 */
+#include "util/basic_macros.hpp"        /* seq66::file_message(), etc.      */
+
+/*
+ *  Do not document a namespace; it breaks Doxygen.
+ */
+
+namespace seq66
+{
+
+midisaver::midisaver () :
+    m_thread        (),
+    m_mutex         (),
+    m_cv            (),
+    m_requests      (),
+    m_busy          (false),
+    m_error_message (),
+    m_failed        (false),
+    m_exit          (false)
+{
+    // no code
+}
+
+midisaver::~midisaver ()
+{
+    stop();
+}
+
+/**
+ *  Starts the writer thread.
+ *
+ * \return
+ *      Returns true if the thread was started.
+ */
+
+bool
+midisaver::start ()
+{
+    bool result = ! active();
+    if (result)
+    {
+        m_exit = false;
+        m_thread = std::thread(&midisaver::save_func, this);
+    }
+    return result;
+}
+
+/**
+ *  Stops the writer thread.  The pending requests are written first, so that
+ *  a save made just before exiting is not lost.
+ */
+
+void
+midisaver::stop ()
+{
+    if (active())
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_exit = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+}
+
+/**
+ *  Queues a song snapshot for writing.  A request for the same file that
+ *  the thread has not yet taken is replaced, since the new snapshot is more
+ *  recent.  A request for another file is queued behind the pending ones.
+ *
+ * \param filename
+ *      The full path to the MIDI file.
+ *
+ * \param [in,out] snap
+ *      The midifile on which snapshot() succeeded.  It is swapped into the
+ *      request, so the caller is left holding the midifile of a replaced
+ *      request, or nothing.
+ *
+ * \return
+ *      Returns true if the thread is running and the request was queued.
+ */
+
+bool
+midisaver::request
+(
+    const std::string & filename,
+    std::unique_ptr<midifile> & snap
+)
+{
+    bool result = active() && ! filename.empty() && bool(snap);
+    if (result)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            bool replaced = false;
+            for (auto & r : m_requests)
+            {
+                if (r.first == filename)
+                {
+                    r.second.swap(snap);
+                    replaced = true;
+                    break;
+                }
+            }
+            if (! replaced)
+            {
+                m_requests.emplace_back(filename, nullptr);
+                m_requests.back().second.swap(snap);
+            }
+        }
+        m_cv.notify_all();
+    }
+    return result;
+}
+
+/**
+ *  Waits until the pending requests, if any, have been written.
+ */
+
+void
+midisaver::wait ()
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [this] { return m_requests.empty() && ! m_busy; });
+}
+
+/**
+ *  Reports a failed write, once.
+ *
+ * \param [out] errmsg
+ *      Set to the error message if a write failed.
+ *
+ * \return
+ *      Returns true if a write failed since the last call.
+ */
+
+bool
+midisaver::failed (std::string & errmsg)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    bool result = m_failed;
+    if (result)
+    {
+        errmsg = m_error_message;
+        m_error_message.clear();
+        m_failed = false;
+    }
+    return result;
+}
+
+/**
+ *  The thread function.  It takes the oldest pending request, and encodes
+ *  and writes it outside of the lock, so that a new request can be made
+ *  during a slow write.
+ */
+
+void
+midisaver::save_func ()
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (;;)
+    {
+        m_cv.wait(lk, [this] { return ! m_requests.empty() || m_exit; });
+        if (! m_requests.empty())
+        {
+            std::string filename;
+            std::unique_ptr<midifile> snap;
+            filename.swap(m_requests.front().first);
+            snap.swap(m_requests.front().second);
+            m_requests.pop_front();
+            m_busy = true;
+            lk.unlock();
+
+            std::string errmsg;
+            midibytes data;
+            bool ok = snap->encode_snapshot(data);
+            if (ok)
+                ok = midifile::write_file_data(filename, data, errmsg);
+            else
+                errmsg = snap->error_message();
+
+            snap.reset();                   /* frees the pattern copies     */
+            if (ok)
+                file_message("Wrote MIDI file", filename);
+            else
+                file_error(errmsg, filename);
+
+            lk.lock();
+            m_busy = false;
+            if (! ok)
+            {
+                m_error_message = errmsg;
+                m_failed = true;
+            }
+            m_cv.notify_all();
+        }
+        else if (m_exit)
+            break;
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * midisaver.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-03-22
- * \updates       2023-12-13
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  Note that this module is part of the libseq66 library, not the libsessions
@@ -61,6 +61,7 @@
 #include "play/playlist.hpp"            /* seq66::playlist class            */
 #include "sessions/smanager.hpp"        /* seq66::smanager()                */
 #include "os/daemonize.hpp"             /* seq66::reroute_stdio(), etc.     */
+#include "os/timing.hpp"                /* seq66::millitime()               */
 #include "util/basic_macros.hpp"        /* seq66::msgprintf()               */
 #include "util/filefunctions.hpp"       /* seq66::file_readable() etc.      */
 
@@ -105,6 +106,8 @@ static std::string s_port_update_msg
 
 smanager::smanager (const std::string & caps) :
     m_perf_pointer          (),                 /* perf() accessor */
+    m_midi_saver            (),
+    m_last_save_ms          (0),
     m_capabilities          (caps),
     m_session_manager_name  ("None"),
     m_session_manager_path  ("None"),
@@ -488,7 +491,16 @@ smanager::create_performer ()
         result = perf()->launch(ppqn);              // std::string perfmsgs;
         if (result)
         {
-            // Anything to do?
+            bool bgsave =
+                rc().background_save() || rc().autosave_interval() > 0;
+
+            if (bgsave && ! m_midi_saver)
+            {
+                m_midi_saver.reset(new (std::nothrow) midisaver());
+                if (m_midi_saver)
+                    (void) m_midi_saver->start();
+            }
+            m_last_save_ms = millitime();
         }
         else
         {
@@ -670,6 +682,9 @@ smanager::close_session (std::string & msg, bool ok)
         perf()->put_settings(rc(), usr());     /* copy latest settings      */
         if (result)
             (void) save_session(msg, result);
+
+        if (m_midi_saver)
+            m_midi_saver->stop();              /* finishes a pending write  */
     }
     result = ok;
     (void) session_close();                    /* daemonize signals exit   */
@@ -718,9 +733,10 @@ smanager::save_session (std::string & msg, bool ok)
                     if (is_wrk)
                         filename = file_extension_set(filename, ".midi");
 
-                    result = write_midi_file(*perf(), filename, msg);
+                    bool bg = rc().background_save();
+                    result = save_midi_file(filename, msg, bg);
                     if (result)
-                        msg = result ? "Saved: " : "Not able to save: " ;
+                        msg = bg ? "Saving: " : "Saved: " ;
 
                     msg += filename;
                 }
@@ -778,6 +794,120 @@ smanager::save_session (std::string & msg, bool ok)
     return result;
 }
 
+/**
+ *  Saves the MIDI file.  In the background case, a snapshot of the song is
+ *  taken here (see midifile::snapshot()) and handed to the midisaver
+ *  thread, which encodes it and writes it atomically.  The performer is
+ *  marked as unmodified at once; if the write fails, autosave() marks it as
+ *  modified again.
+ *
+ * \param filename
+ *      The full path to the MIDI file.
+ *
+ * \param [out] msg
+ *      Set to the error message, if any.
+ *
+ * \param background
+ *      If true, and the midisaver thread is running, the file is written in
+ *      the background.  Otherwise write_midi_file() is called.
+ *
+ * \return
+ *      Returns true if the file was written or queued for writing.
+ */
+
+bool
+smanager::save_midi_file
+(
+    const std::string & filename,
+    std::string & msg,
+    bool background
+)
+{
+    bool result;
+    if (background && m_midi_saver && m_midi_saver->active())
+    {
+        std::unique_ptr<midifile> f
+        (
+            new (std::nothrow)
+                midifile(filename, perf()->ppqn(), usr().global_seq_feature())
+        );
+        perf()->compact_patterns();
+        result = bool(f);
+        if (result)
+        {
+            result = f->snapshot(*perf());
+            if (result)
+                result = m_midi_saver->request(filename, f);
+            else
+                msg = f->error_message();
+        }
+
+        if (result)
+        {
+            rc().midi_filename(filename);
+            rc().last_used_dir(filename.substr(0, filename.rfind("/") + 1));
+            rc().add_recent_file(filename);
+            perf()->unmodify();
+        }
+        else if (msg.empty())
+            msg = "Background save failed";
+    }
+    else
+        result = write_midi_file(*perf(), filename, msg);
+
+    m_last_save_ms = millitime();
+    return result;
+}
+
+/**
+ *  Handles the 'rc' option "autosave-interval".  Meant to be called often
+ *  from the thread that owns the session (the Qt main window timer or the
+ *  command-line polling loop).  If the interval has passed since the last
+ *  save and the song is modified, the MIDI file is saved in the background.
+ *  Files imported from another format (e.g. ".wrk") are not autosaved, as
+ *  that would require a new file-name.
+ *
+ *  Also checks for a failed background write, and marks the song as
+ *  modified so that it is not lost.
+ *
+ * \return
+ *      Returns true if an autosave was started.
+ */
+
+bool
+smanager::autosave ()
+{
+    bool result = false;
+    if (m_midi_saver && not_nullptr(perf()))
+    {
+        std::string msg;
+        if (m_midi_saver->failed(msg))
+            perf()->modify();
+
+        long interval_ms = long(rc().autosave_interval()) * 1000;
+        if (interval_ms > 0 && perf()->modified())
+        {
+            long now = millitime();
+            if (now - m_last_save_ms >= interval_ms)
+            {
+                std::string filename = rc().midi_filename();
+                m_last_save_ms = now;
+                if (! filename.empty())
+                {
+                    if (! file_extension_match(filename, ".wrk"))
+                    {
+                        session_message("Autosave", filename);
+                        result = save_midi_file(filename, msg, true);
+                        if (! result)
+                            file_error(msg, filename);
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
 /**
  *  This function is overridden in qt5nsmanager to actually create the
  *  user-interface.
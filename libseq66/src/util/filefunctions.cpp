@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2024-03-12
+ * \updates       2026-10-17
  * \version       $Revision$
  *
  *    We basically include only the functions we need for Seq66, not
@@ -618,6 +618,31 @@ file_size (const std::string & filename)
     return result;
 }
 
+/**
+ *  Gets the modification time of a file.
+ *
+ * \param filename
+ *      The name of the file.
+ *
+ * \return
+ *      Returns the modification time of the file or 0 if the file cannot be
+ *      accessed.
+ */
+
+std::time_t
+file_modification_time (const std::string & filename)
+{
+    std::time_t result = 0;
+    if (file_name_good(filename))
+    {
+        stat_t statusbuf;
+        int statresult = S_STAT(filename.c_str(), &statusbuf);
+        if (statresult == 0)
+            result = statusbuf.st_mtime;
+    }
+    return result;
+}
+
 /**
  *  Verifies that a file-name pointer is legal.  The following checks are
  *  made:
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2019-03-10
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This mastermidibus module is the Windows (and Linux now!) version of the
@@ -67,11 +67,11 @@ protected:
     virtual bool api_get_midi_event (event * in);
     virtual void api_set_ppqn (int ppqn);
     virtual void api_set_beats_per_minute (midibpm bpm);
+    virtual void api_flush () override;
 
     /*
      * Are these necessary?
      *
-    virtual void api_flush ();
     virtual void api_start ();
     virtual void api_stop ();
     virtual void api_continue_from (midipulse tick);
@@ -27,14 +27,23 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-12-05
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This midibus module is the Windows (PortMidi) version of the midibus
  *  module.  There's  enough commonality that is was worth creating a base
  *  class for all midibus classes.
+ *
+ *  If the 'rc' option "portmidi-latency" is greater than 0, the output
+ *  port is opened with that latency, and events are not written one at a
+ *  time.  Instead they are time-stamped from the pulse clock, collected in
+ *  an array, and written with one Pm_Write() call when the buss is flushed
+ *  (once per output cycle).  The MIDI driver (e.g. the ALSA queue used by
+ *  pmlinuxalsa.c) then schedules them.
  */
 
+#include <vector>                       /* std::vector<PmEvent>             */
+
 #include "midi/midibase.hpp"
 #include "portmidi.h"                   /* PortMIDI API header file         */
 
@@ -75,6 +84,31 @@ private:
 
     bool m_is_port_locked;
 
+    /**
+     *  The output latency in milliseconds, from the 'rc' option
+     *  "portmidi-latency".  If 0, each event is written immediately.
+     */
+
+    int m_latency;
+
+    /**
+     *  Holds the time-stamped events of the current output cycle, when
+     *  m_latency is greater than 0.  Written by api_flush().
+     */
+
+    std::vector<PmEvent> m_out_events;
+
+    /**
+     *  The pulse clock.  The PortMidi time (ms) of an event is calculated
+     *  from its pulse relative to this anchor, at the tempo and PPQN that
+     *  were in force when the anchor was set.
+     */
+
+    midipulse m_anchor_pulse;
+    PmTimestamp m_anchor_ms;
+    double m_ms_per_pulse;
+    bool m_anchored;
+
 public:
 
     /*
@@ -102,6 +136,11 @@ public:
         m_is_port_locked = true;
     }
 
+    bool batched () const
+    {
+        return m_latency > 0;
+    }
+
 protected:
 
     virtual int api_poll_for_midi () override;
@@ -112,6 +151,7 @@ protected:
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_flush () override;
 
     /*
      * Functions not implemented in PortMIDI.  For example, the "sub"
@@ -126,12 +166,13 @@ protected:
      * We should be able to implement this in a "sysex_fix" branch:
      *
      * virtual void api_sysex (const event * e24);
-     *
-     * This function should be able to be implemented in Windows and ALSA:
-     *
-     * virtual void api_flush ();
      */
 
+private:
+
+    void write_event (PmMessage msg, midipulse tick);
+    PmTimestamp pulse_time (midipulse tick);
+
 };          // class midibus (portmidi)
 
 }           // namespace seq66
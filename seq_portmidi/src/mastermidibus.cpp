@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-09-20
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the mastermidibus
@@ -256,25 +256,40 @@ mastermidibus::api_get_midi_event (event * in)
 }
 
 /**
- *  Not yet implemented.  There is no PPQN code in the original PortMIDI
- *  project.
+ *  There is no PPQN code in the original PortMIDI project.  We pass the
+ *  value to our porttime additions, which the output busses use to convert
+ *  pulses to milliseconds in the batched ("portmidi-latency") mode.
  */
 
 void
-mastermidibus::api_set_ppqn (int /*ppqn*/)
+mastermidibus::api_set_ppqn (int ppqn)
 {
-    // no code
+    Pt_Set_Ppqn(ppqn);
 }
 
 /**
- *  Not yet implemented.  There is no BPM code in the original PortMIDI
- *  project.  Tempo is set via a timer (at least in their test application).
+ *  There is no BPM code in the original PortMIDI project.  Tempo is set via
+ *  a timer (at least in their test application).  As with the PPQN, we
+ *  pass the value to porttime for the output busses.
  */
 
 void
-mastermidibus::api_set_beats_per_minute (midibpm /*bpm*/)
+mastermidibus::api_set_beats_per_minute (midibpm bpm)
 {
-    // no code
+    Pt_Set_Bpm(double(bpm));
+}
+
+/**
+ *  Flushes the output busses.  This matters only when the 'rc' option
+ *  "portmidi-latency" is set, in which case each buss holds the events of
+ *  the current output cycle and writes them as one array.  Otherwise the
+ *  busses have nothing pending, and this call does nothing.
+ */
+
+void
+mastermidibus::api_flush ()
+{
+    m_outbus_array.flush();
 }
 
 }           // namespace seq66
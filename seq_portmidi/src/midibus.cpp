@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-06-28
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the midibus class.
@@ -42,10 +42,13 @@
  *          -   deinit_in()
  */
 
+#include <algorithm>                    /* std::stable_sort()               */
+
 #include "cfg/settings.hpp"             /* seq66::rc_settings               */
 #include "midi/event.hpp"               /* seq66::event and macros          */
 #include "os/timing.hpp"                /* seq66::microsleep()              */
 #include "midibus_pm.hpp"               /* seq66::midibus for PortMIDI      */
+#include "porttime.h"                   /* Pt_Time(), Pt_Get_Bpm(), etc.    */
 
 /*
  *  Do not document a namespace; it breaks Doxygen.
@@ -54,6 +57,13 @@
 namespace seq66
 {
 
+/**
+ *  The number of events collected before they are written, even if the
+ *  buss has not been flushed.  Also the initial capacity of the array.
+ */
+
+static const std::size_t c_pm_batch_size = 256;
+
 #if defined THIS_FUNCTION_IS_NEEDED
 
 static std::string
@@ -97,9 +107,16 @@ midibus::midibus
         midibase::port::normal              // false
     ),
     m_pms               (nullptr),
-    m_is_port_locked    (false)
+    m_is_port_locked    (false),
+    m_latency           (rc().portmidi_latency()),
+    m_out_events        (),
+    m_anchor_pulse      (0),
+    m_anchor_ms         (0),
+    m_ms_per_pulse      (0.0),
+    m_anchored          (false)
 {
-    // Empty body
+    if (batched())
+        m_out_events.reserve(c_pm_batch_size);
 }
 
 /**
@@ -110,6 +127,9 @@ midibus::~midibus ()
 {
     if (not_nullptr(m_pms))
     {
+        if (! m_out_events.empty())
+            api_flush();
+
         Pm_Close(m_pms);
         m_pms = nullptr;
     }
@@ -155,6 +175,9 @@ midibus::api_poll_for_midi ()
  *  If there is an error, we set the clocking to e_clock::disable to indicate
  *  we should not bother to use the port.
  *
+ *  A non-zero latency makes PortMidi start its timer and schedule each
+ *  event at its time-stamp plus the latency.
+ *
  * \return
  *      Returns true if the output port was successfully opened.
  */
@@ -164,7 +187,7 @@ midibus::api_init_out ()
 {
     PmError err = Pm_OpenOutput
     (
-        &m_pms, queue_number(), NULL, 100, NULL, NULL, 0
+        &m_pms, queue_number(), NULL, 100, NULL, NULL, m_latency
     );
     bool result = err == pmNoError;
     if (! result)
@@ -218,6 +241,11 @@ midibus::api_init_in ()
  *  the queue.  It fills a small byte buffer, sets the MIDI channel, makes a
  *  message of it, and writes the message.
  *
+ *  In the batched mode, the message is instead added to the array written
+ *  by api_flush().  Its time is calculated from the time-stamp of the
+ *  event, which is the pulse at which it is played (see
+ *  event::prep_for_send()).
+ *
  * \question
  *      The subatomic glue (Windows/PortMidi) implementation of Seq24 uses a
  *      mutex to lock this function.  Do we need to do that? Done in the
@@ -236,11 +264,127 @@ midibus::api_play (const event * e24, midibyte channel)
     midibyte buffer[4];                /* temp for midi data */
     buffer[0] = e24->get_status(channel);
     e24->get_data(buffer[1], buffer[2]);
+    write_event
+    (
+        Pm_Message(buffer[0], buffer[1], buffer[2]), e24->timestamp()
+    );
+}
+
+/**
+ *  Writes a message immediately, or, in the batched mode, adds it to the
+ *  output array with a time-stamp calculated from the given pulse.  If the
+ *  array is full, it is written now.
+ *
+ * \param msg
+ *      The PortMidi message.
+ *
+ * \param tick
+ *      The pulse at which the message is to be played.  Ignored if not in
+ *      the batched mode.
+ */
 
+void
+midibus::write_event (PmMessage msg, midipulse tick)
+{
     PmEvent event;
-    event.timestamp = 0;
-    event.message = Pm_Message(buffer[0], buffer[1], buffer[2]);
-    /* PmError err = */ Pm_Write(m_pms, &event, 1);
+    event.message = msg;
+    if (batched())
+    {
+        event.timestamp = pulse_time(tick);
+        m_out_events.push_back(event);
+        if (m_out_events.size() >= c_pm_batch_size)
+            api_flush();
+    }
+    else
+    {
+        event.timestamp = 0;
+        /* PmError err = */ Pm_Write(m_pms, &event, 1);
+    }
+}
+
+/**
+ *  Converts a pulse to a PortMidi time in milliseconds.  The first pulse
+ *  after start-up is anchored to the current PortMidi time; following pulses
+ *  are offset from the anchor at the current tempo, so that the spacing of
+ *  the events does not depend on when the output thread got around to
+ *  sending them.
+ *
+ *  The pulse clock is re-anchored when the tempo or PPQN changes, or when
+ *  the calculated time has drifted from the PortMidi clock by more than the
+ *  latency (e.g. after a reposition, a pause, or a JACK relocation).  A
+ *  pulse a little earlier than the previous one is normal, since each
+ *  pattern sends the events of its own part of the output cycle.
+ *
+ * \param tick
+ *      The pulse to convert.
+ *
+ * \return
+ *      Returns the time-stamp for the event, never 0, since PortMidi takes
+ *      0 to mean "now".
+ */
+
+PmTimestamp
+midibus::pulse_time (midipulse tick)
+{
+    PmTimestamp now = Pt_Time();
+    double bpm = Pt_Get_Bpm();
+    int ppqn = Pt_Get_Ppqn();
+    double mspp = (bpm > 0.0 && ppqn > 0) ? 60000.0 / (bpm * ppqn) : 0.0 ;
+    bool reanchor = ! m_anchored;
+    if (mspp != m_ms_per_pulse)
+        reanchor = true;
+
+    PmTimestamp result = now;
+    if (! reanchor)
+    {
+        double offset = double(tick - m_anchor_pulse) * m_ms_per_pulse;
+        result = m_anchor_ms + PmTimestamp(offset + 0.5);
+
+        PmTimestamp drift = result - now;
+        if (drift > m_latency || drift < -m_latency)
+            reanchor = true;
+    }
+    if (reanchor)
+    {
+        m_anchor_pulse = tick;
+        m_anchor_ms = now;
+        m_ms_per_pulse = mspp;
+        m_anchored = true;
+        result = now;
+    }
+    return result == 0 ? 1 : result ;
+}
+
+/**
+ *  In the batched mode, writes all of the pending events with one Pm_Write()
+ *  call.  Called once per output cycle via mastermidibus::api_flush().  The
+ *  patterns add their events one pattern after the other, so the events
+ *  are first put in time order (keeping the order of events with the same
+ *  time), as PortMidi expects.
+ */
+
+void
+midibus::api_flush ()
+{
+    if (! m_out_events.empty())
+    {
+        if (not_nullptr(m_pms))
+        {
+            std::stable_sort
+            (
+                m_out_events.begin(), m_out_events.end(),
+                [] (const PmEvent & a, const PmEvent & b)
+                {
+                    return a.timestamp < b.timestamp;
+                }
+            );
+            /* PmError err = */ Pm_Write
+            (
+                m_pms, m_out_events.data(), int32_t(m_out_events.size())
+            );
+        }
+        m_out_events.clear();
+    }
 }
 
 /**
@@ -258,6 +402,8 @@ midibus::api_play (const event * e24, midibyte channel)
 void
 midibus::api_continue_from (midipulse /* tick */, midipulse beats)
 {
+    api_flush();                            /* pending events go first      */
+
     PmEvent event;
     event.timestamp = 0;
     event.message = Pm_Message(EVENT_MIDI_CONTINUE, 0, 0);
@@ -279,6 +425,8 @@ midibus::api_start ()
 {
     if (not_nullptr(m_pms) && port_enabled())
     {
+        api_flush();                        /* pending events go first      */
+
         PmEvent event;
         event.timestamp = 0;
         event.message = Pm_Message(EVENT_MIDI_START, 0, 0);
@@ -296,6 +444,8 @@ midibus::api_stop ()
 {
     if (not_nullptr(m_pms) && port_enabled())
     {
+        api_flush();                        /* pending events go first      */
+
         PmEvent event;
         event.timestamp = 0;
         event.message = Pm_Message(EVENT_MIDI_STOP, 0, 0);
@@ -305,6 +455,8 @@ midibus::api_stop ()
 
 /**
  *  Generates MIDI clock.  This function is called by midibase::clock().
+ *  In the batched mode, the clock is time-stamped from the same pulse clock
+ *  as the other events, so that it stays in step with them.
  *
  * \question
  *      The subatomic glue (Windows/PortMidi) implementation of Seq24 uses a
@@ -312,20 +464,14 @@ midibus::api_stop ()
  *      midibase::clock().
  *
  * \param tick
- *      The clock tick value, not used in the API implementation of this
- *      function for PortMidi.
+ *      The clock tick value, used only in the batched mode.
  */
 
 void
-midibus::api_clock (midipulse /* tick */)
+midibus::api_clock (midipulse tick)
 {
     if (not_nullptr(m_pms) && port_enabled())
-    {
-        PmEvent event;
-        event.timestamp = 0;                /* WHY NOT use 'tick' here? */
-        event.message = Pm_Message(EVENT_MIDI_CLOCK, 0, 0);
-        Pm_Write(m_pms, &event, 1);
-    }
+        write_event(Pm_Message(EVENT_MIDI_CLOCK, 0, 0), tick);
 }
 
 }           // namespace seq66
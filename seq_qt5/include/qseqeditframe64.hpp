@@ -304,6 +304,7 @@ private slots:
     void randomize_notes ();
     void transpose_notes ();
     void transpose_harmonic ();
+    void set_cc_reduction ();
     void remap_notes ();
     void tooltip_mode (bool ischecked);
     void note_entry (bool ischecked);
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-05-11
- * \updates       2023-11-11
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  We want to be able to survey the existing screen-sets and sequences, and
@@ -171,6 +171,7 @@ private:
 #endif
 
     QTableWidgetItem * cell (screenset::number row, column_id col);
+    screenset::number row_set (int row);
     void move_helper (int oldrow, int newrow);
 
 signals:
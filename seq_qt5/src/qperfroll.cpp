@@ -380,8 +380,7 @@ qperfroll::mousePressEvent(QMouseEvent * event)
                 {
                     sp = trigger::splitpoint::snap;
                     tick -= m_drop_tick_offset;
-                    if (snap() > 0)
-                        tick -= tick % snap();
+                    tick = perf().meter_map().snap(tick, snap());
                 }
                 (void) perf().split_trigger(m_drop_track, tick, sp);
             }
@@ -585,7 +584,7 @@ qperfroll::mouseMoveEvent (QMouseEvent * event)
         midipulse s = snap() == 0 ? seqlength : snap();
         convert_x(x, tick);
         if (perf().song_record_snap())
-            tick -= tick % s;
+            tick = perf().meter_map().snap(tick, s);
 
         (void) perf().grow_trigger
         (
@@ -597,8 +596,7 @@ qperfroll::mouseMoveEvent (QMouseEvent * event)
         convert_x(x, tick);
         tick -= m_drop_tick_offset;
         if (perf().song_record_snap())          /* apply to move/grow too   */
-            if (snap() > 0)                     /* compare Seq64 issue #171 */
-                tick -= tick % snap();
+            tick = perf().meter_map().snap(tick, snap());   /* Seq64 #171   */
 
         if (moving())                           /* move selected triggers   */
         {
@@ -1025,24 +1023,26 @@ qperfroll::draw_grid (QPainter & painter, const QRect & r)
     }
 
     /*
-     *  Draw the vertical lines for the measures and the beats. Incrementing by
-     *  the beat-length (PPQN) makes drawing go faster.
+     *  Draw the vertical lines for the measures and the beats. Stepping
+     *  by beats makes drawing go faster.  The song's meter map provides the
+     *  beats, even across changes in time signature.
      */
 
-    midipulse tick0 = scroll_offset();
+    const metermap & mm = perf().meter_map();
+    midipulse tick0 = mm.beat_start(scroll_offset());
     midipulse windowticks = pix_to_tix(xwidth);
-    midipulse tick1 = tick0 + windowticks;
-    midipulse tickstep = beat_length();                 /* versus 1         */
+    midipulse tick1 = scroll_offset() + windowticks;
     int penwidth = 1;
-    for (midipulse tick = tick0; tick < tick1; tick += tickstep)
+    for (midipulse tick = tick0; tick < tick1; tick = mm.next_beat(tick))
     {
         int x_pos = xoffset(tick);
-        if (tick % measure_length() == 0)               /* measure          */
+        midi_measures bbt = mm.to_measures(tick);
+        if (bbt.beats() == 1 && bbt.divisions() == 0)   /* measure          */
         {
             pen.setColor(beat_paint());                 /* fore_color()     */
             penwidth = 2;
         }
-        else if (tick % beat_length() == 0)             /* beat             */
+        else                                            /* beat             */
         {
             pen.setColor(beat_color());
             penwidth = 1;
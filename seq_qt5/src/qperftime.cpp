@@ -131,24 +131,20 @@ qperftime::paintEvent (QPaintEvent * /*qpep*/)
         set_initialized();
 
     /*
-     *  Draw the vertical lines for the measures and the beats.
+     *  Draw the vertical lines for the measures and the beats.  The song's
+     *  meter map provides the beats and the measure numbers, even across
+     *  changes in time signature.
      */
 
-    midipulse tick0 = scroll_offset();
+    const metermap & mm = perf().meter_map();
+    midipulse tick0 = mm.beat_start(scroll_offset());
     midipulse windowticks = pix_to_tix(xwidth);
-    midipulse tick1 = tick0 + windowticks;
-    midipulse tickstep = beat_length();                     /* versus 1     */
-    int measure = 0;
-    for (midipulse tick = tick0; tick < tick1; tick += tickstep)
+    midipulse tick1 = scroll_offset() + windowticks;
+    for (midipulse tick = tick0; tick < tick1; tick = mm.next_beat(tick))
     {
-        if (measure_length() == 0)
-        {
-            info_message("qperftime measure-length is 0, cannot draw");
-            break;
-        }
-
+        midi_measures bbt = mm.to_measures(tick);
         int x_pos = xoffset(tick) - scroll_offset_x();
-        if (tick % measure_length() == 0)
+        if (bbt.beats() == 1 && bbt.divisions() == 0)
         {
             pen.setColor(beat_color());                     /* measure      */
             pen.setWidth(2);
@@ -163,14 +159,13 @@ qperftime::paintEvent (QPaintEvent * /*qpep*/)
 
             if (zoom() >= c_minimum_zoom && zoom() <= c_maximum_zoom)
             {
-                QString bar(QString::number(measure + 1));
+                QString bar(QString::number(bbt.measures()));
                 pen.setColor(text_time_paint());            /* Qt::black    */
                 painter.setPen(pen);
                 painter.drawText(x_pos + 2, 10, bar);
             }
-            ++measure;
         }
-        else if (tick % beat_length() == 0)                 /* beat         */
+        else                                                /* beat         */
         {
             pen.setColor(beat_color());
             pen.setWidth(1);
@@ -339,8 +334,7 @@ void
 qperftime::mousePressEvent (QMouseEvent * event)
 {
     midipulse tick = pix_to_tix(event->x());
-    if (snap() > 0)
-        tick -= (tick % snap());
+    tick = perf().meter_map().snap(tick, snap());
 
     if (event->y() > height() / 2)                      /* see banner note  */
     {
@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-09-04
- * \updates       2023-09-07
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  */
@@ -629,6 +629,8 @@ qplaylistframe::fill_songs ()
                 {
                     temp = perf().song_filename();
                     qtip->setText(qt(temp));
+                    temp = perf().song_summary();       /* deep-verify info */
+                    qtip->setToolTip(qt(temp));
                 }
             }
             else
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-08-08
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *      This version is located in Edit / Preferences.
@@ -3644,6 +3644,7 @@ qseditoptions::slot_load_ctrl_filename ()
         const QString qs = ui->lineEditCtrl->text();
         std::string text = qs.toStdString();
         rc().midi_control_filename(text);
+        (void) perf().stage_control_file(rc().midi_control_filespec());
         modify_rc();
     }
 }
@@ -3716,6 +3717,7 @@ qseditoptions::slot_load_drums_filename ()
         {
             ui->checkBoxActiveDrums->setChecked(true);
             rc().notemap_active(true);
+            (void) perf().stage_note_mapper(rc().notemap_filespec());
         }
         modify_rc();
     }
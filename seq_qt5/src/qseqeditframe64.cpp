@@ -89,6 +89,7 @@
  *
  */
 
+#include <QActionGroup>
 #include <QMenu>
 #include <QPaintEvent>
 #include <QScrollBar>
@@ -2529,6 +2530,35 @@ qseqeditframe64::popup_tool_menu ()
         );
         menutiming->addAction(rando);
 
+        /*
+         * Reduction of recorded controller data for this pattern.  The
+         * thresholds are those of the 'usr' file, or of the MIDI file.
+         */
+
+        QMenu * menureduce = new_qmenu
+        (
+            "&Record CC reduction...", m_tools_popup
+        );
+        QActionGroup * reducegroup = new QActionGroup(m_tools_popup);
+        const char * const reducenames [] =
+        {
+            "&None", "&Delta (value/time threshold)", "&Curve (simplify)"
+        };
+        int current = int(track().cc_reducer().get_method());
+        for (int m = 0; m < int(ccreducer::method::max); ++m)
+        {
+            QAction * reduce = new_qaction(reducenames[m], m_tools_popup);
+            reduce->setCheckable(true);
+            reduce->setChecked(m == current);
+            reduce->setData(m);
+            reducegroup->addAction(reduce);
+            menureduce->addAction(reduce);
+            connect
+            (
+                reduce, SIGNAL(triggered(bool)), this, SLOT(set_cc_reduction())
+            );
+        }
+
         QAction * lfobox = new_qaction("&LFO...", m_tools_popup);
         connect
         (
@@ -2600,6 +2630,7 @@ qseqeditframe64::popup_tool_menu ()
         m_tools_popup->addMenu(menutiming);
         m_tools_popup->addMenu(menupitch);
         m_tools_popup->addMenu(menuharmonic);
+        m_tools_popup->addMenu(menureduce);
 
 #if defined USE_MORE_TOOLS
         m_tools_popup->addMenu(menumore);
@@ -2708,6 +2739,23 @@ qseqeditframe64::transpose_notes ()
     track().transpose_notes(transposeval, 0);
 }
 
+/**
+ *  Sets the reduction of recorded controller data, keeping the pattern's
+ *  thresholds.  See the ccreducer module.
+ */
+
+void
+qseqeditframe64::set_cc_reduction ()
+{
+    QAction * senderAction = (QAction *) sender();
+    int m = senderAction->data().toInt();
+    const ccreducer & ccr = track().cc_reducer();
+    (void) track().cc_reduction
+    (
+        static_cast<ccreducer::method>(m), ccr.value(), ccr.pulses(), true
+    );
+}
+
 void
 qseqeditframe64::transpose_harmonic ()
 {
@@ -2777,7 +2825,7 @@ qseqeditframe64::popup_sequence_menu ()
     (void) m_sequences_popup->addAction(off);
     (void) m_sequences_popup->addSeparator();
     int seqsinset = perf().screenset_size();
-    int maxset = perf().screenset_max();
+    int maxset = perf().highest_set() + 1;      /* sets exist on demand     */
     for (int sset = 0; sset < maxset; ++sset)
     {
         QMenu * menusset = nullptr;
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2023-11-11
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The set-master controls the existence and usage of all sets.  For control
@@ -327,7 +327,7 @@ qsetmaster::set_line (screenset & sset, screenset::number row)
     QTableWidgetItem * qtip = cell(row, column_id::set_number);
     if (not_nullptr(qtip))
     {
-        int setno = int(row);                   // int(sset.set_number());
+        int setno = int(sset.set_number());     /* rows skip unused sets */
         std::string setnostr = std::to_string(setno);
         qtip->setText(qt(setnostr));
         qtip = cell(row, column_id::set_name);  // clears sset.name()!
@@ -348,6 +348,26 @@ qsetmaster::set_line (screenset & sset, screenset::number row)
     return result;
 }
 
+/**
+ *  Screensets are created only when used, so the row number is not
+ *  necessarily the set number.  This function gets the set number from the
+ *  "Set #" column of the row.
+ */
+
+screenset::number
+qsetmaster::row_set (int row)
+{
+    screenset::number result = screenset::unassigned();
+    QTableWidgetItem * qtip = cell(row, column_id::set_number);
+    if (not_nullptr(qtip))
+    {
+        std::string snstring = qtip->text().toStdString();
+        if (! snstring.empty())
+            result = screenset::number(string_to_int(snstring));
+    }
+    return result;
+}
+
 /**
  *  Indicates that the MIDI file needs to be updated (saved) and
  *  the GUI needs to be refreshed.
@@ -374,12 +394,13 @@ qsetmaster::slot_table_click_ex
     int rows = cb_perf().screenset_count();
     if (rows > 0 && row >= 0 && row < rows)
     {
+        screenset::number setno = row_set(row);
         current_row(row);
         ui->m_button_down->setEnabled(true);
         ui->m_button_up->setEnabled(true);
-        ui->m_button_delete->setEnabled(row > 0);
-        ui->m_set_number_text->setText(qt(std::to_string(row)));
-        ui->m_set_name_text->setText(qt(cb_perf().set_name(row)));
+        ui->m_button_delete->setEnabled(setno > 0);
+        ui->m_set_number_text->setText(qt(std::to_string(setno)));
+        ui->m_set_name_text->setText(qt(cb_perf().set_name(setno)));
     }
 }
 
@@ -391,8 +412,8 @@ qsetmaster::slot_cell_changed (int row, int column)
         column_id cid = static_cast<column_id>(column);
         if (cid == column_id::set_name)
         {
-            screenset::number s = screenset::number(row);
-            QTableWidgetItem * c = cell(s, cid);
+            screenset::number s = row_set(row);
+            QTableWidgetItem * c = cell(row, cid);
             QString qtext = c->text();
             std::string name = qtext.toStdString();
             std::string oldname = cb_perf().set_name(s);
@@ -1728,7 +1728,7 @@ qslivegrid::popup_menu ()
 
     if (! is_external())
     {
-        seq::number mcs = m_current_seq % perf().screenset_max();
+        seq::number mcs = m_current_seq % setmaster::Size();
         char temp[48];
         snprintf
         (
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2024-01-09
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  The main window is known as the "Patterns window" or "Patterns panel".  It
@@ -2103,6 +2103,9 @@ qsmainwnd::conditional_update ()
     if (session_save())
         (void) save_session();
 
+    if (not_nullptr(session()))
+        (void) session()->autosave();
+
     int active_screenset = int(cb_perf().playscreen_number());
     std::string b = "#";
     b += std::to_string(active_screenset);
@@ -2671,7 +2674,10 @@ qsmainwnd::import_midi_into_set ()
                     new (std::nothrow) midifile(fn, choose_ppqn())
                     ;
 
-                if (f->parse(cb_perf(), setno, true))  /* true-->importing  */
+                cb_perf().stage_patterns(true);     /* plays at next bar    */
+                bool ok = f->parse(cb_perf(), setno, true); /* importing    */
+                cb_perf().stage_patterns(false);
+                if (ok)
                 {
                     ui->spinBpm->setDecimals(usr().bpm_precision());
                     ui->spinBpm->setSingleStep(usr().bpm_step_increment());
@@ -2687,6 +2693,7 @@ qsmainwnd::import_midi_into_set ()
             }
             catch (...)
             {
+                cb_perf().stage_patterns(false);
                 std::string p = path.toStdString();
                 std::string msg = "Error reading MIDI data from file: " + p;
                 show_error_box(msg);
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2022-02-16
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This mastermidibus module is the Linux (and, soon, JACK) version of the
@@ -85,6 +85,7 @@ protected:
 
     virtual bool api_get_midi_event (event * in) override;
     virtual int api_poll_for_midi () override;
+    virtual int api_input_pending () override;
     virtual void api_init (int ppqn, midibpm bpm) override;
 
     /**
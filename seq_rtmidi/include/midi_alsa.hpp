@@ -158,6 +158,10 @@ protected:
 
     virtual bool api_connect () override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_direct
+    (
+        const event * e24, midibyte channel
+    ) override;
     virtual void api_sysex (const event * e24) override;
     virtual void api_flush () override;
     virtual void api_continue_from (midipulse tick, midipulse beats) override;
@@ -170,6 +174,7 @@ protected:
 private:
 
     bool set_virtual_name (int portid, const std::string & portname);
+    void send_event (const event * e24, midibyte channel, bool direct);
 
 };          // class midi_alsa
 
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-04
- * \updates       2022-06-03
+ * \updates       2026-10-17
  * \license       See above.
  *
  *    We need to have a way to get all of the ALSA information of
@@ -35,8 +35,10 @@
  */
 
 #include <alsa/asoundlib.h>
+#include <vector>                       /* std::vector<>                    */
 
 #include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
+#include "midi/event.hpp"               /* seq66::event                     */
 #include "midi/midibus.hpp"             /* seq66::midibus                   */
 
 /*
@@ -89,6 +91,37 @@ private:
 
     struct pollfd * m_poll_descriptors;
 
+    /**
+     *  The ALSA MIDI decoder, created once and used for every input event.
+     *  Running status is turned off, so that each decoded message has its
+     *  status byte.
+     */
+
+    snd_midi_event_t * m_decoder;
+
+    /**
+     *  The buffer into which m_decoder writes a message or SysEx chunk.
+     */
+
+    std::vector<midibyte> m_decode_buffer;
+
+    /**
+     *  The events drained from the ALSA input FIFO at the last wakeup, and
+     *  the index of the next one to hand out.  Used only by the input
+     *  thread.
+     */
+
+    std::vector<event> m_input_events;
+    size_t m_input_next;
+
+    /**
+     *  A SysEx message whose End-of-SysEx byte has not yet arrived.  ALSA
+     *  delivers long SysEx as a series of chunks, which are appended here.
+     */
+
+    event m_sysex_event;
+    bool m_sysex_open;
+
 public:
 
     midi_alsa_info () = delete;
@@ -109,6 +142,7 @@ public:
     virtual bool api_connect () override;
     virtual void api_set_ppqn (int p) override;
     virtual int api_poll_for_midi () override;
+    virtual int api_input_pending () override;
     virtual void api_set_beats_per_minute (midibpm b) override;
     virtual void api_port_start
     (
@@ -128,6 +162,10 @@ private:
     void remove_poll_descriptors ();
     bool check_port_type (snd_seq_port_info_t * pinfo) const;
     bool show_event (snd_seq_event_t * ev, const char * tag);
+    bool port_event (snd_seq_event_t * ev);
+    int drain_input ();
+    void decode_event (snd_seq_event_t * ev);
+    void close_sysex ();
 
 };          // class midi_alsa_info
 
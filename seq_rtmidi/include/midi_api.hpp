@@ -151,6 +151,17 @@ public:
     virtual bool api_deinit_in () = 0;
     virtual bool api_get_midi_event (event *) = 0;
     virtual void api_play (const event * e24, midibyte channel) = 0;
+
+    /**
+     *  Sends an event at once, for MIDI Thru.  The JACK port buffers are
+     *  per port, so playing is enough; ALSA overrides this function.
+     */
+
+    virtual void api_play_direct (const event * e24, midibyte channel)
+    {
+        api_play(e24, channel);
+    }
+
     virtual void api_sysex (const event * e24) = 0;
     virtual void api_continue_from (midipulse tick, midipulse beats) = 0;
     virtual void api_start () = 0;
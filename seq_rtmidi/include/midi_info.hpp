@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-05
- * \updates       2022-06-15
+ * \updates       2026-10-17
  * \license       See above.
  *
  *  We need to have a way to get all of the API information from each
@@ -522,6 +522,16 @@ public:
     virtual int api_poll_for_midi () = 0;       /* disposable??? */
     virtual void api_flush () = 0;
 
+    /**
+     *  Returns the number of input events already read and decoded, which
+     *  can be fetched without polling.  Only ALSA reads ahead.
+     */
+
+    virtual int api_input_pending ()
+    {
+        return 0;
+    }
+
     /**
      *  Used only in the midi_jack_info class.
      */
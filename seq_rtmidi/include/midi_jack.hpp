@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2022-09-13
+ * \updates       2026-10-17
  * \license       See above.
  *
  *    In this refactoring, we've stripped out most of the original RtMidi
@@ -74,6 +74,14 @@ private:
 
     std::string m_remote_port_name;
 
+    /**
+     *  Indicates that this port is in the port list of m_jack_info, and
+     *  must be removed from it when destroyed.  Cleared by midi_jack_info
+     *  if it is destroyed first.
+     */
+
+    bool m_listed;
+
 protected:
 
     /**
@@ -161,11 +169,6 @@ protected:
         return jack_info().jack_ports();
     }
 
-    midi_jack_info::portlist & jack_ports ()
-    {
-        return jack_info().jack_ports();
-    }
-
     void close_client ();
     void close_port ();
     bool create_ringbuffer (size_t rbsize);
@@ -27,19 +27,28 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2023-12-08
+ * \updates       2026-10-17
  * \license       See above.
  *
  *    We need to have a way to get all of the JACK information of
  *    the midi_jack module.  This module provides that information.
  *
  *  GitHub issue #165: enabled a build and run with no JACK support.
+ *
+ *  The JACK process callback does not iterate the list of ports directly,
+ *  since ports can be added or removed by other threads.  Instead it uses an
+ *  immutable table of ports that is rebuilt and atomically swapped in when
+ *  the list changes.  A replaced table is deleted only after the process
+ *  callback has finished a cycle that started after the swap.
  */
 
 #include "seq66-config.h"
 
 #if defined SEQ66_JACK_SUPPORT
 
+#include <atomic>                       /* std::atomic<>                    */
+#include <mutex>                        /* std::mutex, std::lock_guard      */
+
 #include <jack/jack.h>                  /* JACK (2) API                     */
 
 #include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
@@ -61,6 +70,7 @@ namespace seq66
 {
     class mastermidibus;
     class midi_jack;
+    class midi_jack_data;
 
 /**
  *  The class for handling JACK MIDI port enumeration.
@@ -80,13 +90,76 @@ private:
     using portlist = std::vector<midi_jack *>;
 
     /**
-     *  Holds the port data.  This list is iterated in the input and output
-     *  portions of the JACK process callback.  This class does not own the
-     *  pointers.
+     *  An entry in the port table used by the JACK process callback.  The
+     *  direction of the port is fixed when the table is built.
+     */
+
+    class rtport
+    {
+    public:
+
+        midi_jack * port;
+        midi_jack_data * data;
+        bool input;
+    };
+
+    using rtportlist = std::vector<rtport>;
+
+    /**
+     *  A replaced port table and the process-cycle count at which it was
+     *  replaced.
+     */
+
+    class retiree
+    {
+    public:
+
+        rtportlist * table;
+        unsigned cycle;
+    };
+
+    /**
+     *  Holds the port data.  This list is modified only under m_port_mutex,
+     *  and is never seen by the JACK process callback, which uses
+     *  m_rt_ports.  This class does not own the pointers.
      */
 
     portlist m_jack_ports;
 
+    /**
+     *  Serializes the changes to m_jack_ports and the publishing of the
+     *  port table.
+     */
+
+    mutable std::mutex m_port_mutex;
+
+    /**
+     *  The immutable port table iterated by the JACK process callback.
+     */
+
+    std::atomic<rtportlist *> m_rt_ports;
+
+    /**
+     *  The number of process cycles completed.  The process callback bumps
+     *  this value at the end of each cycle, acknowledging that it no longer
+     *  uses any table that was replaced before the cycle started.
+     */
+
+    std::atomic<unsigned> m_rt_cycles;
+
+    /**
+     *  Indicates that the JACK client is active, so that the process
+     *  callback might be using a port table.
+     */
+
+    std::atomic<bool> m_rt_active;
+
+    /**
+     *  Replaced port tables that the process callback might still be using.
+     */
+
+    std::vector<retiree> m_retired;
+
     /**
      *  Holds the JACK sequencer client pointer so that it can be used
      *  by the midibus objects.  This is actually an opaque pointer; there is
@@ -223,26 +296,24 @@ private:
         return m_jack_ports;
     }
 
-    portlist & jack_ports ()
-    {
-        return m_jack_ports;
-    }
-
     int count () const
     {
         return int(m_jack_ports.size());
     }
 
-    /**
-     *  Adds a pointer to a JACK port.
-     */
+    bool add (midi_jack & mj);
+    bool remove (midi_jack & mj);
+    bool wait_for_cycle (unsigned cycle) const;
 
-    bool add (midi_jack & mj)
+    unsigned rt_cycles () const
     {
-        jack_ports().push_back(&mj);
-        return true;
+        return m_rt_cycles.load();
     }
 
+    void publish_ports (bool wait);
+    void reclaim_ports (bool wait);
+    void process_ports (jack_nframes_t nframes);
+
 };          // midi_jack_info
 
 /*
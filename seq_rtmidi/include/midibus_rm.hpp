@@ -125,6 +125,10 @@ protected:
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_direct
+    (
+        const event * e24, midibyte channel
+    ) override;
     virtual void api_sysex (const event * e24) override;
 
 };          // class midibus (rtmidi version)
@@ -93,6 +93,14 @@ public:
         get_api()->api_play(e24, channel);
     }
 
+    virtual void api_play_direct
+    (
+        const event * e24, midibyte channel
+    ) override
+    {
+        get_api()->api_play_direct(e24, channel);
+    }
+
     virtual void api_continue_from (midipulse tick, midipulse beats) override
     {
         get_api()->api_continue_from(tick, beats);
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Refactoring by Chris Ahlstrom
  * \date          2016-12-08
- * \updates       2022-03-26
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This class is like the rtmidi_in and rtmidi_out classes, but cut down to
@@ -307,6 +307,11 @@ public:
         return get_api_info()->api_poll_for_midi();
     }
 
+    int api_input_pending ()
+    {
+        return get_api_info()->api_input_pending();
+    }
+
     static rtmidi_api & selected_api ()
     {
         return sm_selected_api;
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-06-04
+ * \updates       2026-10-17
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the mastermidibus
@@ -298,6 +298,21 @@ mastermidibus::api_poll_for_midi ()
 #endif
 }
 
+/**
+ *  Returns the number of events drained from the ALSA input FIFO and not
+ *  yet fetched.  The JACK ports do not read ahead.
+ */
+
+int
+mastermidibus::api_input_pending ()
+{
+#if defined SEQ66_USE_JACK_POLLING_FLAG
+    return m_use_jack_polling ? 0 : midi_master().api_input_pending() ;
+#else
+    return 0;
+#endif
+}
+
 /**
  *  Grab a MIDI event.  For the ALSA implementation, this call is ...???
  *
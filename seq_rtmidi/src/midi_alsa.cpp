@@ -537,6 +537,33 @@ static const size_t s_event_size_max =  10;
 
 void
 midi_alsa::api_play (const event * e24, midibyte channel)
+{
+    send_event(e24, channel, false);
+}
+
+/**
+ *  Sends an event at once, for MIDI Thru.  The ALSA sequencer handle is
+ *  shared by all of the busses, and so is its output buffer, which the
+ *  output thread fills while it plays the patterns.  So the event is
+ *  written directly, bypassing that buffer, and no drain is needed.
+ */
+
+void
+midi_alsa::api_play_direct (const event * e24, midibyte channel)
+{
+    send_event(e24, channel, true);
+}
+
+/**
+ *  The common part of api_play() and api_play_direct().
+ *
+ * \param direct
+ *      If true, snd_seq_event_output_direct() is used, otherwise the event
+ *      is put in the output buffer.
+ */
+
+void
+midi_alsa::send_event (const event * e24, midibyte channel, bool direct)
 {
     if (parent_bus().port_enabled())
     {
@@ -554,7 +581,10 @@ midi_alsa::api_play (const event * e24, midibyte channel)
             snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set source   */
             snd_seq_ev_set_subs(&ev);                       /* subscriber   */
             snd_seq_ev_set_direct(&ev);                     /* immediate    */
-            snd_seq_event_output(m_seq, &ev);               /* pump to que  */
+            if (direct)
+                (void) snd_seq_event_output_direct(m_seq, &ev);
+            else
+                snd_seq_event_output(m_seq, &ev);           /* pump to que  */
         }
         else
         {
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2023-10-31
+ * \updates       2026-10-17
  * \license       See above.
  *
  *  API information found at:
@@ -103,6 +103,20 @@ namespace seq66
 static const int c_poll_wait_ms     = 10;
 static const int c_open_block_mode  = SND_SEQ_NONBLOCK;
 
+/**
+ *  The size of the decoding buffer, the largest message or SysEx chunk that
+ *  can be decoded.  ALSA's own input buffer is about this size.
+ */
+
+static const int c_decode_buffer_size = 0x1000;
+
+/**
+ *  The most events drained from the ALSA input FIFO at one wakeup, so that
+ *  a flood of input cannot starve the rest of the input cycle.
+ */
+
+static const int c_input_batch_max = 256;
+
 /*
  * Initialization of static members.
  */
@@ -135,7 +149,13 @@ midi_alsa_info::midi_alsa_info
     midi_info               (appname, ppqn, bpm),
     m_alsa_seq              (nullptr),
     m_num_poll_descriptors  (0),            /* from ALSA mastermidibus      */
-    m_poll_descriptors      (nullptr)       /* ditto                        */
+    m_poll_descriptors      (nullptr),      /* ditto                        */
+    m_decoder               (nullptr),
+    m_decode_buffer         (c_decode_buffer_size, 0),
+    m_input_events          (),
+    m_input_next            (0),
+    m_sysex_event           (),
+    m_sysex_open            (false)
 {
     snd_seq_t * seq;                        /* point to member              */
     int rcode = snd_seq_open                /* set up ALSA sequencer client */
@@ -162,6 +182,17 @@ midi_alsa_info::midi_alsa_info
         snd_seq_set_client_name(m_alsa_seq, rc().app_client_name().c_str());
         global_queue(snd_seq_alloc_queue(m_alsa_seq));
         get_poll_descriptors();
+
+        rcode = snd_midi_event_new(c_decode_buffer_size, &m_decoder);
+        if (rcode < 0 || is_nullptr(m_decoder))
+        {
+            m_decoder = nullptr;
+            errprint("snd_midi_event_new() failed");
+        }
+        else
+            snd_midi_event_no_status(m_decoder, 1);     /* no running status */
+
+        m_input_events.reserve(c_input_batch_max);
     }
 }
 
@@ -183,6 +214,11 @@ midi_alsa_info::~midi_alsa_info ()
         m_alsa_seq = nullptr;
         remove_poll_descriptors();
     }
+    if (not_nullptr(m_decoder))
+    {
+        snd_midi_event_free(m_decoder);
+        m_decoder = nullptr;
+    }
 }
 
 /**
@@ -451,23 +487,40 @@ midi_alsa_info::api_set_beats_per_minute (midibpm b)
 /**
  *  Polls for any ALSA MIDI information using a timeout value of 10
  *  milliseconds (c_poll_wait_ms).  Currently there is only 1 poll
- *  descriptor..
+ *  descriptor..  If events drained at the last wakeup are still waiting,
+ *  there is no need to poll.
  *
  * \return
- *      Returns the result of the call to poll() on the global ALSA poll
- *      descriptors.
+ *      Returns the number of drained events waiting, or the result of the
+ *      call to poll() on the global ALSA poll descriptors.
  */
 
 int
 midi_alsa_info::api_poll_for_midi ()
 {
-    int result = poll
-    (
-        m_poll_descriptors, m_num_poll_descriptors, c_poll_wait_ms
-    );
+    int result = api_input_pending();
+    if (result == 0)
+    {
+        result = poll
+        (
+            m_poll_descriptors, m_num_poll_descriptors, c_poll_wait_ms
+        );
+    }
     return result;
 }
 
+/**
+ *  Returns the number of events drained from the ALSA input FIFO that have
+ *  not yet been fetched by api_get_midi_event().  Called only by the input
+ *  thread.
+ */
+
+int
+midi_alsa_info::api_input_pending ()
+{
+    return int(m_input_events.size() - m_input_next);
+}
+
 /*
  * Definitions copped from the seq_alsamidi/src/mastermidibus.cpp module.
  */
@@ -612,23 +665,10 @@ midi_alsa_info::show_event (snd_seq_event_t * ev, const char * tag)
 
 
 /**
- *  Grab a MIDI event.  First, a rather large buffer is allocated on the stack
- *  to hold the MIDI event data.  Next, if the --alsa-manual-ports option is
- *  not in force, then we check to see if the event is a port-start,
- *  port-exit, or port-change event, and we prcess it, and are done.
- *
- *  Otherwise, we create a "MIDI event parser" and decode the MIDI event.
- *
- *  We've beefed up the error-checking in this function due to crashes we got
- *  when connected to VMPK and suddenly getting a rush of ghost notes, then a
- *  seqfault.  This also occurs in legacy seq66.  To reproduce, run VMPK and
- *  make it the input source.  Open a new pattern, turn on recording, and
- *  start the ALSA transport.  Record one note.  Then activate the button for
- *  "dump input to MIDI bus".  You will here the note through VMPK, then ghost
- *  notes start appearing and seq66/seq66 eventually crash.  A bug in VMPK, or
- *  our processing?  At any rate, we catch the bug now, and don't crash, but
- *  eventually processing gets swamped until we kill VMPK.  And we now have a
- *  note sounding even though neither app is running.  Really screws up ALSA!
+ *  Checks for the ALSA announcement events.  If the --alsa-manual-ports
+ *  option is not in force, then we check to see if the event is a
+ *  port-start, port-exit, or port-change event, and we process it, and are
+ *  done.  Otherwise the event is decoded by decode_event().
  *
  * ALSA events:
  *
@@ -656,42 +696,18 @@ midi_alsa_info::show_event (snd_seq_event_t * ev, const char * tag)
  *      VMPK, causes a Seq66 message "input FIFO overrun".  Later, VMPK
  *      crashes.
  *
- * \todo
- *      Also, we need to consider using the new remcount return code to loop
- *      on receiving events as long as we are getting them.
- *
- * \param inev
- *      The event to be set based on the found input event.  It is the
- *      destination for the incoming event.
+ * \param ev
+ *      The ALSA event read from the input FIFO.
  *
  * \return
- *      This function returns false if we are not using virtual/manual ports
- *      and the event is an ALSA port-start, port-exit, or port-change event.
- *      It also returns false if there is no event to decode.  Otherwise, it
- *      returns true.
+ *      Returns true if the event is a port-start, port-exit, port-change, or
+ *      other announcement event, which is not to be decoded.
  */
 
 bool
-midi_alsa_info::api_get_midi_event (event * inev)
+midi_alsa_info::port_event (snd_seq_event_t * ev)
 {
     bool result = false;
-    snd_seq_event_t * ev;
-    int remcount = snd_seq_event_input(m_alsa_seq, &ev);
-    if (remcount < 0 || is_nullptr(ev))
-    {
-        if (remcount == -EAGAIN)
-        {
-            // no input in non-blocking mode
-        }
-        else if (remcount == -ENOSPC)
-        {
-            errprint("input FIFO overrun");             /* see VMPK note    */
-        }
-        else
-            errprint("snd_seq_event_input() failure");
-
-        return false;
-    }
     if (! rc().manual_ports())
     {
         switch (ev->type)
@@ -759,73 +775,194 @@ midi_alsa_info::api_get_midi_event (event * inev)
             break;
         }
     }
-    if (result)
-        return false;
+    return result;
+}
+
+/**
+ *  Grab a MIDI event.  The events are no longer read and decoded one at a
+ *  time.  When the events drained at the last wakeup have all been handed
+ *  out, drain_input() empties the ALSA input FIFO (up to c_input_batch_max
+ *  events) into m_input_events, using the one decoder.  The rest of the
+ *  batch is then handed out without polling or reading ALSA again.  See
+ *  api_input_pending().
+ *
+ * \param inev
+ *      The event to be set based on the found input event.  It is the
+ *      destination for the incoming event.
+ *
+ * \return
+ *      Returns false if there is no event to hand out.  Otherwise, it
+ *      returns true.
+ */
+
+bool
+midi_alsa_info::api_get_midi_event (event * inev)
+{
+    if (api_input_pending() == 0)
+        (void) drain_input();
 
-    midibyte buffer[0x1000];                    /* 4096 buffer for data     */
-    snd_midi_event_t * midi_ev;                 /* make ALSA MIDI parser    */
-    int rc = snd_midi_event_new(sizeof buffer, &midi_ev);
-    if (rc < 0 || is_nullptr(midi_ev))
+    bool result = api_input_pending() > 0;
+    if (result)
     {
-        errprint("snd_midi_event_new() failed");
-        return false;
+        *inev = m_input_events[m_input_next++];
+        if (m_input_next == m_input_events.size())
+        {
+            m_input_events.clear();             /* keeps the capacity       */
+            m_input_next = 0;
+        }
     }
+    return result;
+}
 
-    /*
-     *  Note that ev->time.tick is always 0.  (Same in Seq32).  Not sure about
-     *  this handling of SysEx data. Apparently one can get only up to ALSA
-     *  buffer size (4096) of data.  Also, the snd_seq_event_input() function
-     *  is said to block!
-     */
+/**
+ *  Reads all the events waiting in the ALSA input FIFO, up to
+ *  c_input_batch_max, and decodes them into m_input_events.  ALSA fills
+ *  its own input buffer with one read() of the FIFO, so this costs about
+ *  one system call per wakeup, rather than a poll() and a read() per event.
+ *  The ALSA client is non-blocking, so the loop ends with -EAGAIN when the
+ *  FIFO is empty.
+ *
+ *  We've beefed up the error-checking in this function due to crashes we got
+ *  when connected to VMPK and suddenly getting a rush of ghost notes, then a
+ *  seqfault.  This also occurs in legacy seq66.  To reproduce, run VMPK and
+ *  make it the input source.  Open a new pattern, turn on recording, and
+ *  start the ALSA transport.  Record one note.  Then activate the button for
+ *  "dump input to MIDI bus".  You will here the note through VMPK, then ghost
+ *  notes start appearing and seq66/seq66 eventually crash.  A bug in VMPK, or
+ *  our processing?  At any rate, we catch the bug now, and don't crash, but
+ *  eventually processing gets swamped until we kill VMPK.  And we now have a
+ *  note sounding even though neither app is running.  Really screws up ALSA!
+ *
+ * \return
+ *      Returns the number of events added to the batch.
+ */
 
-    long bytes = snd_midi_event_decode(midi_ev, buffer, sizeof buffer, ev);
-    if (bytes > 0)
+int
+midi_alsa_info::drain_input ()
+{
+    if (is_nullptr(m_decoder))
+        return 0;
+
+    m_input_events.clear();
+    m_input_next = 0;
+    for (int count = 0; count < c_input_batch_max; ++count)
     {
-        result = inev->set_midi_event(ev->time.tick, buffer, bytes);
-        if (result)
+        snd_seq_event_t * ev;
+        int remcount = snd_seq_event_input(m_alsa_seq, &ev);
+        if (remcount < 0 || is_nullptr(ev))
         {
-            bussbyte b = input_ports().get_port_index
-            (
-                int(ev->source.client), int(ev->source.port)
-            );
-            bool sysex = inev->is_sysex();
-            inev->set_input_bus(b);
-#if defined SEQ66_PLATFORM_DEBUG_TMI
-            printf("[seq66] input event on ALSA bus %d\n", int(b));
-#endif
-            while (sysex)           /* sysex might be more than one message */
+            if (remcount == -EAGAIN)
             {
-                int remcount = snd_seq_event_input(m_alsa_seq, &ev);
-                long bytes = snd_midi_event_decode
-                (
-                    midi_ev, buffer, sizeof buffer, ev
-                );
-                if (bytes > 0)
-                {
-                    sysex = inev->append_sysex(buffer, bytes);
-                    if (remcount == 0)
-                        sysex = false;
-                }
-                else
-                    sysex = false;
+                break;                          /* the FIFO is empty        */
             }
+            else if (remcount == -ENOSPC)
+            {
+                errprint("input FIFO overrun");     /* see VMPK note        */
+                continue;                       /* the FIFO was flushed     */
+            }
+            else
+                errprint("snd_seq_event_input() failure");
+
+            break;
         }
-        snd_midi_event_free(midi_ev);
-        return true;
+        if (! port_event(ev))
+            decode_event(ev);
     }
-    else
+    return int(m_input_events.size());
+}
+
+/**
+ *  Decodes one ALSA event and adds it to the batch.  Note that
+ *  ev->time.tick is always 0.  (Same in Seq32).
+ *
+ *  ALSA delivers a long SysEx message as a series of SND_SEQ_EVENT_SYSEX
+ *  chunks.  The first one starts a SysEx event in m_sysex_event, and the
+ *  following ones are appended to it in place, until the End-of-SysEx byte
+ *  arrives.  Only then is the event added to the batch.  A SysEx left open
+ *  at the end of a batch waits for the rest of its chunks at the next
+ *  wakeup.  Real-time messages (e.g. MIDI Clock) can arrive between the
+ *  chunks, and are added to the batch ahead of the SysEx.  Any other message
+ *  ends the SysEx, which is then added as is.
+ *
+ * \param ev
+ *      The ALSA event to decode.
+ */
+
+void
+midi_alsa_info::decode_event (snd_seq_event_t * ev)
+{
+    midibyte * buffer = m_decode_buffer.data();
+    long bytes = snd_midi_event_decode
+    (
+        m_decoder, buffer, long(m_decode_buffer.size()), ev
+    );
+    if (bytes <= 0)
     {
         /*
          * This happens even at startup, before anything is really happening.
          */
 
-        snd_midi_event_free(midi_ev);
+        snd_midi_event_reset_decode(m_decoder);
 
 #if defined SEQ66_PLATFORM_DEBUG_TMI
         errprintf("snd_midi_event_decode() returned %ld", bytes);
 #endif
+        return;
+    }
+
+    bussbyte b = input_ports().get_port_index
+    (
+        int(ev->source.client), int(ev->source.port)
+    );
+    bool chunk = ev->type == SND_SEQ_EVENT_SYSEX;
+    if (chunk && buffer[0] != EVENT_MIDI_SYSEX)
+    {
+        if (! m_sysex_open)
+            return;                             /* its start was lost       */
+
+        (void) m_sysex_event.append_sysex(buffer, int(bytes));
+    }
+    else
+    {
+        bool realtime = ! chunk && buffer[0] >= EVENT_MIDI_CLOCK;
+        if (m_sysex_open && ! realtime)
+            close_sysex();                      /* the SysEx was cut short  */
+
+        event e;
+        if (! e.set_midi_event(ev->time.tick, buffer, int(bytes)))
+            return;
+
+        e.set_input_bus(b);
+#if defined SEQ66_PLATFORM_DEBUG_TMI
+        printf("[seq66] input event on ALSA bus %d\n", int(b));
+#endif
+        if (e.is_sysex())
+        {
+            m_sysex_event = e;
+            m_sysex_open = true;
+        }
+        else
+        {
+            m_input_events.push_back(e);
+            return;
+        }
+    }
+    if (buffer[bytes - 1] == EVENT_MIDI_SYSEX_END)
+        close_sysex();
+}
 
-        return false;
+/**
+ *  Adds the open SysEx event to the batch.
+ */
+
+void
+midi_alsa_info::close_sysex ()
+{
+    if (m_sysex_open)
+    {
+        m_input_events.push_back(m_sysex_event);
+        m_sysex_event = event();
+        m_sysex_open = false;
     }
 }
 
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2024-01-13
+ * \updates       2026-10-17
  * \license       See above.
  *
  *  Written primarily by Alexander Svetalkin, with updates for delta time by
@@ -908,11 +908,12 @@ jack_port_register_callback (jack_port_id_t portid, int regv, void * arg)
 midi_jack::midi_jack (midibus & parentbus, midi_info & masterinfo) :
     midi_api            (parentbus, masterinfo),
     m_remote_port_name  (),
+    m_listed            (false),
     m_jack_info         (dynamic_cast<midi_jack_info &>(masterinfo)),
     m_jack_data         ()
 {
     client_handle(reinterpret_cast<jack_client_t *>(masterinfo.midi_handle()));
-    (void) jack_info().add(*this);
+    m_listed = jack_info().add(*this);
 
     /*
      * New for issue #100. These are only tentative values, and are replaced
@@ -927,10 +928,18 @@ midi_jack::midi_jack (midibus & parentbus, midi_info & masterinfo) :
  *  This could be a rote empty destructor if we offload this destruction to the
  *  midi_jack_data structure.  However, other than the initialization, that
  *  structure is currently "dumb".
+ *
+ *  If the midi_jack_info still exists, this port is first removed from its
+ *  port table, which waits until the JACK process callback is done with it.
  */
 
 midi_jack::~midi_jack ()
 {
+    if (m_listed)
+    {
+        (void) jack_info().remove(*this);
+        m_listed = false;
+    }
 #if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
     if (not_nullptr(jack_data().jack_buffer()))
     {
@@ -1776,7 +1785,9 @@ midi_jack::register_port (midibase::io iotype, const std::string & portname)
 
 /**
  *  Closes the MIDI port by calling jack_port_unregister() and
- *  nullifying the port pointer.
+ *  nullifying the port pointer.  The pointer is nullified first, and the
+ *  process callback is given a cycle to notice it, so that it does not use
+ *  the port while it is being unregistered.
  *
  *  This function is not called at application exit!
  */
@@ -1786,8 +1797,12 @@ midi_jack::close_port ()
 {
     if (not_nullptr(client_handle()) && not_nullptr(port_handle()))
     {
-        ::jack_port_unregister(client_handle(), port_handle());
-        port_handle(nullptr);
+        jack_port_t * jp = port_handle();
+        port_handle(nullptr);                   /* process callback skips   */
+        if (m_listed)
+            (void) jack_info().wait_for_cycle(jack_info().rt_cycles());
+
+        ::jack_port_unregister(client_handle(), jp);
     }
 }
 
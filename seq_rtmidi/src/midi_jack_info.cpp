@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2023-12-08
+ * \updates       2026-10-17
  * \license       See above.
  *
  *  This class is meant to collect a whole bunch of JACK information about
@@ -32,6 +32,7 @@
  *  creating JACK midibus objects and midi_jack API objects.
  */
 
+#include <algorithm>                    /* std::find()                      */
 #include <cstring>                      /* std::strcpy(), std::strcat()     */
 
 #include "seq66-config.h"
@@ -83,11 +84,21 @@ extern void jack_port_register_callback
     jack_port_id_t port, int ev_value, void * arg
 );
 
+/**
+ *  The longest time, in microseconds, to wait for the JACK process callback
+ *  to finish a cycle before a replaced port table is deleted anyway.  If
+ *  the callback has not run in that time, the JACK client is stalled or has
+ *  been dropped by the server.
+ */
+
+static const int c_port_retire_wait_us = 1000000;
+
 /**
  *  Provides a JACK callback function that uses the callbacks defined in the
  *  midi_jack module.  This function calls both the input callback and
  *  the output callback, depending on the port type.  This may lead to
- *  delays, depending on the size of the JACK MIDI buffer.
+ *  delays, depending on the size of the JACK MIDI buffer.  See
+ *  midi_jack_info::process_ports().
  *
  * \param nframes
  *      The frame number from the JACK API.
@@ -104,23 +115,8 @@ jack_process_io (jack_nframes_t nframes, void * arg)
 {
     midi_jack_info * self = reinterpret_cast<midi_jack_info *>(arg);
     if (not_nullptr(self))
-    {
-        /*
-         * Go through the I/O ports and route the data appropriately.
-         */
+        self->process_ports(nframes);
 
-        for (auto mj : self->jack_ports())  /* midi_jack pointers       */
-        {
-            if (mj->enabled())
-            {
-                midi_jack_data * mjp = &mj->jack_data();
-                if (mj->parent_bus().is_input_port())
-                    (void) jack_process_rtmidi_input(nframes, mjp);
-                else
-                    (void) jack_process_rtmidi_output(nframes, mjp);
-            }
-        }
-    }
     return 0;
 }
 
@@ -145,6 +141,11 @@ midi_jack_info::midi_jack_info
 ) :
     midi_info               (appname, ppqn, bpm),
     m_jack_ports            (),
+    m_port_mutex            (),
+    m_rt_ports              (nullptr),
+    m_rt_cycles             (0),
+    m_rt_active             (false),
+    m_retired               (),
     m_jack_client           (nullptr),              /* inited for connect() */
     m_jack_buffer_size      (0),
     m_jack_sample_rate      (0)
@@ -162,11 +163,216 @@ midi_jack_info::midi_jack_info
  *  Destructor.  Deactivates (disconnects and closes) any ports maintained by
  *  the JACK client, then closes the JACK client, shuts down the input
  *  thread, and then cleans up any API resources in use.
+ *
+ *  The midi_jack ports are deleted later, along with their busses, so they
+ *  are told not to remove themselves from this (deleted) object.  With the
+ *  client closed, the port tables can be deleted at once.
  */
 
 midi_jack_info::~midi_jack_info ()
 {
     disconnect();
+
+    std::lock_guard<std::mutex> lk(m_port_mutex);
+    for (auto mj : m_jack_ports)
+        mj->m_listed = false;
+
+    m_jack_ports.clear();
+    reclaim_ports(false);
+    delete m_rt_ports.exchange(nullptr);
+}
+
+/**
+ *  Adds a pointer to a JACK port, and publishes a new port table for the
+ *  process callback.  The old table is retired, to be deleted later.
+ *
+ * \param mj
+ *      The port to add.  It is not owned by this object.
+ *
+ * \return
+ *      Returns true if the port was added.
+ */
+
+bool
+midi_jack_info::add (midi_jack & mj)
+{
+    std::lock_guard<std::mutex> lk(m_port_mutex);
+    m_jack_ports.push_back(&mj);
+    publish_ports(false);
+    return true;
+}
+
+/**
+ *  Removes a pointer to a JACK port, and publishes a new port table.  Since
+ *  the port is about to be destroyed, this function waits until the process
+ *  callback can no longer be using the old table.
+ *
+ * \param mj
+ *      The port to remove.
+ *
+ * \return
+ *      Returns true if the port was found and removed.
+ */
+
+bool
+midi_jack_info::remove (midi_jack & mj)
+{
+    std::lock_guard<std::mutex> lk(m_port_mutex);
+    auto it = std::find(m_jack_ports.begin(), m_jack_ports.end(), &mj);
+    bool result = it != m_jack_ports.end();
+    if (result)
+    {
+        m_jack_ports.erase(it);
+        publish_ports(true);
+    }
+    return result;
+}
+
+/**
+ *  Builds a new port table from the port list and swaps it in for the
+ *  process callback.  The caller must hold m_port_mutex.
+ *
+ * \param wait
+ *      If true, wait until the old table is no longer in use, and delete
+ *      it.  Otherwise it is deleted by a later call to reclaim_ports().
+ */
+
+void
+midi_jack_info::publish_ports (bool wait)
+{
+    rtportlist * table = new (std::nothrow) rtportlist();
+    if (is_nullptr(table))
+    {
+        error_message("JACK port table allocation failed");
+        return;
+    }
+    table->reserve(m_jack_ports.size());
+    for (auto mj : m_jack_ports)
+    {
+        rtport p;
+        p.port = mj;
+        p.data = &mj->jack_data();
+        p.input = mj->parent_bus().is_input_port();
+        table->push_back(p);
+    }
+
+    rtportlist * old = m_rt_ports.exchange(table);
+    if (not_nullptr(old))
+    {
+        retiree r;
+        r.table = old;
+        r.cycle = m_rt_cycles.load();
+        m_retired.push_back(r);
+    }
+    reclaim_ports(wait);
+}
+
+/**
+ *  Waits until the process callback has finished a cycle after the given
+ *  cycle count.  If the client is not active, there is nothing to wait for.
+ *
+ * \param cycle
+ *      The cycle count noted when a port table was replaced.
+ *
+ * \return
+ *      Returns true if the callback is no longer using anything from
+ *      before that cycle count.  Returns false if the wait timed out.
+ */
+
+bool
+midi_jack_info::wait_for_cycle (unsigned cycle) const
+{
+    int waited = 0;
+    while (m_rt_active && m_rt_cycles.load() == cycle)
+    {
+        if (waited >= c_port_retire_wait_us)
+            return false;
+
+        (void) microsleep(std_sleep_us());
+        waited += std_sleep_us();
+    }
+    return true;
+}
+
+/**
+ *  Deletes the retired port tables that the process callback has finished
+ *  with.  The caller must hold m_port_mutex.
+ *
+ * \param wait
+ *      If true, wait for the callback to finish its current cycle, so that
+ *      all of the retired tables can be deleted.  If the wait times out, the
+ *      JACK client is not running, and the tables are deleted anyway.
+ */
+
+void
+midi_jack_info::reclaim_ports (bool wait)
+{
+    if (m_retired.empty())
+        return;
+
+    if (wait)
+    {
+        if (! wait_for_cycle(m_retired.back().cycle))
+            warn_message("JACK process callback stalled");
+    }
+
+    unsigned cycle = m_rt_cycles.load();
+    bool active = m_rt_active;
+    auto it = m_retired.begin();
+    while (it != m_retired.end())
+    {
+        if (wait || ! active || it->cycle != cycle)
+        {
+            delete it->table;
+            it = m_retired.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+/**
+ *  The body of the JACK process callback.  It uses only the current port
+ *  table, which is never modified, and then acknowledges the cycle.
+ *
+ *  Ports that have nothing to do are skipped:
+ *
+ *      -   Disabled ports, and ports that are not (or no longer) registered.
+ *      -   Input ports with no connections.  Their buffers are always empty.
+ *
+ *  Every output port is processed in every cycle, even if it has nothing
+ *  to send, because JACK requires an output buffer to be cleared in each
+ *  cycle; otherwise the stale data is played again.
+ *
+ * \param nframes
+ *      The frame count from the JACK API.
+ */
+
+void
+midi_jack_info::process_ports (jack_nframes_t nframes)
+{
+    const rtportlist * table = m_rt_ports.load(std::memory_order_acquire);
+    if (not_nullptr(table))
+    {
+        for (const auto & p : *table)
+        {
+            if (! p.port->enabled())
+                continue;
+
+            jack_port_t * jp = p.data->jack_port();
+            if (is_nullptr(jp))
+                continue;
+
+            if (p.input)
+            {
+                if (::jack_port_connected(jp) > 0)
+                    (void) jack_process_rtmidi_input(nframes, p.data);
+            }
+            else
+                (void) jack_process_rtmidi_output(nframes, p.data);
+        }
+    }
+    m_rt_cycles.fetch_add(1, std::memory_order_release);
 }
 
 /**
@@ -296,6 +502,7 @@ midi_jack_info::disconnect ()
     if (not_nullptr(m_jack_client))
     {
         ::jack_deactivate(m_jack_client);
+        m_rt_active = false;                        /* no more callbacks    */
         ::jack_client_close(m_jack_client);
         m_jack_client = nullptr;
     }
@@ -706,6 +913,7 @@ midi_jack_info::lookup_midi_jack
     midi_jack * result = nullptr;
     if (! shortname.empty())
     {
+        std::lock_guard<std::mutex> lk(m_port_mutex);
         const portlist & ports = jack_ports();      /* midi_jack pointers   */
 
 #if defined SEQ66_PLATFORM_DEBUG
@@ -765,6 +973,7 @@ void
 midi_jack_info::show_details () const
 {
     int count = 0;
+    std::lock_guard<std::mutex> lk(m_port_mutex);
     const portlist & ports = jack_ports();          /* midi_jack pointers   */
     for (const auto mj : ports)
     {
@@ -805,6 +1014,7 @@ midi_jack_info::api_connect ()
         result = rcode == 0;
         if (result)
         {
+            m_rt_active = true;
             int bsize = rc().jack_buffer_size();
             if (bsize > 0)
             {
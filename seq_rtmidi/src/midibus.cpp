@@ -394,6 +394,17 @@ midibus::api_play (const event * e24, midibyte channel)
         m_rt_midi->api_play(e24, channel);
 }
 
+/**
+ *  Sends an event at once.  See midibase::play_direct().
+ */
+
+void
+midibus::api_play_direct (const event * e24, midibyte channel)
+{
+    if (not_nullptr(m_rt_midi))
+        m_rt_midi->api_play_direct(e24, channel);
+}
+
 void
 midibus::api_sysex (const event * e24)
 {